@@ -0,0 +1,90 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+// Compares parsing many small documents into a json_arena with parsing them
+// into json values that use std::allocator, and releasing them afterwards
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_arena.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    std::string make_document(std::size_t i)
+    {
+        std::string s = "{\"id\":";
+        s.append(std::to_string(i));
+        s.append(",\"name\":\"a document with a name too long for short string storage\",\"tags\":[\"first\",\"second\",\"third\"],");
+        s.append("\"location\":{\"city\":\"Toronto\",\"coordinates\":[43.6532,-79.3832]},\"scores\":[");
+        for (std::size_t k = 0; k < 20; ++k)
+        {
+            if (k > 0)
+            {
+                s.push_back(',');
+            }
+            s.append(std::to_string(i*k));
+        }
+        s.append("]}");
+        return s;
+    }
+}
+
+int main()
+{
+    const std::size_t count = 200000;
+    std::vector<std::string> inputs;
+    std::size_t input_size = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        inputs.push_back(make_document(i));
+        input_size += inputs.back().size();
+    }
+    std::cout << "json_arena, " << count << " documents, " << input_size/1024 << " KB input\n";
+
+    std::chrono::milliseconds best_parse = std::chrono::milliseconds::max();
+    std::chrono::milliseconds best_destroy = std::chrono::milliseconds::max();
+    for (int k = 0; k < 3; ++k)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<json> docs;
+        docs.reserve(count);
+        for (const auto& input : inputs)
+        {
+            docs.push_back(json::parse(input));
+        }
+        auto parsed = std::chrono::high_resolution_clock::now();
+        docs.clear();
+        auto destroyed = std::chrono::high_resolution_clock::now();
+
+        best_parse = (std::min)(best_parse, std::chrono::duration_cast<std::chrono::milliseconds>(parsed - start));
+        best_destroy = (std::min)(best_destroy, std::chrono::duration_cast<std::chrono::milliseconds>(destroyed - parsed));
+    }
+    std::cout << "    std::allocator: parse " << best_parse.count() << " ms, destroy " << best_destroy.count() << " ms\n";
+
+    best_parse = std::chrono::milliseconds::max();
+    best_destroy = std::chrono::milliseconds::max();
+    for (int k = 0; k < 3; ++k)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        json_arena arena;
+        std::vector<json_arena::json_type*> docs;
+        docs.reserve(count);
+        for (const auto& input : inputs)
+        {
+            docs.push_back(&arena.parse(input));
+        }
+        auto parsed = std::chrono::high_resolution_clock::now();
+        arena.release();
+        auto destroyed = std::chrono::high_resolution_clock::now();
+
+        best_parse = (std::min)(best_parse, std::chrono::duration_cast<std::chrono::milliseconds>(parsed - start));
+        best_destroy = (std::min)(best_destroy, std::chrono::duration_cast<std::chrono::milliseconds>(destroyed - parsed));
+    }
+    std::cout << "    json_arena:     parse " << best_parse.count() << " ms, destroy " << best_destroy.count() << " ms\n";
+}
@@ -0,0 +1,174 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+// Compares json_inplace_decoder with json_decoder, by decoding time and by the
+// most memory in use while decoding
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_reader.hpp>
+#include <jsoncons/json_inplace_decoder.hpp>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    // Keeps a count of the bytes in use, and the most in use at any one time
+    struct allocation_stats
+    {
+        static std::size_t& in_use()
+        {
+            static std::size_t value = 0;
+            return value;
+        }
+        static std::size_t& peak()
+        {
+            static std::size_t value = 0;
+            return value;
+        }
+    };
+
+    template <class T>
+    struct counting_allocator
+    {
+        using value_type = T;
+
+        counting_allocator() = default;
+
+        template <class U>
+        counting_allocator(const counting_allocator<U>&) noexcept
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+            allocation_stats::in_use() += n*sizeof(T);
+            if (allocation_stats::in_use() > allocation_stats::peak())
+            {
+                allocation_stats::peak() = allocation_stats::in_use();
+            }
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept
+        {
+            allocation_stats::in_use() -= n*sizeof(T);
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        friend bool operator==(const counting_allocator&, const counting_allocator&) noexcept
+        {
+            return true;
+        }
+        friend bool operator!=(const counting_allocator&, const counting_allocator&) noexcept
+        {
+            return false;
+        }
+    };
+
+    std::string make_records_input(std::size_t count)
+    {
+        std::string input = "[";
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (i > 0)
+            {
+                input.push_back(',');
+            }
+            input.append("{\"available\":true,\"category\":null,\"id\":");
+            input.append(std::to_string(i));
+            input.append(",\"name\":\"item number ");
+            input.append(std::to_string(i));
+            input.append("\",\"price\":");
+            input.append(std::to_string(i*0.25));
+            input.append(",\"tags\":[\"first tag\",\"second tag\",\"third tag\"]}");
+        }
+        input.push_back(']');
+        return input;
+    }
+
+    std::string make_numbers_input(std::size_t count)
+    {
+        std::string input = "[";
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (i > 0)
+            {
+                input.push_back(',');
+            }
+            input.append(std::to_string(i*7919));
+        }
+        input.push_back(']');
+        return input;
+    }
+
+    template <class Decoder>
+    std::size_t decode_size(const std::string& input)
+    {
+        Decoder decoder;
+        basic_json_reader<char,string_source<char>> reader(input, decoder);
+        reader.read();
+        return decoder.get_result().size();
+    }
+
+    // Reports the best of several timings with Decoder, and the peak memory with CountingDecoder
+    template <class Decoder,class CountingDecoder>
+    void run_benchmark(const char* label, const std::string& input)
+    {
+        std::chrono::milliseconds best_time = std::chrono::milliseconds::max();
+        std::size_t size = 0;
+        for (int i = 0; i < 5; ++i)
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+            size = decode_size<Decoder>(input);
+            auto time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start);
+            if (time < best_time)
+            {
+                best_time = time;
+            }
+        }
+
+        std::size_t start_in_use = allocation_stats::in_use();
+        allocation_stats::peak() = start_in_use;
+        if (decode_size<CountingDecoder>(input) != size)
+        {
+            std::cout << "    " << label << "decoded values differ\n";
+            return;
+        }
+
+        std::cout << "    " << label << best_time.count() << " ms, peak "
+                  << (allocation_stats::peak() - start_in_use)/1024 << " KB\n";
+    }
+}
+
+int main()
+{
+    using counted_json = basic_json<char,sorted_policy,counting_allocator<char>>;
+    using counted_ojson = basic_json<char,preserve_order_policy,counting_allocator<char>>;
+
+    std::vector<std::pair<std::string,std::string>> inputs = {
+        {"records", make_records_input(200000)},
+        {"numbers", make_numbers_input(2000000)}
+    };
+
+    for (const auto& item : inputs)
+    {
+        const std::string& input = item.second;
+        std::cout << "json_inplace_decoder, " << item.first << ", " << input.size()/1024 << " KB input\n";
+
+        std::cout << "  json\n";
+        run_benchmark<json_decoder<json>,json_decoder<counted_json,counting_allocator<char>>>(
+            "json_decoder:         ", input);
+        run_benchmark<json_inplace_decoder<json>,json_inplace_decoder<counted_json,counting_allocator<char>>>(
+            "json_inplace_decoder: ", input);
+        std::cout << "  ojson\n";
+        run_benchmark<json_decoder<ojson>,json_decoder<counted_ojson,counting_allocator<char>>>(
+            "json_decoder:         ", input);
+        run_benchmark<json_inplace_decoder<ojson>,json_inplace_decoder<counted_ojson,counting_allocator<char>>>(
+            "json_inplace_decoder: ", input);
+    }
+}
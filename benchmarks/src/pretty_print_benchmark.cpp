@@ -0,0 +1,54 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+// Compares dumping a document with indenting::indent with dumping it compact.
+// The indented output is larger, the aim is to keep it within about 20% of the compact time.
+
+#include <jsoncons/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace jsoncons;
+
+int main()
+{
+    json j(json_array_arg);
+    for (std::size_t i = 0; i < 50000; ++i)
+    {
+        json item(json_object_arg);
+        item.try_emplace("id", i);
+        item.try_emplace("name", "item " + std::to_string(i));
+        item.try_emplace("active", i % 2 == 0);
+        item.try_emplace("price", 0.25 + i);
+        json tags(json_array_arg, {"first","second","third"});
+        item.try_emplace("tags", std::move(tags));
+        json location(json_object_arg);
+        location.try_emplace("city", "Toronto");
+        location.try_emplace("coordinates", json(json_array_arg, {43.6532, -79.3832}));
+        item.try_emplace("location", std::move(location));
+        j.push_back(std::move(item));
+    }
+
+    std::string compact;
+    std::string pretty;
+    std::chrono::microseconds best_compact = std::chrono::microseconds::max();
+    std::chrono::microseconds best_pretty = std::chrono::microseconds::max();
+    for (int k = 0; k < 5; ++k)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        compact.clear();
+        j.dump(compact);
+        auto to_compact = std::chrono::high_resolution_clock::now();
+        pretty.clear();
+        j.dump(pretty, indenting::indent);
+        auto to_pretty = std::chrono::high_resolution_clock::now();
+        best_compact = (std::min)(best_compact, std::chrono::duration_cast<std::chrono::microseconds>(to_compact - start));
+        best_pretty = (std::min)(best_pretty, std::chrono::duration_cast<std::chrono::microseconds>(to_pretty - to_compact));
+    }
+    std::cout << "pretty print\n";
+    std::cout << "    compact, " << compact.size()/1024 << " KB output: " << best_compact.count()/1000 << " ms\n";
+    std::cout << "    pretty, " << pretty.size()/1024 << " KB output: " << best_pretty.count()/1000 << " ms\n";
+    std::cout << "    pretty/compact: " << static_cast<double>(best_pretty.count())/best_compact.count() << "\n";
+}
@@ -0,0 +1,86 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+// Compares writing doubles in shortest form with Ryu, as write_number.hpp does,
+// with the previous grisu3 path, which fell back to snprintf when grisu3 bailed out
+
+#include <jsoncons/detail/write_number.hpp>
+#include <jsoncons/detail/grisu3.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+    bool grisu3_dtoa_general(double v, std::string& result)
+    {
+        if (v == 0)
+        {
+            result.append("0.0");
+            return true;
+        }
+        int length = 0;
+        int k;
+        char buffer[100];
+        double u = std::signbit(v) ? -v : v;
+        if (jsoncons::detail::grisu3(u, buffer, &length, &k))
+        {
+            if (std::signbit(v))
+            {
+                result.push_back('-');
+            }
+            jsoncons::detail::prettify_string(buffer, length, k, -4, std::numeric_limits<double>::max_digits10, result);
+            return true;
+        }
+        return jsoncons::detail::dtoa_general(v, '.', result, std::false_type());
+    }
+
+}
+
+int main()
+{
+    // Half of the values have random bit patterns, half are in a range typical of data
+    std::mt19937_64 gen(2020);
+    std::uniform_real_distribution<double> dist(-1.0e6, 1.0e6);
+
+    std::vector<double> values;
+    for (std::size_t i = 0; i < 1000000; ++i)
+    {
+        uint64_t bits = gen();
+        double x;
+        std::memcpy(&x, &bits, sizeof(double));
+        values.push_back(i % 2 == 0 && std::isfinite(x) ? x : dist(gen));
+    }
+
+    std::string s;
+    s.reserve(32);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::size_t ryu_length = 0;
+    for (double x : values)
+    {
+        s.clear();
+        jsoncons::detail::dtoa_general(x, '.', s);
+        ryu_length += s.size();
+    }
+    auto ryu_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start);
+
+    start = std::chrono::high_resolution_clock::now();
+    std::size_t grisu3_length = 0;
+    for (double x : values)
+    {
+        s.clear();
+        grisu3_dtoa_general(x, s);
+        grisu3_length += s.size();
+    }
+    auto grisu3_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start);
+
+    std::cout << "write_double, " << values.size() << " values\n";
+    std::cout << "    ryu:    " << ryu_time.count() << " ms, " << ryu_length << " characters\n";
+    std::cout << "    grisu3: " << grisu3_time.count() << " ms, " << grisu3_length << " characters\n";
+}
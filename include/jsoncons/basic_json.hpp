@@ -21,6 +21,7 @@
 #include <utility> // std::move
 #include <type_traits> // std::enable_if
 #include <istream> // std::basic_istream
+#include <atomic> // std::atomic
 #include <jsoncons/json_fwd.hpp>
 #include <jsoncons/json_type.hpp>
 #include <jsoncons/config/version.hpp>
@@ -50,6 +51,99 @@ template <class CharT, class ImplementationPolicy, class Allocator>
 struct is_basic_json<basic_json<CharT,ImplementationPolicy,Allocator>> : std::true_type
 {};
 
+// is_copy_on_write
+
+template <class Policy, class Enable=void>
+struct is_copy_on_write : std::false_type
+{};
+
+template <class Policy>
+struct is_copy_on_write<Policy,typename std::enable_if<Policy::copy_on_write::value>::type> : std::true_type
+{};
+
+// The heap allocated part of an array or object. With a copy-on-write policy it
+// also counts the values that share it. The std::true_type constructor argument
+// keeps the forwarding constructor from being taken for a copy constructor.
+
+template <class T,class CopyOnWrite>
+struct storage_block
+{
+    T value;
+
+    template <class... Args>
+    explicit storage_block(std::true_type, Args&& ... args)
+        : value(std::forward<Args>(args)...)
+    {
+    }
+
+    std::size_t use_count() const noexcept
+    {
+        return 1;
+    }
+
+    void add_ref() noexcept
+    {
+    }
+
+    bool release() noexcept
+    {
+        return true;
+    }
+
+    bool is_shareable() const noexcept
+    {
+        return false;
+    }
+
+    void set_unshareable() noexcept
+    {
+    }
+};
+
+// Once a reference or iterator into the value has been handed out, the block is unshareable,
+// and copies get a block of their own, as with the "leaked" state of a reference counted string.
+// Only a value that is the sole owner of the block marks it, so the flag needs no synchronization.
+
+template <class T>
+struct storage_block<T,std::true_type>
+{
+    std::atomic<std::size_t> count;
+    bool shareable;
+    T value;
+
+    template <class... Args>
+    explicit storage_block(std::true_type, Args&& ... args)
+        : count(1), shareable(true), value(std::forward<Args>(args)...)
+    {
+    }
+
+    std::size_t use_count() const noexcept
+    {
+        return count.load(std::memory_order_acquire);
+    }
+
+    void add_ref() noexcept
+    {
+        count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Returns true when the last reference has been released
+    bool release() noexcept
+    {
+        return count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+    bool is_shareable() const noexcept
+    {
+        return shareable;
+    }
+
+    void set_unshareable() noexcept
+    {
+        shareable = false;
+    }
+};
+
 } // namespace detail
 
     
@@ -249,6 +343,25 @@ struct preserve_order_policy : public sorted_policy
     using key_order = preserve_key_order;
 };
 
+struct hashed_policy : public sorted_policy
+{
+    using key_order = hash_key_order;
+};
+
+struct hashed_preserve_order_policy : public preserve_order_policy
+{
+    using key_order = hash_preserve_key_order;
+};
+
+// Arrays and objects are reference counted, and copied only when a value that
+// shares one is accessed for modification
+
+template <class Policy>
+struct copy_on_write_policy : public Policy
+{
+    using copy_on_write = std::true_type;
+};
+
 template <class IteratorT, class ConstIteratorT>
 class range 
 {
@@ -324,6 +437,8 @@ public:
 
     using implementation_policy = ImplementationPolicy;
 
+    using copy_on_write = typename jsoncons::detail::is_copy_on_write<ImplementationPolicy>::type;
+
     using parse_error_handler_type = typename ImplementationPolicy::parse_error_handler_type;
 
     using char_type = CharT;
@@ -332,7 +447,7 @@ public:
 
     using char_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<char_type>;
 
-    using key_type = std::basic_string<char_type,char_traits_type,char_allocator_type>;
+    using key_type = typename implementation_policy::template key_storage<char_type,char_traits_type,char_allocator_type>;
 
 
     using reference = basic_json&;
@@ -691,31 +806,61 @@ public:
             uint8_t length_:4;
             semantic_tag tag_;
         private:
-            using array_allocator = typename std::allocator_traits<Allocator>:: template rebind_alloc<array>;
-            using pointer = typename std::allocator_traits<array_allocator>::pointer;
+            using block_type = jsoncons::detail::storage_block<array,copy_on_write>;
+            using block_allocator = typename std::allocator_traits<Allocator>:: template rebind_alloc<block_type>;
+            using pointer = typename std::allocator_traits<block_allocator>::pointer;
 
             pointer ptr_;
 
             template <typename... Args>
-            void create(array_allocator alloc, Args&& ... args)
+            void create(block_allocator alloc, Args&& ... args)
             {
-                ptr_ = std::allocator_traits<array_allocator>::allocate(alloc, 1);
+                ptr_ = std::allocator_traits<block_allocator>::allocate(alloc, 1);
                 JSONCONS_TRY
                 {
-                    std::allocator_traits<array_allocator>::construct(alloc, jsoncons::detail::to_plain_pointer(ptr_), std::forward<Args>(args)...);
+                    std::allocator_traits<block_allocator>::construct(alloc, jsoncons::detail::to_plain_pointer(ptr_), std::true_type(), std::forward<Args>(args)...);
                 }
                 JSONCONS_CATCH(...)
                 {
-                    std::allocator_traits<array_allocator>::deallocate(alloc, ptr_,1);
+                    std::allocator_traits<block_allocator>::deallocate(alloc, ptr_,1);
                     JSONCONS_RETHROW;
                 }
             }
 
-            void destroy() noexcept
+            static void destroy(pointer ptr) noexcept
             {
-                array_allocator alloc(ptr_->get_allocator());
-                std::allocator_traits<array_allocator>::destroy(alloc, jsoncons::detail::to_plain_pointer(ptr_));
-                std::allocator_traits<array_allocator>::deallocate(alloc, ptr_,1);
+                if (ptr->release())
+                {
+                    block_allocator alloc(ptr->value.get_allocator());
+                    std::allocator_traits<block_allocator>::destroy(alloc, jsoncons::detail::to_plain_pointer(ptr));
+                    std::allocator_traits<block_allocator>::deallocate(alloc, ptr,1);
+                }
+            }
+
+            void copy(const array_storage& val, std::true_type)
+            {
+                if (val.ptr_->is_shareable())
+                {
+                    ptr_ = val.ptr_;
+                    ptr_->add_ref();
+                }
+                else
+                {
+                    create(val.ptr_->value.get_allocator(), val.ptr_->value);
+                }
+            }
+
+            void copy(const array_storage& val, std::false_type)
+            {
+                create(val.ptr_->value.get_allocator(), val.ptr_->value);
+            }
+
+            // Gives this value an array of its own before it is modified
+            void unshare()
+            {
+                pointer shared = ptr_;
+                create(shared->value.get_allocator(), shared->value);
+                destroy(shared);
             }
         public:
             array_storage(const array& val, semantic_tag tag)
@@ -727,13 +872,13 @@ public:
             array_storage(const array& val, semantic_tag tag, const Allocator& a)
                 : storage_(val.storage_), length_(0), tag_(val.tag_)
             {
-                create(array_allocator(a), val, a);
+                create(block_allocator(a), val, a);
             }
 
             array_storage(const array_storage& val)
                 : storage_(val.storage_), length_(0), tag_(val.tag_)
             {
-                create(val.ptr_->get_allocator(), *(val.ptr_));
+                copy(val, copy_on_write());
             }
 
             array_storage(array_storage&& val) noexcept
@@ -746,19 +891,19 @@ public:
             array_storage(const array_storage& val, const Allocator& a)
                 : storage_(val.storage_), length_(0), tag_(val.tag_)
             {
-                create(array_allocator(a), *(val.ptr_), a);
+                create(block_allocator(a), val.ptr_->value, a);
             }
             ~array_storage() noexcept
             {
                 if (ptr_ != nullptr)
                 {
-                    destroy();
+                    destroy(ptr_);
                 }
             }
 
             allocator_type get_allocator() const
             {
-                return ptr_->get_allocator();
+                return ptr_->value.get_allocator();
             }
 
             void swap(array_storage& val) noexcept
@@ -766,14 +911,40 @@ public:
                 std::swap(val.ptr_,ptr_);
             }
 
+            std::size_t use_count() const noexcept
+            {
+                return ptr_->use_count();
+            }
+
+            bool is_shareable() const noexcept
+            {
+                return ptr_->is_shareable();
+            }
+
+            // The returned reference may be kept, so the array is no longer shared with copies
             array& value()
             {
-                return *ptr_;
+                if (ptr_->use_count() > 1)
+                {
+                    unshare();
+                }
+                ptr_->set_unshareable();
+                return ptr_->value;
+            }
+
+            // For code that fills in the array and keeps no references or iterators into it
+            array& value_unchecked()
+            {
+                if (ptr_->use_count() > 1)
+                {
+                    unshare();
+                }
+                return ptr_->value;
             }
 
             const array& value() const
             {
-                return *ptr_;
+                return ptr_->value;
             }
         };
 
@@ -785,25 +956,52 @@ public:
             uint8_t length_:4;
             semantic_tag tag_;
         private:
-            using object_allocator = typename std::allocator_traits<Allocator>:: template rebind_alloc<object>;
-            using pointer = typename std::allocator_traits<object_allocator>::pointer;
+            using block_type = jsoncons::detail::storage_block<object,copy_on_write>;
+            using block_allocator = typename std::allocator_traits<Allocator>:: template rebind_alloc<block_type>;
+            using pointer = typename std::allocator_traits<block_allocator>::pointer;
 
             pointer ptr_;
 
             template <typename... Args>
-            void create(object_allocator alloc, Args&& ... args)
+            void create(block_allocator alloc, Args&& ... args)
             {
-                ptr_ = std::allocator_traits<object_allocator>::allocate(alloc, 1);
+                ptr_ = std::allocator_traits<block_allocator>::allocate(alloc, 1);
                 JSONCONS_TRY
                 {
-                    std::allocator_traits<object_allocator>::construct(alloc, jsoncons::detail::to_plain_pointer(ptr_), std::forward<Args>(args)...);
+                    std::allocator_traits<block_allocator>::construct(alloc, jsoncons::detail::to_plain_pointer(ptr_), std::true_type(), std::forward<Args>(args)...);
                 }
                 JSONCONS_CATCH(...)
                 {
-                    std::allocator_traits<object_allocator>::deallocate(alloc, ptr_,1);
+                    std::allocator_traits<block_allocator>::deallocate(alloc, ptr_,1);
                     JSONCONS_RETHROW;
                 }
             }
+
+            void copy(const object_storage& val, std::true_type)
+            {
+                if (val.ptr_->is_shareable())
+                {
+                    ptr_ = val.ptr_;
+                    ptr_->add_ref();
+                }
+                else
+                {
+                    create(val.ptr_->value.get_allocator(), val.ptr_->value);
+                }
+            }
+
+            void copy(const object_storage& val, std::false_type)
+            {
+                create(val.ptr_->value.get_allocator(), val.ptr_->value);
+            }
+
+            // Gives this value an object of its own before it is modified
+            void unshare()
+            {
+                pointer shared = ptr_;
+                create(shared->value.get_allocator(), shared->value);
+                destroy(shared);
+            }
         public:
             explicit object_storage(const object& val, semantic_tag tag)
                 : storage_(static_cast<uint8_t>(storage_kind::object_value)), length_(0), tag_(tag)
@@ -814,13 +1012,13 @@ public:
             explicit object_storage(const object& val, semantic_tag tag, const Allocator& a)
                 : storage_(val.storage_), length_(0), tag_(val.tag_)
             {
-                create(object_allocator(a), val, a);
+                create(block_allocator(a), val, a);
             }
 
             explicit object_storage(const object_storage& val)
                 : storage_(val.storage_), length_(0), tag_(val.tag_)
             {
-                create(val.ptr_->get_allocator(), *(val.ptr_));
+                copy(val, copy_on_write());
             }
 
             explicit object_storage(object_storage&& val) noexcept
@@ -833,14 +1031,14 @@ public:
             explicit object_storage(const object_storage& val, const Allocator& a)
                 : storage_(val.storage_), tag_(val.tag_)
             {
-                create(object_allocator(a), *(val.ptr_), a);
+                create(block_allocator(a), val.ptr_->value, a);
             }
 
             ~object_storage() noexcept
             {
                 if (ptr_ != nullptr)
                 {
-                    destroy();
+                    destroy(ptr_);
                 }
             }
 
@@ -849,27 +1047,56 @@ public:
                 std::swap(val.ptr_,ptr_);
             }
 
+            std::size_t use_count() const noexcept
+            {
+                return ptr_->use_count();
+            }
+
+            bool is_shareable() const noexcept
+            {
+                return ptr_->is_shareable();
+            }
+
+            // The returned reference may be kept, so the object is no longer shared with copies
             object& value()
             {
-                return *ptr_;
+                if (ptr_->use_count() > 1)
+                {
+                    unshare();
+                }
+                ptr_->set_unshareable();
+                return ptr_->value;
+            }
+
+            // For code that fills in the object and keeps no references or iterators into it
+            object& value_unchecked()
+            {
+                if (ptr_->use_count() > 1)
+                {
+                    unshare();
+                }
+                return ptr_->value;
             }
 
             const object& value() const
             {
-                return *ptr_;
+                return ptr_->value;
             }
 
             allocator_type get_allocator() const
             {
-                return ptr_->get_allocator();
+                return ptr_->value.get_allocator();
             }
         private:
 
-            void destroy() noexcept
+            static void destroy(pointer ptr) noexcept
             {
-                object_allocator alloc(ptr_->get_allocator());
-                std::allocator_traits<object_allocator>::destroy(alloc, jsoncons::detail::to_plain_pointer(ptr_));
-                std::allocator_traits<object_allocator>::deallocate(alloc, ptr_,1);
+                if (ptr->release())
+                {
+                    block_allocator alloc(ptr->value.get_allocator());
+                    std::allocator_traits<block_allocator>::destroy(alloc, jsoncons::detail::to_plain_pointer(ptr));
+                    std::allocator_traits<block_allocator>::deallocate(alloc, ptr,1);
+                }
             }
         };
 
@@ -3017,8 +3244,12 @@ public:
 #endif
 
     basic_json(const basic_json& val)
-        : var_(val.var_)
+        : var_(copies_members(val) ? empty_like(val) : val.var_)
     {
+        if (copies_members(val))
+        {
+            copy_members(val);
+        }
     }
 
     basic_json(const basic_json& val, const Allocator& alloc)
@@ -3248,7 +3479,7 @@ public:
 
     friend bool operator==(const basic_json& lhs, const basic_json& rhs)
     {
-        return lhs.var_ == rhs.var_;
+        return is_nonempty_container(lhs) && is_nonempty_container(rhs) ? lhs.equal_members(rhs) : lhs.var_ == rhs.var_;
     }
 
     friend bool operator!=(const basic_json& lhs, const basic_json& rhs)
@@ -3394,12 +3625,12 @@ public:
         if (line_indent == indenting::indent)
         {
             basic_json_encoder<char_type,jsoncons::string_sink<string_type>> encoder(s, options);
-            dump(encoder, ec);
+            dump_to_encoder(encoder, ec);
         }
         else
         {
             basic_compact_json_encoder<char_type,jsoncons::string_sink<string_type>> encoder(s, options);
-            dump(encoder, ec);
+            dump_to_encoder(encoder, ec);
         }
     }
 
@@ -3412,12 +3643,12 @@ public:
         if (line_indent == indenting::indent)
         {
             basic_json_encoder<char_type,jsoncons::string_sink<string_type>> encoder(s);
-            dump(encoder, ec);
+            dump_to_encoder(encoder, ec);
         }
         else
         {
             basic_compact_json_encoder<char_type,jsoncons::string_sink<string_type>> encoder(s);
-            dump(encoder, ec);
+            dump_to_encoder(encoder, ec);
         }
     }
 
@@ -3429,12 +3660,12 @@ public:
         if (line_indent == indenting::indent)
         {
             basic_json_encoder<char_type> encoder(os, options);
-            dump(encoder, ec);
+            dump_to_encoder(encoder, ec);
         }
         else
         {
             basic_compact_json_encoder<char_type> encoder(os, options);
-            dump(encoder, ec);
+            dump_to_encoder(encoder, ec);
         }
     }
 
@@ -3445,12 +3676,12 @@ public:
         if (line_indent == indenting::indent)
         {
             basic_json_encoder<char_type> encoder(os);
-            dump(encoder, ec);
+            dump_to_encoder(encoder, ec);
         }
         else
         {
             basic_compact_json_encoder<char_type> encoder(os);
-            dump(encoder, ec);
+            dump_to_encoder(encoder, ec);
         }
     }
 
@@ -3678,6 +3909,22 @@ public:
         }
     }
 
+    // The number of values that share this value's array or object, including this one.
+    // Always 1 for an array or object unless the policy is a copy_on_write_policy, and
+    // 0 for other values.
+    std::size_t use_count() const noexcept
+    {
+        switch (var_.storage())
+        {
+        case storage_kind::array_value:
+            return var_.template cast<typename variant::array_storage>().use_count();
+        case storage_kind::object_value:
+            return var_.template cast<typename variant::object_storage>().use_count();
+        default:
+            return 0;
+        }
+    }
+
     template<class U=Allocator>
     void create_object_implicitly()
     {
@@ -5410,11 +5657,361 @@ public:
         }
     }
 
+    // Like array_value() and object_value(), for code that builds this value in place and keeps 
+    // no references or iterators into it afterwards. With a copy-on-write policy, the array or
+    // object stays shareable with copies.
+    array& array_value_unchecked() 
+    {
+        switch (var_.storage())
+        {
+        case storage_kind::array_value:
+            return var_.template cast<typename variant::array_storage>().value_unchecked();
+        default:
+            JSONCONS_THROW(json_runtime_error<std::domain_error>("Bad array cast"));
+            break;
+        }
+    }
+
+    object& object_value_unchecked()
+    {
+        switch (var_.storage())
+        {
+        case storage_kind::empty_object_value:
+            create_object_implicitly();
+            JSONCONS_FALLTHROUGH;
+        case storage_kind::object_value:
+            return var_.template cast<typename variant::object_storage>().value_unchecked();
+        default:
+            JSONCONS_THROW(json_runtime_error<std::domain_error>("Bad object cast"));
+            break;
+        }
+    }
+
 private:
 
-    void dump_noflush(basic_json_visitor<char_type>& visitor, std::error_code& ec) const
+    static bool is_nonempty_container(const basic_json& val) noexcept
+    {
+        switch (val.var_.storage())
+        {
+            case storage_kind::array_value:
+                return !val.var_.template cast<typename variant::array_storage>().value().empty();
+            case storage_kind::object_value:
+                return val.var_.template cast<typename variant::object_storage>().value().size() != 0;
+            default:
+                return false;
+        }
+    }
+
+    // Whether copying val copies its elements or members one at a time. With a copy-on-write
+    // policy the copy shares them instead, unless references into them have been handed out.
+    static bool copies_members(const basic_json& val) noexcept
+    {
+        return is_nonempty_container(val) && !is_shareable(val);
+    }
+
+    static bool is_shareable(const basic_json& val) noexcept
+    {
+        switch (val.var_.storage())
+        {
+            case storage_kind::array_value:
+                return val.var_.template cast<typename variant::array_storage>().is_shareable();
+            case storage_kind::object_value:
+                return val.var_.template cast<typename variant::object_storage>().is_shareable();
+            default:
+                return false;
+        }
+    }
+
+    // An empty array or object with the tag and allocator of val
+    static variant empty_like(const basic_json& val)
+    {
+        switch (val.var_.storage())
+        {
+            case storage_kind::array_value:
+                return variant(array(val.array_value().get_allocator()), val.tag());
+            default:
+                return variant(object(val.object_value().get_allocator()), val.tag());
+        }
+    }
+
+    // Copies the elements or members of val, a non-empty array or object, into this empty
+    // one. Nested arrays and objects are filled from an explicit work stack rather than by
+    // recursion, so the depth of val is not limited by the size of the call stack.
+    void copy_members(const basic_json& val)
+    {
+        std::vector<std::pair<const basic_json*,basic_json*>> stack;
+        stack.emplace_back(&val, this);
+        while (!stack.empty())
+        {
+            const basic_json& from = *stack.back().first;
+            basic_json& to = *stack.back().second;
+            stack.pop_back();
+
+            if (from.var_.storage() == storage_kind::array_value)
+            {
+                const array& elements = from.array_value();
+                array& target = to.array_value_unchecked();
+                target.reserve(elements.size());
+                for (const auto& item : elements)
+                {
+                    if (copies_members(item))
+                    {
+                        target.emplace_back(empty_like(item));
+                    }
+                    else
+                    {
+                        target.emplace_back(item);
+                    }
+                }
+                auto it = target.begin();
+                for (const auto& item : elements)
+                {
+                    if (copies_members(item))
+                    {
+                        stack.emplace_back(&item, &(*it));
+                    }
+                    ++it;
+                }
+            }
+            else
+            {
+                const object& members = from.object_value();
+                object& target = to.object_value_unchecked();
+                target.reserve(members.size());
+                for (const auto& kv : members)
+                {
+                    if (copies_members(kv.value()))
+                    {
+                        target.emplace_back_unchecked(key_type(kv.key()), empty_like(kv.value()));
+                    }
+                    else
+                    {
+                        target.emplace_back_unchecked(key_type(kv.key()), kv.value());
+                    }
+                }
+                // The members are copies of those of val, in the same order, so the 
+                // target can take the index of val rather than build its own
+                target.copy_index_from(members);
+                auto it = target.begin();
+                for (const auto& kv : members)
+                {
+                    if (copies_members(kv.value()))
+                    {
+                        stack.emplace_back(&kv.value(), &(it->value()));
+                    }
+                    ++it;
+                }
+            }
+        }
+    }
+
+    // Compares this non-empty array or object with other. Like copy_members, it walks nested
+    // arrays and objects with an explicit work stack.
+    bool equal_members(const basic_json& other) const
+    {
+        using positional = std::integral_constant<bool,!std::is_same<typename implementation_policy::key_order,hash_key_order>::value>;
+
+        std::vector<std::pair<const basic_json*,const basic_json*>> stack;
+        stack.emplace_back(this, &other);
+        while (!stack.empty())
+        {
+            const basic_json& lhs = *stack.back().first;
+            const basic_json& rhs = *stack.back().second;
+            stack.pop_back();
+
+            if (lhs.var_.storage() != rhs.var_.storage() || lhs.size() != rhs.size())
+            {
+                return false;
+            }
+            if (shares_members(lhs, rhs))
+            {
+                continue;
+            }
+            if (lhs.var_.storage() == storage_kind::array_value)
+            {
+                auto it = rhs.array_value().begin();
+                for (const auto& item : lhs.array_value())
+                {
+                    if (!equal_or_defer(item, *it, stack))
+                    {
+                        return false;
+                    }
+                    ++it;
+                }
+            }
+            else if (!equal_object_members(lhs.object_value(), rhs.object_value(), stack, positional()))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Whether lhs and rhs are copies that share an array or object
+    static bool shares_members(const basic_json& lhs, const basic_json& rhs) noexcept
+    {
+        if (!copy_on_write::value || lhs.var_.storage() != rhs.var_.storage())
+        {
+            return false;
+        }
+        switch (lhs.var_.storage())
+        {
+            case storage_kind::array_value:
+                return &lhs.array_value() == &rhs.array_value();
+            case storage_kind::object_value:
+                return &lhs.object_value() == &rhs.object_value();
+            default:
+                return false;
+        }
+    }
+
+    // Members compare in order, as in json_object::operator==
+    static bool equal_object_members(const object& lhs, const object& rhs, 
+                                     std::vector<std::pair<const basic_json*,const basic_json*>>& stack,
+                                     std::true_type)
+    {
+        auto it = rhs.begin();
+        for (const auto& kv : lhs)
+        {
+            if (!(kv.key() == it->key()) || !equal_or_defer(kv.value(), it->value(), stack))
+            {
+                return false;
+            }
+            ++it;
+        }
+        return true;
+    }
+
+    // Members compare in any order, as in the hash_key_order json_object::operator==
+    static bool equal_object_members(const object& lhs, const object& rhs, 
+                                     std::vector<std::pair<const basic_json*,const basic_json*>>& stack,
+                                     std::false_type)
+    {
+        for (const auto& kv : lhs)
+        {
+            auto it = rhs.find(kv.key());
+            if (it == rhs.end() || !equal_or_defer(kv.value(), it->value(), stack))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Compares two values that are not both non-empty containers, or else pushes them
+    // on the stack to be compared later
+    static bool equal_or_defer(const basic_json& lhs, const basic_json& rhs, 
+                               std::vector<std::pair<const basic_json*,const basic_json*>>& stack)
+    {
+        if (shares_members(lhs, rhs))
+        {
+            return true;
+        }
+        if (is_nonempty_container(lhs) && is_nonempty_container(rhs))
+        {
+            stack.emplace_back(&lhs, &rhs);
+            return true;
+        }
+        return lhs.var_ == rhs.var_;
+    }
+
+    // A container whose elements or members are being written
+    struct dump_frame
+    {
+        const basic_json* container;
+        std::size_t index;
+    };
+
+    // Writes the value with an explicit stack of open containers rather than by recursion.
+    // It is a template so that when the visitor's type is a final encoder, like
+    // basic_json_encoder and basic_compact_json_encoder, the visitor calls can be resolved
+    // statically and inlined.
+    template <class Visitor>
+    void dump_noflush(Visitor& visitor, std::error_code& ec) const
     {
         const ser_context context{};
+        std::vector<dump_frame> stack;
+        const basic_json* current = this;
+
+        while (current != nullptr && !ec)
+        {
+            switch (current->var_.storage())
+            {
+                case storage_kind::object_value:
+                    if (visitor.begin_object(current->size(), current->var_.tag(), context, ec))
+                    {
+                        stack.push_back(dump_frame{current, 0});
+                    }
+                    break;
+                case storage_kind::array_value:
+                    if (visitor.begin_array(current->size(), current->var_.tag(), context, ec))
+                    {
+                        stack.push_back(dump_frame{current, 0});
+                    }
+                    break;
+                default:
+                    current->dump_leaf(visitor, context, ec);
+                    break;
+            }
+
+            // Find the next array or object to open, writing the other values of the
+            // enclosing containers in runs, and closing the containers that are done
+            current = nullptr;
+            while (current == nullptr && !stack.empty() && !ec)
+            {
+                dump_frame& frame = stack.back();
+                if (frame.container->var_.storage() == storage_kind::array_value)
+                {
+                    const array& elements = frame.container->var_.template cast<typename variant::array_storage>().value();
+                    while (frame.index < elements.size())
+                    {
+                        const basic_json& item = elements[frame.index++];
+                        if (is_container_storage(item.var_.storage()))
+                        {
+                            current = &item;
+                            break;
+                        }
+                        item.dump_leaf(visitor, context, ec);
+                    }
+                    if (current == nullptr)
+                    {
+                        visitor.end_array(context, ec);
+                        stack.pop_back();
+                    }
+                }
+                else
+                {
+                    const object& members = frame.container->var_.template cast<typename variant::object_storage>().value();
+                    while (frame.index < members.size())
+                    {
+                        const auto& kv = *(members.begin() + frame.index++);
+                        visitor.key(string_view_type(kv.key().data(),kv.key().length()), context, ec);
+                        if (is_container_storage(kv.value().var_.storage()))
+                        {
+                            current = &kv.value();
+                            break;
+                        }
+                        kv.value().dump_leaf(visitor, context, ec);
+                    }
+                    if (current == nullptr)
+                    {
+                        visitor.end_object(context, ec);
+                        stack.pop_back();
+                    }
+                }
+            }
+        }
+    }
+
+    static bool is_container_storage(storage_kind storage) noexcept
+    {
+        return storage == storage_kind::array_value || storage == storage_kind::object_value;
+    }
+
+    // Writes a value that is not a non-empty array or object
+    template <class Visitor>
+    void dump_leaf(Visitor& visitor, const ser_context& context, std::error_code& ec) const
+    {
         switch (var_.storage())
         {
             case storage_kind::short_string_value:
@@ -5454,40 +6051,23 @@ private:
                 visitor.begin_object(0, var_.tag(), context, ec);
                 visitor.end_object(context, ec);
                 break;
-            case storage_kind::object_value:
-            {
-                bool more = visitor.begin_object(size(), var_.tag(), context, ec);
-                const object& o = object_value();
-                for (auto it = o.begin(); more && it != o.end(); ++it)
-                {
-                    visitor.key(string_view_type((it->key()).data(),it->key().length()), context, ec);
-                    it->value().dump_noflush(visitor, ec);
-                }
-                if (more)
-                {
-                    visitor.end_object(context, ec);
-                }
-                break;
-            }
-            case storage_kind::array_value:
-            {
-                bool more = visitor.begin_array(size(), var_.tag(), context, ec);
-                const array& o = array_value();
-                for (const_array_iterator it = o.begin(); more && it != o.end(); ++it)
-                {
-                    it->dump_noflush(visitor, ec);
-                }
-                if (more)
-                {
-                    visitor.end_array(context, ec);
-                }
-                break;
-            }
             default:
                 break;
         }
     }
 
+    // Writes the value to one of the encoders that dump constructs, whose type is known
+    template <class Encoder>
+    void dump_to_encoder(Encoder& encoder, std::error_code& ec) const
+    {
+        dump_noflush(encoder, ec);
+        if (ec)
+        {
+            return;
+        }
+        encoder.flush();
+    }
+
     friend std::basic_ostream<char_type>& operator<<(std::basic_ostream<char_type>& os, const basic_json& o)
     {
         o.dump(os);
@@ -5519,6 +6099,8 @@ using json = basic_json<char,sorted_policy,std::allocator<char>>;
 using wjson = basic_json<wchar_t,sorted_policy,std::allocator<char>>;
 using ojson = basic_json<char, preserve_order_policy, std::allocator<char>>;
 using wojson = basic_json<wchar_t, preserve_order_policy, std::allocator<char>>;
+using cow_json = basic_json<char,copy_on_write_policy<sorted_policy>,std::allocator<char>>;
+using cow_ojson = basic_json<char,copy_on_write_policy<preserve_order_policy>,std::allocator<char>>;
 
 #if !defined(JSONCONS_NO_DEPRECATED)
 JSONCONS_DEPRECATED_MSG("Instead, use wojson") typedef basic_json<wchar_t, preserve_order_policy, std::allocator<wchar_t>> owjson;
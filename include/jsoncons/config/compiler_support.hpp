@@ -226,5 +226,18 @@
 #  define JSONCONS_CPP14_CONSTEXPR
 #endif
 
+// Define JSONCONS_NO_SIMD to force the scalar code paths
+#if !defined(JSONCONS_NO_SIMD)
+#  if defined(__AVX2__)
+#    define JSONCONS_HAS_AVX2 1
+#  endif
+#  if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define JSONCONS_HAS_SSE2 1
+#  endif
+#  if (defined(__aarch64__) && defined(__ARM_NEON)) || defined(_M_ARM64)
+#    define JSONCONS_HAS_NEON 1
+#  endif
+#endif // !defined(JSONCONS_NO_SIMD)
+
 #endif // JSONCONS_COMPILER_SUPPORT_HPP
 
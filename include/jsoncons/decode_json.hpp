@@ -171,6 +171,35 @@ namespace jsoncons {
         return val;
     }
 
+    // With leading result allocator parameter, for building the result with a stateful allocator,
+    // e.g. a monotonic_allocator
+
+    template <class T,class CharT,class ResultAllocator>
+    typename std::enable_if<is_basic_json<T>::value,T>::type
+    decode_json(result_allocator_arg_t, const ResultAllocator& result_alloc,
+                const std::basic_string<CharT>& s,
+                const basic_json_decode_options<CharT>& options = basic_json_decode_options<CharT>())
+    {
+        json_decoder<T> decoder(result_allocator_arg, result_alloc);
+
+        basic_json_reader<CharT, string_source<CharT>> reader(s, decoder, options);
+        reader.read();
+        return decoder.get_result();
+    }
+
+    template <class T,class CharT,class ResultAllocator>
+    typename std::enable_if<is_basic_json<T>::value,T>::type
+    decode_json(result_allocator_arg_t, const ResultAllocator& result_alloc,
+                std::basic_istream<CharT>& is,
+                const basic_json_decode_options<CharT>& options = basic_json_decode_options<CharT>())
+    {
+        json_decoder<T> decoder(result_allocator_arg, result_alloc);
+
+        basic_json_reader<CharT, stream_source<CharT>> reader(is, decoder, options);
+        reader.read();
+        return decoder.get_result();
+    }
+
 } // jsoncons
 
 #endif
@@ -4,6 +4,9 @@ Implements the Grisu3 algorithm for printing floating-point numbers.
 Follows Florian Loitsch's grisu3_59_56 implementation, available at
 http://florian.loitsch.com/publications, in bench.tar.gz, with 
 minor modifications. 
+
+The library no longer uses it, doubles are written with Ryu in write_number.hpp.
+It is kept as the baseline of benchmarks/src/write_double_benchmark.cpp.
 */
 
 /*
@@ -0,0 +1,338 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_HASH_INDEX_HPP
+#define JSONCONS_DETAIL_HASH_INDEX_HPP
+
+#include <cstdint>
+#include <vector>
+#include <algorithm> // std::fill
+#include <memory> // std::allocator_traits
+#include <utility> // std::pair
+#include <type_traits> // std::make_unsigned
+#include <jsoncons/config/compiler_support.hpp>
+
+namespace jsoncons { namespace detail {
+
+    // 32 bit FNV-1a over the code units of a key
+    template <class CharT>
+    uint32_t hash_key(const CharT* s, std::size_t length)
+    {
+        using unsigned_type = typename std::make_unsigned<CharT>::type;
+
+        uint32_t h = 2166136261u;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            h ^= static_cast<uint32_t>(static_cast<unsigned_type>(s[i]));
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    // An open addressing, linear probing table of (hash, position) pairs, indexing the
+    // members of a separate sequence by key. The table never touches the keys itself,
+    // callers pass a predicate that tells whether the member at a position matches.
+    // Positions are stored one based, so that zero marks an empty slot, and the table
+    // is kept at most half full.
+
+    template <class Allocator>
+    class hash_index
+    {
+    public:
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+    private:
+        using uint32_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<uint32_t>;
+
+        // The hashes and positions of the slots are kept apart, so that the passes that 
+        // renumber positions run over contiguous 32 bit integers
+        std::vector<uint32_t,uint32_allocator_type> hashes_;
+        std::vector<uint32_t,uint32_allocator_type> positions_;
+        std::size_t size_;
+    public:
+        hash_index()
+            : size_(0)
+        {
+        }
+
+        explicit hash_index(const Allocator& alloc)
+            : hashes_(uint32_allocator_type(alloc)), positions_(uint32_allocator_type(alloc)), size_(0)
+        {
+        }
+
+        hash_index(const hash_index& other) = default;
+
+        hash_index(hash_index&& other) noexcept
+            : hashes_(std::move(other.hashes_)), positions_(std::move(other.positions_)), size_(other.size_)
+        {
+            other.size_ = 0;
+        }
+
+        hash_index(const hash_index& other, const Allocator& alloc)
+            : hashes_(other.hashes_, uint32_allocator_type(alloc)), 
+              positions_(other.positions_, uint32_allocator_type(alloc)), 
+              size_(other.size_)
+        {
+        }
+
+        hash_index(hash_index&& other, const Allocator& alloc)
+            : hashes_(std::move(other.hashes_), uint32_allocator_type(alloc)), 
+              positions_(std::move(other.positions_), uint32_allocator_type(alloc)), 
+              size_(other.size_)
+        {
+            other.size_ = 0;
+        }
+
+        hash_index& operator=(const hash_index& other) = default;
+
+        hash_index& operator=(hash_index&& other) noexcept
+        {
+            swap(other);
+            return *this;
+        }
+
+        void swap(hash_index& other) noexcept
+        {
+            hashes_.swap(other.hashes_);
+            positions_.swap(other.positions_);
+            std::swap(size_, other.size_);
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+        void clear()
+        {
+            hashes_.clear();
+            positions_.clear();
+            size_ = 0;
+        }
+
+        // Removes all entries but keeps the table, for indexing the same members again
+        void reset()
+        {
+            std::fill(positions_.begin(), positions_.end(), 0);
+            size_ = 0;
+        }
+
+        // Makes room for n entries without rehashing
+        void reserve(std::size_t n)
+        {
+            if (2*n > positions_.size())
+            {
+                rehash(table_size_for(n));
+            }
+        }
+
+        void shrink_to_fit()
+        {
+            rehash(size_ == 0 ? 0 : table_size_for(size_));
+        }
+
+        template <class Matches>
+        std::size_t find(uint32_t hash, Matches matches) const
+        {
+            if (positions_.empty())
+            {
+                return npos;
+            }
+            const std::size_t mask = positions_.size() - 1;
+            for (std::size_t i = hash & mask; positions_[i] != 0; i = (i + 1) & mask)
+            {
+                if (hashes_[i] == hash && matches(positions_[i] - 1))
+                {
+                    return positions_[i] - 1;
+                }
+            }
+            return npos;
+        }
+
+        // Adds an entry for a key known not to be in the table
+        void insert_unique(uint32_t hash, std::size_t position)
+        {
+            reserve(size_ + 1);
+            place(hash, static_cast<uint32_t>(position + 1));
+            ++size_;
+        }
+
+        // Removes the entry for a position and leaves the other positions as they are.
+        // Backward shift deletion keeps the probe sequences intact without tombstones.
+        void remove(uint32_t hash, std::size_t position)
+        {
+            std::size_t i = slot_of(hash, position);
+            if (i == npos)
+            {
+                return;
+            }
+            const std::size_t mask = positions_.size() - 1;
+            for (std::size_t j = (i + 1) & mask; positions_[j] != 0; j = (j + 1) & mask)
+            {
+                // An entry can fill the hole at i only if its home slot is not cyclically in (i,j]
+                std::size_t home = hashes_[j] & mask;
+                bool reachable = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+                if (!reachable)
+                {
+                    hashes_[i] = hashes_[j];
+                    positions_[i] = positions_[j];
+                    i = j;
+                }
+            }
+            positions_[i] = 0;
+            --size_;
+        }
+
+        // Removes the entry for a position and moves the positions after it down by one,
+        // mirroring an erase from the members. O(1) to remove, plus one pass over the table.
+        void erase_entry(uint32_t hash, std::size_t position)
+        {
+            remove(hash, position);
+            const uint32_t first = static_cast<uint32_t>(position + 1);
+            uint32_t* p = positions_.data();
+            // The table size is a multiple of 8, and the fixed length inner loop without a branch vectorizes
+            for (std::size_t i = 0; i < positions_.size(); i += 8)
+            {
+                for (std::size_t k = 0; k < 8; ++k)
+                {
+                    p[i+k] -= p[i+k] > first;
+                }
+            }
+        }
+
+        // Moves the positions from position on up by one and adds an entry for position,
+        // mirroring an insert into the members. One pass over the table.
+        void insert_at(uint32_t hash, std::size_t position)
+        {
+            reserve(size_ + 1);
+            const uint32_t first = static_cast<uint32_t>(position + 1);
+            uint32_t* p = positions_.data();
+            for (std::size_t i = 0; i < positions_.size(); i += 8)
+            {
+                for (std::size_t k = 0; k < 8; ++k)
+                {
+                    p[i+k] += p[i+k] >= first;
+                }
+            }
+            place(hash, first);
+            ++size_;
+        }
+
+        // Removes the entries for positions in [first,last) and closes the gap,
+        // so that positions from last on move down by last - first, in one pass
+        // that rebuilds the table
+        void erase(std::size_t first, std::size_t last)
+        {
+            const std::size_t count = last - first;
+            if (count == 0)
+            {
+                return;
+            }
+            std::vector<uint32_t,uint32_allocator_type> old_hashes(hashes_.size(), 0, hashes_.get_allocator());
+            std::vector<uint32_t,uint32_allocator_type> old_positions(positions_.size(), 0, positions_.get_allocator());
+            old_hashes.swap(hashes_);
+            old_positions.swap(positions_);
+            size_ = 0;
+            for (std::size_t i = 0; i < old_positions.size(); ++i)
+            {
+                if (old_positions[i] != 0)
+                {
+                    std::size_t pos = old_positions[i] - 1;
+                    if (pos < first)
+                    {
+                        place(old_hashes[i], old_positions[i]);
+                        ++size_;
+                    }
+                    else if (pos >= last)
+                    {
+                        place(old_hashes[i], static_cast<uint32_t>(old_positions[i] - count));
+                        ++size_;
+                    }
+                }
+            }
+        }
+
+        // Gives the entry for the last position, size() - 1, the given position,
+        // and moves the entries from that position on up by one, mirroring a
+        // std::rotate of the members
+        void move_back_to(std::size_t position)
+        {
+            const uint32_t last = static_cast<uint32_t>(size_);
+            const uint32_t first = static_cast<uint32_t>(position + 1);
+            for (auto& p : positions_)
+            {
+                if (p == last)
+                {
+                    p = first;
+                }
+                else if (p >= first)
+                {
+                    ++p;
+                }
+            }
+        }
+
+    private:
+        static std::size_t table_size_for(std::size_t n)
+        {
+            std::size_t size = 8;
+            while (size < 2*n)
+            {
+                size *= 2;
+            }
+            return size;
+        }
+
+        std::size_t slot_of(uint32_t hash, std::size_t position) const
+        {
+            if (positions_.empty())
+            {
+                return npos;
+            }
+            const std::size_t mask = positions_.size() - 1;
+            for (std::size_t i = hash & mask; positions_[i] != 0; i = (i + 1) & mask)
+            {
+                if (positions_[i] == position + 1)
+                {
+                    return i;
+                }
+            }
+            return npos;
+        }
+
+        void place(uint32_t hash, uint32_t position)
+        {
+            const std::size_t mask = positions_.size() - 1;
+            std::size_t i = hash & mask;
+            while (positions_[i] != 0)
+            {
+                i = (i + 1) & mask;
+            }
+            hashes_[i] = hash;
+            positions_[i] = position;
+        }
+
+        void rehash(std::size_t table_size)
+        {
+            std::vector<uint32_t,uint32_allocator_type> old_hashes(table_size, 0, hashes_.get_allocator());
+            std::vector<uint32_t,uint32_allocator_type> old_positions(table_size, 0, positions_.get_allocator());
+            old_hashes.swap(hashes_);
+            old_positions.swap(positions_);
+            for (std::size_t i = 0; i < old_positions.size(); ++i)
+            {
+                if (old_positions[i] != 0)
+                {
+                    place(old_hashes[i], old_positions[i]);
+                }
+            }
+        }
+    };
+
+    template <class Allocator>
+    constexpr std::size_t hash_index<Allocator>::npos;
+
+}}
+
+#endif
@@ -0,0 +1,501 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_SIMD_SCAN_HPP
+#define JSONCONS_DETAIL_SIMD_SCAN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <jsoncons/config/jsoncons_config.hpp>
+
+#if defined(JSONCONS_HAS_AVX2) || defined(JSONCONS_HAS_SSE2)
+#  include <immintrin.h>
+#endif
+#if defined(JSONCONS_HAS_NEON)
+#  include <arm_neon.h>
+#endif
+#if defined(_MSC_VER)
+#  include <intrin.h>
+#endif
+
+namespace jsoncons {
+namespace detail {
+
+    inline
+    int count_trailing_zeros(uint64_t x)
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(x);
+    #elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanForward64(&index, x);
+        return static_cast<int>(index);
+    #else
+        int n = 0;
+        while ((x & 1) == 0)
+        {
+            x >>= 1;
+            ++n;
+        }
+        return n;
+    #endif
+    }
+
+    inline
+    int count_leading_zeros(uint32_t x)
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return __builtin_clz(x);
+    #elif defined(_MSC_VER)
+        unsigned long index;
+        _BitScanReverse(&index, x);
+        return 31 - static_cast<int>(index);
+    #else
+        int n = 0;
+        while ((x & 0x80000000u) == 0)
+        {
+            x <<= 1;
+            ++n;
+        }
+        return n;
+    #endif
+    }
+
+    inline
+    int popcount(uint32_t x)
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcount(x);
+    #else
+        int n = 0;
+        while (x != 0)
+        {
+            x &= x - 1;
+            ++n;
+        }
+        return n;
+    #endif
+    }
+
+#if defined(JSONCONS_HAS_NEON)
+    // Four bits per byte of the comparison result
+    inline
+    uint64_t neon_to_nibble_mask(uint8x16_t m)
+    {
+        return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0);
+    }
+#endif
+
+    // find_string_special
+
+    // Returns a pointer to the first character in [first,last) that cannot be part of an
+    // unescaped run inside a JSON string: '"', '\\', or a control character (< 0x20),
+    // or last if there is none.
+
+    template <class CharT>
+    const CharT* find_string_special(const CharT* first, const CharT* last)
+    {
+        using uchar_type = typename std::make_unsigned<CharT>::type;
+        while (first != last)
+        {
+            CharT c = *first;
+            if (c == '\"' || c == '\\' || static_cast<uchar_type>(c) < 0x20)
+            {
+                break;
+            }
+            ++first;
+        }
+        return first;
+    }
+
+    inline
+    const char* find_string_special(const char* first, const char* last)
+    {
+    #if defined(JSONCONS_HAS_AVX2)
+        {
+            const __m256i quote = _mm256_set1_epi8('\"');
+            const __m256i backslash = _mm256_set1_epi8('\\');
+            const __m256i ctrl_max = _mm256_set1_epi8(0x1f);
+            while (last - first >= 32)
+            {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+                __m256i m = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+                                            _mm256_cmpeq_epi8(_mm256_max_epu8(v, ctrl_max), ctrl_max));
+                uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(m));
+                if (mask != 0)
+                {
+                    return first + count_trailing_zeros(mask);
+                }
+                first += 32;
+            }
+        }
+    #endif
+    #if defined(JSONCONS_HAS_SSE2)
+        {
+            const __m128i quote = _mm_set1_epi8('\"');
+            const __m128i backslash = _mm_set1_epi8('\\');
+            const __m128i ctrl_max = _mm_set1_epi8(0x1f);
+            while (last - first >= 16)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+                __m128i m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                                         _mm_cmpeq_epi8(_mm_max_epu8(v, ctrl_max), ctrl_max));
+                uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(m));
+                if (mask != 0)
+                {
+                    return first + count_trailing_zeros(mask);
+                }
+                first += 16;
+            }
+        }
+    #elif defined(JSONCONS_HAS_NEON)
+        {
+            const uint8x16_t quote = vdupq_n_u8('\"');
+            const uint8x16_t backslash = vdupq_n_u8('\\');
+            const uint8x16_t ctrl_end = vdupq_n_u8(0x20);
+            while (last - first >= 16)
+            {
+                uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(first));
+                uint8x16_t m = vorrq_u8(vorrq_u8(vceqq_u8(v, quote), vceqq_u8(v, backslash)), vcltq_u8(v, ctrl_end));
+                uint64_t mask = neon_to_nibble_mask(m);
+                if (mask != 0)
+                {
+                    return first + (count_trailing_zeros(mask) >> 2);
+                }
+                first += 16;
+            }
+        }
+    #endif
+        return find_string_special<char>(first, last);
+    }
+
+    // find_escape_special
+
+    // Returns a pointer to the first character in [first,last) that the JSON encoder cannot
+    // copy to its output as is: '"', '\\', a control character (< 0x20 or 0x7f), '/' if
+    // escape_solidus is set, or a non-ASCII character if escape_all_non_ascii is set, or 
+    // last if there is none.
+
+    template <class CharT>
+    const CharT* find_escape_special(const CharT* first, const CharT* last, 
+                                     bool escape_all_non_ascii, bool escape_solidus)
+    {
+        using uchar_type = typename std::make_unsigned<CharT>::type;
+        while (first != last)
+        {
+            uchar_type c = static_cast<uchar_type>(*first);
+            if (c == '\"' || c == '\\' || c < 0x20 || c == 0x7f || (escape_solidus && c == '/') ||
+                (escape_all_non_ascii && c >= 0x80))
+            {
+                break;
+            }
+            ++first;
+        }
+        return first;
+    }
+
+    inline
+    const char* find_escape_special(const char* first, const char* last, 
+                                    bool escape_all_non_ascii, bool escape_solidus)
+    {
+        // When '/' is not escaped, compare with '"' twice instead
+        const char solidus = escape_solidus ? '/' : '\"';
+    #if defined(JSONCONS_HAS_AVX2)
+        {
+            const uint32_t non_ascii = escape_all_non_ascii ? 0xffffffffu : 0;
+            const __m256i quote = _mm256_set1_epi8('\"');
+            const __m256i backslash = _mm256_set1_epi8('\\');
+            const __m256i del = _mm256_set1_epi8(0x7f);
+            const __m256i slash = _mm256_set1_epi8(solidus);
+            const __m256i ctrl_max = _mm256_set1_epi8(0x1f);
+            while (last - first >= 32)
+            {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+                __m256i m = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+                                            _mm256_or_si256(_mm256_cmpeq_epi8(v, del), _mm256_cmpeq_epi8(v, slash)));
+                m = _mm256_or_si256(m, _mm256_cmpeq_epi8(_mm256_max_epu8(v, ctrl_max), ctrl_max));
+                uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(m)) | 
+                                (static_cast<uint32_t>(_mm256_movemask_epi8(v)) & non_ascii);
+                if (mask != 0)
+                {
+                    return first + count_trailing_zeros(mask);
+                }
+                first += 32;
+            }
+        }
+    #endif
+    #if defined(JSONCONS_HAS_SSE2)
+        {
+            const uint32_t non_ascii = escape_all_non_ascii ? 0xffffu : 0;
+            const __m128i quote = _mm_set1_epi8('\"');
+            const __m128i backslash = _mm_set1_epi8('\\');
+            const __m128i del = _mm_set1_epi8(0x7f);
+            const __m128i slash = _mm_set1_epi8(solidus);
+            const __m128i ctrl_max = _mm_set1_epi8(0x1f);
+            while (last - first >= 16)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+                __m128i m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                                         _mm_or_si128(_mm_cmpeq_epi8(v, del), _mm_cmpeq_epi8(v, slash)));
+                m = _mm_or_si128(m, _mm_cmpeq_epi8(_mm_max_epu8(v, ctrl_max), ctrl_max));
+                uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(m)) | 
+                                (static_cast<uint32_t>(_mm_movemask_epi8(v)) & non_ascii);
+                if (mask != 0)
+                {
+                    return first + count_trailing_zeros(mask);
+                }
+                first += 16;
+            }
+        }
+    #elif defined(JSONCONS_HAS_NEON)
+        {
+            // Bytes above high_max are 0x7f, or non-ASCII bytes that are to be escaped
+            const uint8x16_t high_max = vdupq_n_u8(escape_all_non_ascii ? 0x7e : 0xff);
+            const uint8x16_t quote = vdupq_n_u8('\"');
+            const uint8x16_t backslash = vdupq_n_u8('\\');
+            const uint8x16_t del = vdupq_n_u8(0x7f);
+            const uint8x16_t slash = vdupq_n_u8(static_cast<uint8_t>(solidus));
+            const uint8x16_t ctrl_end = vdupq_n_u8(0x20);
+            while (last - first >= 16)
+            {
+                uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(first));
+                uint8x16_t m = vorrq_u8(vorrq_u8(vceqq_u8(v, quote), vceqq_u8(v, backslash)),
+                                        vorrq_u8(vceqq_u8(v, del), vceqq_u8(v, slash)));
+                m = vorrq_u8(m, vorrq_u8(vcltq_u8(v, ctrl_end), vcgtq_u8(v, high_max)));
+                uint64_t mask = neon_to_nibble_mask(m);
+                if (mask != 0)
+                {
+                    return first + (count_trailing_zeros(mask) >> 2);
+                }
+                first += 16;
+            }
+        }
+    #endif
+        return find_escape_special<char>(first, last, escape_all_non_ascii, escape_solidus);
+    }
+
+    // skip_json_whitespace
+
+    // Returns a pointer to the first character in [first,last) that is not JSON whitespace.
+    // Adds the number of line breaks passed over to lines ("\r\n", "\n" and a lone "\r" each count
+    // as one), and if there were any, sets line_start to the character that follows the last one.
+    // A '\r' that is the last character in the range is not consumed, since it may be the first
+    // half of a "\r\n" pair that straddles two chunks of input.
+
+    template <class CharT>
+    const CharT* skip_json_whitespace(const CharT* first, const CharT* last,
+                                      std::size_t& lines, const CharT*& line_start)
+    {
+        while (first != last)
+        {
+            switch (*first)
+            {
+                case ' ':
+                case '\t':
+                    ++first;
+                    break;
+                case '\n':
+                    ++lines;
+                    line_start = ++first;
+                    break;
+                case '\r':
+                    if (first + 1 == last)
+                    {
+                        return first;
+                    }
+                    ++lines;
+                    ++first;
+                    if (*first == '\n')
+                    {
+                        ++first;
+                    }
+                    line_start = first;
+                    break;
+                default:
+                    return first;
+            }
+        }
+        return first;
+    }
+
+    // Given bit masks of the whitespace, '\n' and '\r' bytes in a block of block_size bytes, 
+    // returns the length of the leading whitespace run, and accounts for its line breaks.
+    // A run that covers the whole block but ends in '\r' stops short of it.
+    template <class CharT>
+    std::size_t whitespace_run_length(const CharT* block, uint32_t ws, uint32_t nl, uint32_t cr, 
+                                      std::size_t block_size,
+                                      std::size_t& lines, const CharT*& line_start)
+    {
+        const uint32_t block_mask = block_size == 32 ? 0xffffffffu : ((uint32_t(1) << block_size) - 1);
+        uint32_t not_ws = ~ws & block_mask;
+        std::size_t n = not_ws != 0 ? static_cast<std::size_t>(count_trailing_zeros(not_ws)) : block_size;
+        if (n == block_size && (cr >> (block_size-1)) != 0)
+        {
+            --n;
+        }
+        if (n == 0)
+        {
+            return 0;
+        }
+        uint32_t prefix = n == 32 ? 0xffffffffu : ((uint32_t(1) << n) - 1);
+        nl &= prefix;
+        cr &= prefix;
+        uint32_t breaks = nl | cr;
+        if (breaks != 0)
+        {
+            uint32_t lone_cr = cr & ~(nl >> 1);
+            lines += static_cast<std::size_t>(popcount(nl) + popcount(lone_cr));
+            line_start = block + (32 - count_leading_zeros(breaks));
+        }
+        return n;
+    }
+
+    inline
+    const char* skip_json_whitespace(const char* first, const char* last,
+                                     std::size_t& lines, const char*& line_start)
+    {
+    #if defined(JSONCONS_HAS_AVX2)
+        {
+            const __m256i space = _mm256_set1_epi8(' ');
+            const __m256i tab = _mm256_set1_epi8('\t');
+            const __m256i lf = _mm256_set1_epi8('\n');
+            const __m256i cr = _mm256_set1_epi8('\r');
+            while (last - first >= 32)
+            {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+                __m256i is_lf = _mm256_cmpeq_epi8(v, lf);
+                __m256i is_cr = _mm256_cmpeq_epi8(v, cr);
+                __m256i is_ws = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, space), _mm256_cmpeq_epi8(v, tab)),
+                                                _mm256_or_si256(is_lf, is_cr));
+                std::size_t n = whitespace_run_length(first, 
+                                                      static_cast<uint32_t>(_mm256_movemask_epi8(is_ws)),
+                                                      static_cast<uint32_t>(_mm256_movemask_epi8(is_lf)),
+                                                      static_cast<uint32_t>(_mm256_movemask_epi8(is_cr)),
+                                                      32, lines, line_start);
+                first += n;
+                if (n != 32)
+                {
+                    return skip_json_whitespace<char>(first, last, lines, line_start);
+                }
+            }
+        }
+    #endif
+    #if defined(JSONCONS_HAS_SSE2)
+        {
+            const __m128i space = _mm_set1_epi8(' ');
+            const __m128i tab = _mm_set1_epi8('\t');
+            const __m128i lf = _mm_set1_epi8('\n');
+            const __m128i cr = _mm_set1_epi8('\r');
+            while (last - first >= 16)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+                __m128i is_lf = _mm_cmpeq_epi8(v, lf);
+                __m128i is_cr = _mm_cmpeq_epi8(v, cr);
+                __m128i is_ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab)),
+                                             _mm_or_si128(is_lf, is_cr));
+                std::size_t n = whitespace_run_length(first, 
+                                                      static_cast<uint32_t>(_mm_movemask_epi8(is_ws)),
+                                                      static_cast<uint32_t>(_mm_movemask_epi8(is_lf)),
+                                                      static_cast<uint32_t>(_mm_movemask_epi8(is_cr)),
+                                                      16, lines, line_start);
+                first += n;
+                if (n != 16)
+                {
+                    return skip_json_whitespace<char>(first, last, lines, line_start);
+                }
+            }
+        }
+    #elif defined(JSONCONS_HAS_NEON)
+        {
+            // NEON has no movemask, so fall back to the scalar loop for blocks with line breaks
+            const uint8x16_t space = vdupq_n_u8(' ');
+            const uint8x16_t tab = vdupq_n_u8('\t');
+            const uint8x16_t lf = vdupq_n_u8('\n');
+            const uint8x16_t cr = vdupq_n_u8('\r');
+            while (last - first >= 16)
+            {
+                uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(first));
+                uint8x16_t is_break = vorrq_u8(vceqq_u8(v, lf), vceqq_u8(v, cr));
+                uint8x16_t is_ws = vorrq_u8(vorrq_u8(vceqq_u8(v, space), vceqq_u8(v, tab)), is_break);
+                uint64_t not_ws = ~neon_to_nibble_mask(is_ws);
+                std::size_t n = not_ws != 0 ? static_cast<std::size_t>(count_trailing_zeros(not_ws) >> 2) : 16;
+                if (neon_to_nibble_mask(is_break) != 0)
+                {
+                    const char* end = first + n;
+                    first = skip_json_whitespace<char>(first, end, lines, line_start);
+                    if (first != end)
+                    {
+                        return first;
+                    }
+                }
+                else
+                {
+                    first += n;
+                }
+                if (n != 16)
+                {
+                    return first;
+                }
+            }
+        }
+    #endif
+        return skip_json_whitespace<char>(first, last, lines, line_start);
+    }
+
+    // count_line_breaks
+
+    // Adds the number of line breaks in [first,last) to lines, counted as in skip_json_whitespace,
+    // and if there were any, sets line_start to the character that follows the last one.
+
+    template <class CharT>
+    void count_line_breaks(const CharT* first, const CharT* last,
+                           std::size_t& lines, const CharT*& line_start)
+    {
+        for (; first != last; ++first)
+        {
+            if (*first == '\n' || (*first == '\r' && (first + 1 == last || *(first + 1) != '\n')))
+            {
+                ++lines;
+                line_start = first + 1;
+            }
+        }
+    }
+
+    inline
+    void count_line_breaks(const char* first, const char* last,
+                           std::size_t& lines, const char*& line_start)
+    {
+    #if defined(JSONCONS_HAS_SSE2)
+        const __m128i lf = _mm_set1_epi8('\n');
+        const __m128i cr = _mm_set1_epi8('\r');
+        while (last - first >= 16)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+            uint32_t nl = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, lf)));
+            uint32_t crs = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, cr)));
+            // A '\r' only counts when it is not the first half of a "\r\n" pair
+            uint32_t lone_cr = crs & ~(nl >> 1);
+            if ((lone_cr & 0x8000u) != 0 && last - first > 16 && *(first + 16) == '\n')
+            {
+                lone_cr &= 0x7fffu;
+            }
+            uint32_t breaks = nl | lone_cr;
+            if (breaks != 0)
+            {
+                lines += static_cast<std::size_t>(popcount(nl) + popcount(lone_cr));
+                line_start = first + (32 - count_leading_zeros(breaks));
+            }
+            first += 16;
+        }
+    #endif
+        count_line_breaks<char>(first, last, lines, line_start);
+    }
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,284 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_STRUCTURAL_INDEX_HPP
+#define JSONCONS_DETAIL_STRUCTURAL_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits> // std::numeric_limits
+#include <type_traits>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/simd_scan.hpp>
+
+namespace jsoncons {
+namespace detail {
+
+    // One bit per character of a 64 character block
+    struct structural_block
+    {
+        uint64_t backslash;
+        uint64_t quote;
+        uint64_t op;          // { } [ ] : ,
+        uint64_t whitespace;
+        uint64_t control;     // < 0x20
+        uint64_t slash;
+    };
+
+    template <class CharT>
+    void classify_block(const CharT* p, structural_block& block)
+    {
+        using uchar_type = typename std::make_unsigned<CharT>::type;
+
+        block = structural_block{0,0,0,0,0,0};
+        for (std::size_t i = 0; i < 64; ++i)
+        {
+            const uint64_t bit = uint64_t(1) << i;
+            switch (p[i])
+            {
+                case '\\':
+                    block.backslash |= bit;
+                    break;
+                case '\"':
+                    block.quote |= bit;
+                    break;
+                case '{': case '}': case '[': case ']': case ':': case ',':
+                    block.op |= bit;
+                    break;
+                case ' ': case '\t': case '\n': case '\r':
+                    block.whitespace |= bit;
+                    break;
+                case '/':
+                    block.slash |= bit;
+                    break;
+                default:
+                    break;
+            }
+            if (static_cast<uchar_type>(p[i]) < 0x20)
+            {
+                block.control |= bit;
+            }
+        }
+    }
+
+#if defined(JSONCONS_HAS_AVX2)
+    inline
+    void classify_block(const char* p, structural_block& block)
+    {
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i quote = _mm256_set1_epi8('\"');
+        const __m256i lbrace = _mm256_set1_epi8('{');
+        const __m256i rbrace = _mm256_set1_epi8('}');
+        const __m256i lbracket = _mm256_set1_epi8('[');
+        const __m256i rbracket = _mm256_set1_epi8(']');
+        const __m256i colon = _mm256_set1_epi8(':');
+        const __m256i comma = _mm256_set1_epi8(',');
+        const __m256i space = _mm256_set1_epi8(' ');
+        const __m256i tab = _mm256_set1_epi8('\t');
+        const __m256i lf = _mm256_set1_epi8('\n');
+        const __m256i cr = _mm256_set1_epi8('\r');
+        const __m256i slash = _mm256_set1_epi8('/');
+        const __m256i ctrl_max = _mm256_set1_epi8(0x1f);
+
+        block = structural_block{0,0,0,0,0,0};
+        for (std::size_t i = 0; i < 64; i += 32)
+        {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+            __m256i op = _mm256_or_si256(_mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, lbrace), _mm256_cmpeq_epi8(v, rbrace)),
+                                                         _mm256_or_si256(_mm256_cmpeq_epi8(v, lbracket), _mm256_cmpeq_epi8(v, rbracket))),
+                                         _mm256_or_si256(_mm256_cmpeq_epi8(v, colon), _mm256_cmpeq_epi8(v, comma)));
+            __m256i ws = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, space), _mm256_cmpeq_epi8(v, tab)),
+                                         _mm256_or_si256(_mm256_cmpeq_epi8(v, lf), _mm256_cmpeq_epi8(v, cr)));
+            block.backslash |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, backslash)))) << i;
+            block.quote |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, quote)))) << i;
+            block.op |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(op))) << i;
+            block.whitespace |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(ws))) << i;
+            block.control |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(v, ctrl_max), ctrl_max)))) << i;
+            block.slash |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, slash)))) << i;
+        }
+    }
+#elif defined(JSONCONS_HAS_SSE2)
+    inline
+    void classify_block(const char* p, structural_block& block)
+    {
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i quote = _mm_set1_epi8('\"');
+        const __m128i lbrace = _mm_set1_epi8('{');
+        const __m128i rbrace = _mm_set1_epi8('}');
+        const __m128i lbracket = _mm_set1_epi8('[');
+        const __m128i rbracket = _mm_set1_epi8(']');
+        const __m128i colon = _mm_set1_epi8(':');
+        const __m128i comma = _mm_set1_epi8(',');
+        const __m128i space = _mm_set1_epi8(' ');
+        const __m128i tab = _mm_set1_epi8('\t');
+        const __m128i lf = _mm_set1_epi8('\n');
+        const __m128i cr = _mm_set1_epi8('\r');
+        const __m128i slash = _mm_set1_epi8('/');
+        const __m128i ctrl_max = _mm_set1_epi8(0x1f);
+
+        block = structural_block{0,0,0,0,0,0};
+        for (std::size_t i = 0; i < 64; i += 16)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+            __m128i op = _mm_or_si128(_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, lbrace), _mm_cmpeq_epi8(v, rbrace)),
+                                                   _mm_or_si128(_mm_cmpeq_epi8(v, lbracket), _mm_cmpeq_epi8(v, rbracket))),
+                                      _mm_or_si128(_mm_cmpeq_epi8(v, colon), _mm_cmpeq_epi8(v, comma)));
+            __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab)),
+                                      _mm_or_si128(_mm_cmpeq_epi8(v, lf), _mm_cmpeq_epi8(v, cr)));
+            block.backslash |= uint64_t(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, backslash)))) << i;
+            block.quote |= uint64_t(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, quote)))) << i;
+            block.op |= uint64_t(static_cast<uint32_t>(_mm_movemask_epi8(op))) << i;
+            block.whitespace |= uint64_t(static_cast<uint32_t>(_mm_movemask_epi8(ws))) << i;
+            block.control |= uint64_t(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(v, ctrl_max), ctrl_max)))) << i;
+            block.slash |= uint64_t(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, slash)))) << i;
+        }
+    }
+#elif defined(JSONCONS_HAS_NEON)
+    inline
+    uint64_t neon_movemask(uint8x16_t m)
+    {
+        static const uint8_t weights[16] = {1,2,4,8,16,32,64,128,1,2,4,8,16,32,64,128};
+        uint8x16_t t = vandq_u8(m, vld1q_u8(weights));
+        t = vpaddq_u8(t, t);
+        t = vpaddq_u8(t, t);
+        t = vpaddq_u8(t, t);
+        return vgetq_lane_u16(vreinterpretq_u16_u8(t), 0);
+    }
+
+    inline
+    void classify_block(const char* p, structural_block& block)
+    {
+        block = structural_block{0,0,0,0,0,0};
+        for (std::size_t i = 0; i < 64; i += 16)
+        {
+            uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(p + i));
+            uint8x16_t op = vorrq_u8(vorrq_u8(vorrq_u8(vceqq_u8(v, vdupq_n_u8('{')), vceqq_u8(v, vdupq_n_u8('}'))),
+                                              vorrq_u8(vceqq_u8(v, vdupq_n_u8('[')), vceqq_u8(v, vdupq_n_u8(']')))),
+                                     vorrq_u8(vceqq_u8(v, vdupq_n_u8(':')), vceqq_u8(v, vdupq_n_u8(','))));
+            uint8x16_t ws = vorrq_u8(vorrq_u8(vceqq_u8(v, vdupq_n_u8(' ')), vceqq_u8(v, vdupq_n_u8('\t'))),
+                                     vorrq_u8(vceqq_u8(v, vdupq_n_u8('\n')), vceqq_u8(v, vdupq_n_u8('\r'))));
+            block.backslash |= neon_movemask(vceqq_u8(v, vdupq_n_u8('\\'))) << i;
+            block.quote |= neon_movemask(vceqq_u8(v, vdupq_n_u8('\"'))) << i;
+            block.op |= neon_movemask(op) << i;
+            block.whitespace |= neon_movemask(ws) << i;
+            block.control |= neon_movemask(vcltq_u8(v, vdupq_n_u8(0x20))) << i;
+            block.slash |= neon_movemask(vceqq_u8(v, vdupq_n_u8('/'))) << i;
+        }
+    }
+#endif
+
+    // Each bit is set if the character is preceded by an odd number of backslashes
+    inline
+    uint64_t find_escaped(uint64_t backslash, uint64_t& prev_escaped)
+    {
+        uint64_t escaped = prev_escaped;
+        prev_escaped = 0;
+        backslash &= ~escaped;
+        while (backslash != 0)
+        {
+            int i = count_trailing_zeros(backslash);
+            if (i == 63)
+            {
+                prev_escaped = 1;
+                break;
+            }
+            escaped |= uint64_t(1) << (i + 1);
+            backslash &= ~(uint64_t(3) << i);
+        }
+        return escaped;
+    }
+
+    // Each bit is set if an odd number of bits at or below it are set
+    inline
+    uint64_t prefix_xor(uint64_t x)
+    {
+        x ^= x << 1;
+        x ^= x << 2;
+        x ^= x << 4;
+        x ^= x << 8;
+        x ^= x << 16;
+        x ^= x << 32;
+        return x;
+    }
+
+    template <class Vector>
+    void append_positions(uint64_t bits, std::size_t offset, Vector& positions)
+    {
+        using value_type = typename Vector::value_type;
+        while (bits != 0)
+        {
+            positions.push_back(static_cast<value_type>(offset + count_trailing_zeros(bits)));
+            bits &= bits - 1;
+        }
+    }
+
+    // build_structural_index
+
+    // Stage one of the two stage parse. Records the offsets of the tokens in [data,data+length):
+    // structural characters outside strings, opening and closing quotes, and the first character
+    // of each run of other characters outside strings (numbers, literals, and anything invalid).
+    // Everything between two consecutive offsets is whitespace or string content. Also records
+    // the offsets of backslashes and control characters inside strings, which need the slow path.
+    // Returns false if the index cannot be used: the input is too long for 32 bit offsets, or it
+    // has a '/' outside of a string, as the contents of a comment would be misclassified.
+
+    template <class CharT,class Vector>
+    bool build_structural_index(const CharT* data, std::size_t length,
+                                Vector& structurals, Vector& string_specials)
+    {
+        structurals.clear();
+        string_specials.clear();
+        if (length > (std::numeric_limits<uint32_t>::max)())
+        {
+            return false;
+        }
+
+        uint64_t prev_escaped = 0;
+        uint64_t prev_in_string = 0;
+        uint64_t prev_scalar = 0;
+
+        structural_block block;
+        CharT padded[64];
+        for (std::size_t offset = 0; offset < length; offset += 64)
+        {
+            if (length - offset >= 64)
+            {
+                classify_block(data + offset, block);
+            }
+            else
+            {
+                std::size_t n = length - offset;
+                for (std::size_t i = 0; i < 64; ++i)
+                {
+                    padded[i] = i < n ? data[offset+i] : CharT(' ');
+                }
+                classify_block(static_cast<const CharT*>(padded), block);
+            }
+
+            uint64_t escaped = find_escaped(block.backslash, prev_escaped);
+            uint64_t quote = block.quote & ~escaped;
+            uint64_t in_string = prefix_xor(quote) ^ prev_in_string;
+            prev_in_string = uint64_t(0) - (in_string >> 63);
+
+            if ((block.slash & ~in_string) != 0)
+            {
+                return false;
+            }
+
+            uint64_t scalar = ~(block.op | block.whitespace | quote | in_string);
+            uint64_t scalar_start = scalar & ~((scalar << 1) | prev_scalar);
+            prev_scalar = scalar >> 63;
+
+            append_positions((block.op & ~in_string) | quote | scalar_start, offset, structurals);
+            append_positions((block.backslash | block.control) & in_string, offset, string_specials);
+        }
+        return true;
+    }
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
@@ -8,14 +8,17 @@
 #define JSONCONS_DETAIL_WRITE_NUMBER_HPP
 
 #include <stdexcept>
+#include <algorithm> // std::min
 #include <string>
+#include <vector>
 #include <cmath>
 #include <locale>
 #include <limits> // std::numeric_limits
 #include <exception>
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons/json_options.hpp>
-#include <jsoncons/detail/grisu3.hpp>
+#include <jsoncons/sink.hpp>
+#include <jsoncons/detail/ryu.hpp>
 #include <jsoncons/detail/parse_number.hpp>
 
 namespace jsoncons { 
@@ -29,48 +32,108 @@ namespace detail {
 
     // write_integer
 
+    // The two digit pairs "00" through "99"
+    static constexpr char radix_100_digits[] =
+        "0001020304050607080910111213141516171819"
+        "2021222324252627282930313233343536373839"
+        "4041424344454647484950515253545556575859"
+        "6061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+    template<class Uint>
+    std::size_t count_digits(Uint value)
+    {
+        std::size_t n = 1;
+        for (;;)
+        {
+            if (value < 10) return n;
+            if (value < 100) return n + 1;
+            if (value < 1000) return n + 2;
+            if (value < 10000) return n + 3;
+            value /= 10000u;
+            n += 4;
+        }
+    }
+
+    // unchecked_chars
+
+    // A Result for the number formatting functions below that writes to space already
+    // known to be large enough
+
+    template <class CharT>
+    class unchecked_chars
+    {
+    public:
+        using value_type = CharT;
+    private:
+        CharT* begin_;
+        CharT* p_;
+    public:
+        explicit unchecked_chars(CharT* p)
+            : begin_(p), p_(p)
+        {
+        }
+
+        void push_back(CharT ch)
+        {
+            *p_++ = ch;
+        }
+
+        CharT* reserve(std::size_t)
+        {
+            return p_;
+        }
+
+        void commit(std::size_t n)
+        {
+            p_ += n;
+        }
+
+        std::size_t size() const
+        {
+            return static_cast<std::size_t>(p_ - begin_);
+        }
+    };
+
     template<class Integer,class Result>
     typename std::enable_if<std::is_integral<Integer>::value,std::size_t>::type
     write_integer(Integer value, Result& result)
     {
         using char_type = typename Result::value_type;
+        using unsigned_type = typename std::make_unsigned<Integer>::type;
 
-        char_type buf[255];
-        char_type *p = buf;
-        const char_type* last = buf+255;
+        const bool is_negative = value < 0;
+        unsigned_type u = is_negative ? static_cast<unsigned_type>(unsigned_type(0) - static_cast<unsigned_type>(value)) 
+                                      : static_cast<unsigned_type>(value);
+        const std::size_t count = count_digits(u) + (is_negative ? 1 : 0);
 
-        bool is_negative = value < 0;
+        sink_window<Result,std::numeric_limits<unsigned_type>::digits10 + 3> window(result, count);
 
-        if (value < 0)
+        // Fill from the back, two digits at a time
+        char_type* p = window.data() + count;
+        while (u >= 100)
         {
-            do
-            {
-                *p++ = static_cast<char_type>(48 - (value % 10));
-            }
-            while ((value /= 10) && (p < last));
+            const std::size_t i = static_cast<std::size_t>(u % 100) * 2;
+            u /= 100;
+            *--p = static_cast<char_type>(radix_100_digits[i+1]);
+            *--p = static_cast<char_type>(radix_100_digits[i]);
         }
-        else
+        if (u >= 10)
         {
-
-            do
-            {
-                *p++ = static_cast<char_type>(48 + value % 10);
-            }
-            while ((value /= 10) && (p < last));
+            const std::size_t i = static_cast<std::size_t>(u) * 2;
+            *--p = static_cast<char_type>(radix_100_digits[i+1]);
+            *--p = static_cast<char_type>(radix_100_digits[i]);
         }
-        JSONCONS_ASSERT(p != last);
-
-        std::size_t count = (p - buf);
-        if (is_negative)
+        else
         {
-            result.push_back('-');
-            ++count;
+            *--p = static_cast<char_type>('0' + u);
         }
-        while (--p >= buf)
+        if (is_negative)
         {
-            result.push_back(*p);
+            *--p = '-';
         }
 
+        window.commit(count);
         return count;
     }
 
@@ -282,7 +345,7 @@ namespace detail {
     }
 
     template<class Result>
-    bool dtoa_scientific(double val, char decimal_point, Result& result)
+    bool dtoa_scientific(double val, char decimal_point, Result& result, std::false_type)
     {
         if (val == 0)
         {
@@ -314,6 +377,42 @@ namespace detail {
         return true;
     }
 
+    template<class Result>
+    bool dtoa_scientific(double v, char, Result& result, std::true_type)
+    {
+        if (v == 0)
+        {
+            result.push_back('0');
+            result.push_back('.');
+            result.push_back('0');
+            return true;
+        }
+
+        int length = 0;
+        int k;
+
+        char buffer[100];
+
+        double u = std::signbit(v) ? -v : v;
+        jsoncons::detail::ryu_to_shortest(u, buffer, &length, &k);
+        if (std::signbit(v))
+        {
+            result.push_back('-');
+        }
+        result.push_back(buffer[0]);
+        if (length > 1)
+        {
+            result.push_back('.');
+            for (int i = 1; i < length; ++i)
+            {
+                result.push_back(buffer[i]);
+            }
+        }
+        result.push_back('e');
+        fill_exponent(k + length - 1, result);
+        return true;
+    }
+
     template<class Result>
     bool dtoa_general(double val, char decimal_point, Result& result, std::false_type)
     {
@@ -348,7 +447,7 @@ namespace detail {
     }
 
     template<class Result>
-    bool dtoa_general(double v, char decimal_point, Result& result, std::true_type)
+    bool dtoa_general(double v, char, Result& result, std::true_type)
     {
         if (v == 0)
         {
@@ -364,21 +463,15 @@ namespace detail {
         char buffer[100];
 
         double u = std::signbit(v) ? -v : v;
-        if (jsoncons::detail::grisu3(u, buffer, &length, &k))
-        {
-            if (std::signbit(v))
-            {
-                result.push_back('-');
-            }
-            // min exp: -4 is consistent with sprintf
-            // max exp: std::numeric_limits<double>::max_digits10
-            jsoncons::detail::prettify_string(buffer, length, k, -4, std::numeric_limits<double>::max_digits10, result);
-            return true;
-        }
-        else
+        jsoncons::detail::ryu_to_shortest(u, buffer, &length, &k);
+        if (std::signbit(v))
         {
-            return dtoa_general(v, decimal_point, result, std::false_type());
+            result.push_back('-');
         }
+        // min exp: -4 is consistent with sprintf
+        // max exp: std::numeric_limits<double>::max_digits10
+        jsoncons::detail::prettify_string(buffer, length, k, -4, std::numeric_limits<double>::max_digits10, result);
+        return true;
     }
 
     template<class Result>
@@ -415,7 +508,7 @@ namespace detail {
     }
 
     template<class Result>
-    bool dtoa_fixed(double v, char decimal_point, Result& result, std::true_type)
+    bool dtoa_fixed(double v, char, Result& result, std::true_type)
     {
         if (v == 0)
         {
@@ -431,19 +524,13 @@ namespace detail {
         char buffer[100];
 
         double u = std::signbit(v) ? -v : v;
-        if (jsoncons::detail::grisu3(u, buffer, &length, &k))
+        jsoncons::detail::ryu_to_shortest(u, buffer, &length, &k);
+        if (std::signbit(v))
         {
-            if (std::signbit(v))
-            {
-                result.push_back('-');
-            }
-            jsoncons::detail::prettify_string(buffer, length, k, std::numeric_limits<int>::lowest(), (std::numeric_limits<int>::max)(), result);
-            return true;
-        }
-        else
-        {
-            return dtoa_fixed(v, decimal_point, result, std::false_type());
+            result.push_back('-');
         }
+        jsoncons::detail::prettify_string(buffer, length, k, std::numeric_limits<int>::lowest(), (std::numeric_limits<int>::max)(), result);
+        return true;
     }
 
     template<class Result>
@@ -458,9 +545,22 @@ namespace detail {
         return dtoa_general(v, decimal_point, result, std::integral_constant<bool, std::numeric_limits<double>::is_iec559>());
     }
 
+    template<class Result>
+    bool dtoa_scientific(double v, char decimal_point, Result& result)
+    {
+        return dtoa_scientific(v, decimal_point, result, std::integral_constant<bool, std::numeric_limits<double>::is_iec559>());
+    }
+
     class write_double
     {
     private:
+        // The longest shortest representation in general or scientific notation, 
+        // like -2.2250738585072014e-308
+        static constexpr std::size_t max_shortest_length = 32;
+        // The longest shortest representation in fixed notation, like -5e-324 written out
+        // as -0.000...05, or snprintf output that fits in its 200 character buffer, plus ".0"
+        static constexpr std::size_t max_fixed_length = 350;
+
         to_double_t to_double_;
         float_chars_format float_format_;
         int precision_;
@@ -484,10 +584,7 @@ namespace detail {
         template<class Result>
         std::size_t operator()(double val, Result& result)
         {
-            std::size_t count = 0;
-
-            char number_buffer[200];
-            int length = 0;
+            using char_type = typename Result::value_type;
 
             switch (float_format_)
             {
@@ -495,19 +592,12 @@ namespace detail {
                 {
                     if (precision_ > 0)
                     {
-                        length = snprintf(number_buffer, sizeof(number_buffer), "%1.*f", precision_, val);
-                        if (length < 0)
-                        {
-                            JSONCONS_THROW(json_runtime_error<std::invalid_argument>("write_double failed."));
-                        }
-                        dump_buffer(number_buffer, length, decimal_point_, result);
+                        return write_formatted("%1.*f", val, result);
                     }
                     else
                     {
-                        if (!dtoa_fixed(val, decimal_point_, result))
-                        {
-                            JSONCONS_THROW(json_runtime_error<std::invalid_argument>("write_double failed."));
-                        }
+                        return write_chars<max_fixed_length>(result, max_fixed_length, 
+                            [&](unchecked_chars<char_type>& chars) {return dtoa_fixed(val, decimal_point_, chars);});
                     }
                 }
                 break;
@@ -515,19 +605,12 @@ namespace detail {
                 {
                     if (precision_ > 0)
                     {
-                        length = snprintf(number_buffer, sizeof(number_buffer), "%1.*e", precision_, val);
-                        if (length < 0)
-                        {
-                            JSONCONS_THROW(json_runtime_error<std::invalid_argument>("write_double failed."));
-                        }
-                        dump_buffer(number_buffer, length, decimal_point_, result);
+                        return write_formatted("%1.*e", val, result);
                     }
                     else
                     {
-                        if (!dtoa_scientific(val, decimal_point_, result))
-                        {
-                            JSONCONS_THROW(json_runtime_error<std::invalid_argument>("write_double failed."));
-                        }
+                        return write_chars<max_shortest_length>(result, max_shortest_length, 
+                            [&](unchecked_chars<char_type>& chars) {return dtoa_scientific(val, decimal_point_, chars);});
                     }
                 }
                 break;
@@ -535,19 +618,12 @@ namespace detail {
                 {
                     if (precision_ > 0)
                     {
-                        length = snprintf(number_buffer, sizeof(number_buffer), "%1.*g", precision_, val);
-                        if (length < 0)
-                        {
-                            JSONCONS_THROW(json_runtime_error<std::invalid_argument>("write_double failed."));
-                        }
-                        dump_buffer(number_buffer, length, decimal_point_, result);
+                        return write_formatted("%1.*g", val, result);
                     }
                     else
                     {
-                        if (!dtoa_general(val, decimal_point_, result))
-                        {
-                            JSONCONS_THROW(json_runtime_error<std::invalid_argument>("write_double failed."));
-                        }
+                        return write_chars<max_shortest_length>(result, max_shortest_length, 
+                            [&](unchecked_chars<char_type>& chars) {return dtoa_general(val, decimal_point_, chars);});
                     }             
                     break;
                 }
@@ -555,7 +631,47 @@ namespace detail {
                     JSONCONS_THROW(json_runtime_error<std::invalid_argument>("write_double failed."));
                     break;
             }
-            return count;
+        }
+    private:
+        // Formats into a window of the result of at most N characters, with one bounds check
+        template <std::size_t N,class Result,class Format>
+        static std::size_t write_chars(Result& result, std::size_t capacity, Format format)
+        {
+            sink_window<Result,N> window(result, capacity);
+            unchecked_chars<typename Result::value_type> chars(window.data());
+            bool ok = format(chars);
+            window.commit(chars.size());
+            if (!ok)
+            {
+                JSONCONS_THROW(json_runtime_error<std::invalid_argument>("write_double failed."));
+            }
+            return chars.size();
+        }
+
+        // Writes val formatted by snprintf with the given precision
+        template <class Result>
+        std::size_t write_formatted(const char* format, double val, Result& result) const
+        {
+            char number_buffer[200];
+            int length = snprintf(number_buffer, sizeof(number_buffer), format, precision_, val);
+            if (length < 0)
+            {
+                JSONCONS_THROW(json_runtime_error<std::invalid_argument>("write_double failed."));
+            }
+            std::size_t n = static_cast<std::size_t>(length);
+            if (n < sizeof(number_buffer))
+            {
+                return write_chars<max_fixed_length>(result, n + 2, 
+                    [&](unchecked_chars<typename Result::value_type>& chars) -> bool {dump_buffer(number_buffer, n, decimal_point_, chars); return true;});
+            }
+
+            // Large numbers in fixed notation with many decimal places
+            std::vector<char> buffer(n + 1);
+            snprintf(buffer.data(), buffer.size(), format, precision_, val);
+            std::basic_string<typename Result::value_type> chars;
+            dump_buffer(buffer.data(), n, decimal_point_, chars);
+            result.append(chars.data(), chars.size());
+            return chars.size();
         }
     };
 
@@ -0,0 +1,461 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_FD_SINK_HPP
+#define JSONCONS_FD_SINK_HPP
+
+#include <algorithm> // std::min
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <cerrno>
+#include <memory> // std::unique_ptr
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <utility> // std::swap
+#include <vector>
+#include <jsoncons/config/jsoncons_config.hpp>
+
+#if !defined(_WIN32)
+#  include <fcntl.h>
+#  include <sys/uio.h>
+#  include <unistd.h>
+#  include <limits.h> // IOV_MAX
+
+namespace jsoncons {
+
+    // fd_sink_options
+
+    class fd_sink_options
+    {
+        std::size_t buffer_length_;
+        std::size_t writev_threshold_;
+        bool background_flush_;
+    public:
+        static constexpr std::size_t default_buffer_length = 1048576;
+        static constexpr std::size_t default_writev_threshold = 65536;
+
+        fd_sink_options()
+            : buffer_length_(default_buffer_length),
+              writev_threshold_(default_writev_threshold),
+              background_flush_(false)
+        {
+        }
+
+        std::size_t buffer_length() const
+        {
+            return buffer_length_;
+        }
+
+        fd_sink_options& buffer_length(std::size_t value)
+        {
+            buffer_length_ = value > 0 ? value : 1;
+            return *this;
+        }
+
+        std::size_t writev_threshold() const
+        {
+            return writev_threshold_;
+        }
+
+        fd_sink_options& writev_threshold(std::size_t value)
+        {
+            writev_threshold_ = value;
+            return *this;
+        }
+
+        bool background_flush() const
+        {
+            return background_flush_;
+        }
+
+        fd_sink_options& background_flush(bool value)
+        {
+            background_flush_ = value;
+            return *this;
+        }
+    };
+
+namespace detail {
+
+    // Writes all of the byte ranges in iov, retrying after partial writes and interrupts.
+    // Returns 0, or the errno of the failed call.
+    inline
+    int write_fully(int fd, struct iovec* iov, int count)
+    {
+        while (count > 0)
+        {
+            ssize_t n = ::writev(fd, iov, count < IOV_MAX ? count : IOV_MAX);
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return errno;
+            }
+            std::size_t written = static_cast<std::size_t>(n);
+            while (count > 0 && written >= iov->iov_len)
+            {
+                written -= iov->iov_len;
+                ++iov;
+                --count;
+            }
+            if (count > 0)
+            {
+                iov->iov_base = static_cast<char*>(iov->iov_base) + written;
+                iov->iov_len -= written;
+            }
+        }
+        return 0;
+    }
+
+    inline
+    int write_fully(int fd, const void* data, std::size_t length)
+    {
+        struct iovec iov;
+        iov.iov_base = const_cast<void*>(data);
+        iov.iov_len = length;
+        return length > 0 ? write_fully(fd, &iov, 1) : 0;
+    }
+
+    // The state of an fd_sink, kept on the heap so that the sink can be moved while
+    // a background flusher thread refers to it
+
+    class fd_sink_state
+    {
+        int fd_;
+        bool owns_fd_;
+        int error_;
+
+        bool background_flush_;
+        std::vector<uint8_t> pending_;
+        std::size_t pending_length_;
+        bool has_pending_;
+        bool stopping_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::thread flusher_;
+
+        // Noncopyable
+        fd_sink_state(const fd_sink_state&) = delete;
+        fd_sink_state& operator=(const fd_sink_state&) = delete;
+    public:
+        fd_sink_state(int fd, bool owns_fd, int error, bool background_flush)
+            : fd_(fd), owns_fd_(owns_fd), error_(error), background_flush_(background_flush && error == 0),
+              pending_length_(0), has_pending_(false), stopping_(false)
+        {
+            if (background_flush_)
+            {
+                flusher_ = std::thread([this](){run();});
+            }
+        }
+
+        ~fd_sink_state() noexcept
+        {
+            if (background_flush_)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    stopping_ = true;
+                }
+                cv_.notify_all();
+                flusher_.join();
+            }
+            if (owns_fd_ && fd_ >= 0)
+            {
+                ::close(fd_);
+            }
+        }
+
+        bool is_error()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return error_ != 0;
+        }
+
+        int error_number()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return error_;
+        }
+
+        // Writes length bytes of buffer, and with a background flusher, swaps buffer
+        // with an empty one of the same size that is ready to be filled
+        void write_buffer(std::vector<uint8_t>& buffer, std::size_t length)
+        {
+            if (!background_flush_)
+            {
+                write(buffer.data(), length, nullptr, 0);
+                return;
+            }
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this](){return !has_pending_;});
+            if (pending_.size() != buffer.size())
+            {
+                pending_.resize(buffer.size());
+            }
+            pending_.swap(buffer);
+            pending_length_ = length;
+            has_pending_ = true;
+            lock.unlock();
+            cv_.notify_all();
+        }
+
+        // Writes length bytes of buffer followed by size bytes of data,
+        // after any buffer that the flusher is writing
+        void write(const uint8_t* buffer, std::size_t length, const uint8_t* data, std::size_t size)
+        {
+            if (background_flush_)
+            {
+                wait();
+            }
+            struct iovec iov[2];
+            int count = 0;
+            if (length > 0)
+            {
+                iov[count].iov_base = const_cast<uint8_t*>(buffer);
+                iov[count].iov_len = length;
+                ++count;
+            }
+            if (size > 0)
+            {
+                iov[count].iov_base = const_cast<uint8_t*>(data);
+                iov[count].iov_len = size;
+                ++count;
+            }
+            if (count > 0 && !is_error())
+            {
+                int ec = write_fully(fd_, iov, count);
+                if (ec != 0)
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    error_ = ec;
+                }
+            }
+        }
+
+        // Waits until the flusher has written the buffer it was given
+        void wait()
+        {
+            if (background_flush_)
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this](){return !has_pending_;});
+            }
+        }
+    private:
+        void run()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (true)
+            {
+                cv_.wait(lock, [this](){return has_pending_ || stopping_;});
+                if (has_pending_)
+                {
+                    bool failed = error_ != 0;
+                    lock.unlock();
+                    int ec = failed ? 0 : write_fully(fd_, pending_.data(), pending_length_);
+                    lock.lock();
+                    if (ec != 0)
+                    {
+                        error_ = ec;
+                    }
+                    has_pending_ = false;
+                    cv_.notify_all();
+                }
+                else if (stopping_)
+                {
+                    return;
+                }
+            }
+        }
+    };
+
+} // namespace detail
+
+    // fd_sink
+
+    // Writes to a POSIX file descriptor through a large buffer. Strings appended that are at
+    // least writev_threshold long are written with the buffered output in one writev call,
+    // without being copied. With background_flush, a full buffer is written by another
+    // thread while the next one is filled.
+
+    template <class CharT>
+    class fd_sink
+    {
+    public:
+        using value_type = CharT;
+    private:
+        std::unique_ptr<jsoncons::detail::fd_sink_state> state_;
+        std::vector<uint8_t> buffer_;
+        value_type* begin_buffer_;
+        value_type* end_buffer_;
+        value_type* p_;
+        std::size_t writev_threshold_;
+
+        // Noncopyable
+        fd_sink(const fd_sink&) = delete;
+        fd_sink& operator=(const fd_sink&) = delete;
+    public:
+        // Writes to fd, which the sink does not close
+        explicit fd_sink(int fd, const fd_sink_options& options = fd_sink_options())
+            : state_(new jsoncons::detail::fd_sink_state(fd, false, fd < 0 ? EBADF : 0, options.background_flush()))
+        {
+            init(options);
+        }
+
+        // Creates or truncates the file at path, and closes it when the sink is destroyed
+        explicit fd_sink(const char* path, const fd_sink_options& options = fd_sink_options())
+        {
+            int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+            state_.reset(new jsoncons::detail::fd_sink_state(fd, true, fd < 0 ? errno : 0, options.background_flush()));
+            init(options);
+        }
+
+        explicit fd_sink(const std::string& path, const fd_sink_options& options = fd_sink_options())
+            : fd_sink(path.c_str(), options)
+        {
+        }
+
+        fd_sink(fd_sink&& other) noexcept
+            : begin_buffer_(nullptr), end_buffer_(nullptr), p_(nullptr), writev_threshold_(0)
+        {
+            swap(other);
+        }
+
+        fd_sink& operator=(fd_sink&& other) noexcept
+        {
+            swap(other);
+            return *this;
+        }
+
+        ~fd_sink() noexcept
+        {
+            if (state_)
+            {
+                write_buffer();
+                state_->wait();
+            }
+        }
+
+        bool is_error() const
+        {
+            return state_->is_error();
+        }
+
+        // The errno of the first write that failed, or 0
+        int error_number() const
+        {
+            return state_->error_number();
+        }
+
+        // Writes everything appended so far to the file descriptor
+        void flush()
+        {
+            write_buffer();
+            state_->wait();
+        }
+
+        void push_back(value_type ch)
+        {
+            if (p_ == end_buffer_)
+            {
+                write_buffer();
+            }
+            *p_++ = ch;
+        }
+
+        void append(const value_type* s, std::size_t length)
+        {
+            if (writev_threshold_ > 0 && length >= writev_threshold_)
+            {
+                state_->write(buffer_.data(), buffer_length()*sizeof(value_type),
+                              reinterpret_cast<const uint8_t*>(s), length*sizeof(value_type));
+                p_ = begin_buffer_;
+                return;
+            }
+            while (length > 0)
+            {
+                if (p_ == end_buffer_)
+                {
+                    write_buffer();
+                }
+                std::size_t n = (std::min)(length, static_cast<std::size_t>(end_buffer_ - p_));
+                std::memcpy(p_, s, n*sizeof(value_type));
+                p_ += n;
+                s += n;
+                length -= n;
+            }
+        }
+
+        value_type* reserve(std::size_t n)
+        {
+            if (static_cast<std::size_t>(end_buffer_ - p_) < n)
+            {
+                write_buffer();
+                if (static_cast<std::size_t>(end_buffer_ - p_) < n)
+                {
+                    buffer_.resize(n*sizeof(value_type));
+                    reset_buffer();
+                }
+            }
+            return p_;
+        }
+
+        void commit(std::size_t n)
+        {
+            p_ += n;
+        }
+    private:
+        void init(const fd_sink_options& options)
+        {
+            buffer_.resize(options.buffer_length()*sizeof(value_type));
+            writev_threshold_ = options.writev_threshold();
+            reset_buffer();
+        }
+
+        void swap(fd_sink& other) noexcept
+        {
+            std::swap(state_, other.state_);
+            std::swap(buffer_, other.buffer_);
+            std::swap(begin_buffer_, other.begin_buffer_);
+            std::swap(end_buffer_, other.end_buffer_);
+            std::swap(p_, other.p_);
+            std::swap(writev_threshold_, other.writev_threshold_);
+        }
+
+        void reset_buffer()
+        {
+            begin_buffer_ = reinterpret_cast<value_type*>(buffer_.data());
+            end_buffer_ = begin_buffer_ + buffer_.size()/sizeof(value_type);
+            p_ = begin_buffer_;
+        }
+
+        std::size_t buffer_length() const
+        {
+            return static_cast<std::size_t>(p_ - begin_buffer_);
+        }
+
+        void write_buffer()
+        {
+            if (p_ != begin_buffer_)
+            {
+                state_->write_buffer(buffer_, buffer_length()*sizeof(value_type));
+                reset_buffer();
+            }
+        }
+    };
+
+    using binary_fd_sink = fd_sink<uint8_t>;
+
+} // namespace jsoncons
+
+#endif // !defined(_WIN32)
+
+#endif
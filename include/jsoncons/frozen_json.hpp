@@ -0,0 +1,1567 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_FROZEN_JSON_HPP
+#define JSONCONS_FROZEN_JSON_HPP
+
+#include <cstddef> // std::size_t
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <string>
+#include <vector>
+#include <istream> // std::basic_istream
+#include <ostream> // std::basic_ostream
+#include <memory> // std::allocator
+#include <algorithm> // std::lower_bound, std::stable_sort
+#include <utility> // std::move, std::swap
+#include <type_traits> // std::enable_if, std::aligned_storage
+#include <unordered_map> // std::unordered_multimap
+#include <jsoncons/basic_json.hpp>
+#include <jsoncons/json_hash.hpp>
+
+namespace jsoncons {
+
+    template <class CharT>
+    class basic_frozen_json_decoder;
+
+    template <class CharT>
+    class frozen_key_value;
+
+    // An immutable JSON value, laid out as a single contiguous block of 16 byte nodes.
+    // The elements of an array, and the members of an object, are stored together in
+    // one run of nodes, and members are sorted by key, so that find is a binary search
+    // within the run. Nodes refer to their elements, members and long strings by offsets
+    // relative to themselves.
+    //
+    // A basic_frozen_json that owns a block refers to the root node at its start.
+    // Elements and member values are returned as references into the block, and are
+    // valid for as long as the basic_frozen_json that owns it. Copying one copies
+    // the value it refers to into a block of its own.
+
+    template <class CharT>
+    class basic_frozen_json
+    {
+        friend class basic_frozen_json_decoder<CharT>;
+        friend class frozen_key_value<CharT>;
+    public:
+        using char_type = CharT;
+        using char_traits_type = std::char_traits<CharT>;
+        using string_view_type = jsoncons::basic_string_view<CharT,char_traits_type>;
+        using allocator_type = std::allocator<char>;
+        using key_value_type = frozen_key_value<CharT>;
+        using pointer = const basic_frozen_json*;
+        using const_pointer = const basic_frozen_json*;
+        using reference = const basic_frozen_json&;
+        using const_reference = const basic_frozen_json&;
+
+        using const_object_iterator = const key_value_type*;
+        using object_iterator = const_object_iterator;
+        using const_array_iterator = const basic_frozen_json*;
+        using array_iterator = const_array_iterator;
+        using const_object_range_type = range<const_object_iterator, const_object_iterator>;
+        using const_array_range_type = range<const_array_iterator, const_array_iterator>;
+        using object = const_object_range_type;
+        using array = const_array_range_type;
+
+        static constexpr std::size_t inline_capacity = 8 / sizeof(CharT);
+    private:
+        enum class node_kind : uint8_t
+        {
+            null_value,
+            bool_value,
+            int64_value,
+            uint64_value,
+            half_value,
+            double_value,
+            short_string_value,
+            long_string_value,
+            byte_string_value,
+            array_value,
+            object_value,
+            document
+        };
+
+        using unit_type = typename std::aligned_storage<16,8>::type;
+        using unit_allocator_type = std::allocator<unit_type>;
+
+        node_kind kind_;
+        semantic_tag tag_;
+        uint32_t length_;
+        union
+        {
+            bool bool_val_;
+            int64_t int64_val_;
+            uint64_t uint64_val_;
+            uint16_t half_val_;
+            double double_val_;
+            int64_t offset_;
+            CharT chars_[inline_capacity];
+            unit_type* block_;
+        };
+
+    public:
+        basic_frozen_json() noexcept
+            : kind_(node_kind::null_value), tag_(semantic_tag::none), length_(0), uint64_val_(0)
+        {
+        }
+
+        template <class Json>
+        explicit basic_frozen_json(const Json& j,
+                                   typename std::enable_if<is_basic_json<Json>::value,int>::type = 0)
+            : basic_frozen_json()
+        {
+            basic_frozen_json_decoder<CharT> decoder;
+            j.dump(decoder);
+            *this = decoder.get_result();
+        }
+
+        basic_frozen_json(const basic_frozen_json& other)
+            : kind_(other.kind_), tag_(other.tag_), length_(other.length_), uint64_val_(other.uint64_val_)
+        {
+            if (kind_ == node_kind::document || kind_ == node_kind::long_string_value || kind_ == node_kind::byte_string_value ||
+                kind_ == node_kind::array_value || kind_ == node_kind::object_value)
+            {
+                kind_ = node_kind::null_value;
+                basic_frozen_json_decoder<CharT> decoder;
+                other.dump(decoder);
+                *this = decoder.get_result();
+            }
+        }
+
+        basic_frozen_json(basic_frozen_json&& other) noexcept
+            : basic_frozen_json()
+        {
+            if (other.kind_ == node_kind::document)
+            {
+                swap(other);
+            }
+            else
+            {
+                basic_frozen_json temp(other);
+                swap(temp);
+            }
+        }
+
+        ~basic_frozen_json() noexcept
+        {
+            if (kind_ == node_kind::document)
+            {
+                std::size_t count;
+                std::memcpy(&count, block_, sizeof(count));
+                unit_allocator_type().deallocate(block_, count);
+            }
+        }
+
+        basic_frozen_json& operator=(const basic_frozen_json& other)
+        {
+            if (this != &other)
+            {
+                basic_frozen_json temp(other);
+                swap(temp);
+            }
+            return *this;
+        }
+
+        basic_frozen_json& operator=(basic_frozen_json&& other) noexcept
+        {
+            if (this != &other)
+            {
+                basic_frozen_json temp(std::move(other));
+                swap(temp);
+            }
+            return *this;
+        }
+
+        void swap(basic_frozen_json& other) noexcept
+        {
+            // Only values that are not in a block, or that own their block, are swapped,
+            // and those hold no self relative offsets
+            std::swap(kind_, other.kind_);
+            std::swap(tag_, other.tag_);
+            std::swap(length_, other.length_);
+            std::swap(uint64_val_, other.uint64_val_);
+        }
+
+        static basic_frozen_json parse(const string_view_type& s,
+                                       const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>())
+        {
+            basic_frozen_json_decoder<CharT> decoder;
+            basic_json_reader<char_type,string_source<char_type>> reader(s, decoder, options);
+            reader.read_next();
+            reader.check_done();
+            if (!decoder.is_valid())
+            {
+                JSONCONS_THROW(json_runtime_error<std::runtime_error>("Failed to parse json string"));
+            }
+            return decoder.get_result();
+        }
+
+        static basic_frozen_json parse(std::basic_istream<char_type>& is,
+                                       const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>())
+        {
+            basic_frozen_json_decoder<CharT> decoder;
+            basic_json_reader<char_type,stream_source<char_type>> reader(is, decoder, options);
+            reader.read_next();
+            reader.check_done();
+            if (!decoder.is_valid())
+            {
+                JSONCONS_THROW(json_runtime_error<std::runtime_error>("Failed to parse json stream"));
+            }
+            return decoder.get_result();
+        }
+
+        // The size of the block that holds the value, or 0 for a scalar that is held in
+        // the node itself
+        std::size_t bytes_allocated() const noexcept
+        {
+            if (kind_ != node_kind::document)
+            {
+                return 0;
+            }
+            std::size_t count;
+            std::memcpy(&count, block_, sizeof(count));
+            return count*sizeof(unit_type);
+        }
+
+        json_type type() const
+        {
+            switch (value().kind_)
+            {
+                case node_kind::bool_value:
+                    return json_type::bool_value;
+                case node_kind::int64_value:
+                    return json_type::int64_value;
+                case node_kind::uint64_value:
+                    return json_type::uint64_value;
+                case node_kind::half_value:
+                    return json_type::half_value;
+                case node_kind::double_value:
+                    return json_type::double_value;
+                case node_kind::short_string_value:
+                case node_kind::long_string_value:
+                    return json_type::string_value;
+                case node_kind::byte_string_value:
+                    return json_type::byte_string_value;
+                case node_kind::array_value:
+                    return json_type::array_value;
+                case node_kind::object_value:
+                    return json_type::object_value;
+                default:
+                    return json_type::null_value;
+            }
+        }
+
+        semantic_tag tag() const
+        {
+            return value().tag_;
+        }
+
+        uint64_t ext_tag() const
+        {
+            const basic_frozen_json& val = value();
+            if (val.kind_ != node_kind::byte_string_value)
+            {
+                return 0;
+            }
+            uint64_t ext_tag;
+            std::memcpy(&ext_tag, val.target(), sizeof(ext_tag));
+            return ext_tag;
+        }
+
+        bool is_null() const noexcept
+        {
+            return value().kind_ == node_kind::null_value;
+        }
+
+        bool is_bool() const noexcept
+        {
+            return value().kind_ == node_kind::bool_value;
+        }
+
+        bool is_int64() const noexcept
+        {
+            return value().kind_ == node_kind::int64_value;
+        }
+
+        bool is_uint64() const noexcept
+        {
+            return value().kind_ == node_kind::uint64_value;
+        }
+
+        bool is_half() const noexcept
+        {
+            return value().kind_ == node_kind::half_value;
+        }
+
+        bool is_double() const noexcept
+        {
+            return value().kind_ == node_kind::double_value;
+        }
+
+        bool is_number() const noexcept
+        {
+            switch (value().kind_)
+            {
+                case node_kind::int64_value:
+                case node_kind::uint64_value:
+                case node_kind::half_value:
+                case node_kind::double_value:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        bool is_string() const noexcept
+        {
+            return value().kind_ == node_kind::short_string_value || value().kind_ == node_kind::long_string_value;
+        }
+
+        bool is_string_view() const noexcept
+        {
+            return is_string();
+        }
+
+        bool is_byte_string() const noexcept
+        {
+            return value().kind_ == node_kind::byte_string_value;
+        }
+
+        bool is_byte_string_view() const noexcept
+        {
+            return is_byte_string();
+        }
+
+        bool is_array() const noexcept
+        {
+            return value().kind_ == node_kind::array_value;
+        }
+
+        bool is_object() const noexcept
+        {
+            return value().kind_ == node_kind::object_value;
+        }
+
+        bool empty() const noexcept
+        {
+            switch (value().kind_)
+            {
+                case node_kind::short_string_value:
+                case node_kind::long_string_value:
+                case node_kind::byte_string_value:
+                case node_kind::array_value:
+                case node_kind::object_value:
+                    return value().length_ == 0;
+                default:
+                    return false;
+            }
+        }
+
+        std::size_t size() const noexcept
+        {
+            switch (value().kind_)
+            {
+                case node_kind::array_value:
+                case node_kind::object_value:
+                    return value().length_;
+                default:
+                    return 0;
+            }
+        }
+
+        template <class T>
+        bool is() const noexcept
+        {
+            return json_type_traits<basic_frozen_json,T>::is(*this);
+        }
+
+        template <class T>
+        typename std::enable_if<!is_basic_json<T>::value && is_json_type_traits_specialized<basic_frozen_json,T>::value,T>::type
+        as() const
+        {
+            return json_type_traits<basic_frozen_json,T>::as(*this);
+        }
+
+        // Copies the value into a basic_json, for example to modify it, or to query it with JSONPath
+        template <class T>
+        typename std::enable_if<is_basic_json<T>::value,T>::type
+        as() const
+        {
+            json_decoder<T> decoder;
+            dump(decoder);
+            return decoder.get_result();
+        }
+
+        bool as_bool() const
+        {
+            const basic_frozen_json& val = value();
+            switch (val.kind_)
+            {
+                case node_kind::bool_value:
+                    return val.bool_val_;
+                case node_kind::int64_value:
+                    return val.int64_val_ != 0;
+                case node_kind::uint64_value:
+                    return val.uint64_val_ != 0;
+                default:
+                    JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a bool"));
+            }
+        }
+
+        template <class T>
+        T as_integer() const
+        {
+            const basic_frozen_json& val = value();
+            switch (val.kind_)
+            {
+                case node_kind::short_string_value:
+                case node_kind::long_string_value:
+                {
+                    string_view_type sv = val.as_string_view();
+                    auto result = jsoncons::detail::to_integer<T>(sv.data(), sv.length());
+                    if (!result)
+                    {
+                        JSONCONS_THROW(json_runtime_error<std::runtime_error>(result.error_code().message()));
+                    }
+                    return result.value();
+                }
+                case node_kind::half_value:
+                    return static_cast<T>(val.half_val_);
+                case node_kind::double_value:
+                    return static_cast<T>(val.double_val_);
+                case node_kind::int64_value:
+                    return static_cast<T>(val.int64_val_);
+                case node_kind::uint64_value:
+                    return static_cast<T>(val.uint64_val_);
+                case node_kind::bool_value:
+                    return static_cast<T>(val.bool_val_ ? 1 : 0);
+                default:
+                    JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an integer"));
+            }
+        }
+
+        double as_double() const
+        {
+            const basic_frozen_json& val = value();
+            switch (val.kind_)
+            {
+                case node_kind::short_string_value:
+                case node_kind::long_string_value:
+                {
+                    std::basic_string<char_type> s(val.as_string_view().data(), val.as_string_view().length());
+                    jsoncons::detail::to_double_t to_double;
+                    // to_double() throws std::invalid_argument if conversion fails
+                    return to_double(s.c_str(), s.length());
+                }
+                case node_kind::half_value:
+                    return jsoncons::detail::decode_half(val.half_val_);
+                case node_kind::double_value:
+                    return val.double_val_;
+                case node_kind::int64_value:
+                    return static_cast<double>(val.int64_val_);
+                case node_kind::uint64_value:
+                    return static_cast<double>(val.uint64_val_);
+                default:
+                    JSONCONS_THROW(json_runtime_error<std::invalid_argument>("Not a double"));
+            }
+        }
+
+        string_view_type as_string_view() const
+        {
+            const basic_frozen_json& val = value();
+            switch (val.kind_)
+            {
+                case node_kind::short_string_value:
+                    return string_view_type(val.chars_, val.length_);
+                case node_kind::long_string_value:
+                    return string_view_type(reinterpret_cast<const CharT*>(val.target()), val.length_);
+                default:
+                    JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a string"));
+            }
+        }
+
+        byte_string_view as_byte_string_view() const
+        {
+            const basic_frozen_json& val = value();
+            if (val.kind_ != node_kind::byte_string_value)
+            {
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a byte string"));
+            }
+            return byte_string_view(reinterpret_cast<const uint8_t*>(val.target()) + sizeof(uint64_t), val.length_);
+        }
+
+        template <typename BAllocator=std::allocator<uint8_t>>
+        basic_byte_string<BAllocator> as_byte_string() const
+        {
+            byte_string_view bytes = as_byte_string_view();
+            return basic_byte_string<BAllocator>(bytes.data(), bytes.size());
+        }
+
+        template <class SAllocator=std::allocator<char_type>>
+        std::basic_string<char_type,char_traits_type,SAllocator> as_string() const
+        {
+            using string_type = std::basic_string<char_type,char_traits_type,SAllocator>;
+
+            if (is_string())
+            {
+                string_view_type sv = as_string_view();
+                return string_type(sv.data(), sv.length());
+            }
+            string_type s;
+            if (is_byte_string())
+            {
+                converter<string_type> convert;
+                std::error_code ec;
+                s = convert.from(as_byte_string_view(), tag(), ec);
+                if (ec)
+                {
+                    JSONCONS_THROW(ser_error(ec));
+                }
+            }
+            else
+            {
+                basic_compact_json_encoder<char_type,jsoncons::string_sink<string_type>> encoder(s);
+                dump(encoder);
+            }
+            return s;
+        }
+
+        const basic_frozen_json& at(std::size_t i) const
+        {
+            const basic_frozen_json& val = value();
+            switch (val.kind_)
+            {
+                case node_kind::array_value:
+                    if (i >= val.length_)
+                    {
+                        JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+                    }
+                    return val.elements()[i];
+                case node_kind::object_value:
+                    if (i >= val.length_)
+                    {
+                        JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+                    }
+                    return val.members()[i].value();
+                default:
+                    JSONCONS_THROW(json_runtime_error<std::domain_error>("Index on non-array value not supported"));
+            }
+        }
+
+        const basic_frozen_json& operator[](std::size_t i) const
+        {
+            return at(i);
+        }
+
+        const basic_frozen_json& at(const string_view_type& name) const
+        {
+            const basic_frozen_json& val = value();
+            if (val.kind_ != node_kind::object_value)
+            {
+                JSONCONS_THROW(not_an_object(name.data(),name.length()));
+            }
+            const key_value_type* member = val.find_member(name);
+            if (member == nullptr)
+            {
+                JSONCONS_THROW(key_not_found(name.data(),name.length()));
+            }
+            return member->value();
+        }
+
+        const basic_frozen_json& operator[](const string_view_type& name) const
+        {
+            return at(name);
+        }
+
+        // Returns object_range().end() if the name is not found, or nullptr if this is not an object
+        const_object_iterator find(const string_view_type& name) const noexcept
+        {
+            const basic_frozen_json& val = value();
+            if (val.kind_ != node_kind::object_value)
+            {
+                return nullptr;
+            }
+            const key_value_type* member = val.find_member(name);
+            return member != nullptr ? member : val.members() + val.length_;
+        }
+
+        bool contains(const string_view_type& name) const noexcept
+        {
+            const basic_frozen_json& val = value();
+            return val.kind_ == node_kind::object_value && val.find_member(name) != nullptr;
+        }
+
+        template <class T,class U>
+        T get_value_or(const string_view_type& name, U&& default_value) const
+        {
+            const basic_frozen_json& val = value();
+            const key_value_type* member = val.kind_ == node_kind::object_value ? val.find_member(name) : nullptr;
+            if (member != nullptr)
+            {
+                return member->value().template as<T>();
+            }
+            return static_cast<T>(std::forward<U>(default_value));
+        }
+
+        const_object_range_type object_range() const
+        {
+            const basic_frozen_json& val = value();
+            switch (val.kind_)
+            {
+                case node_kind::object_value:
+                    return const_object_range_type(val.members(), val.members() + val.length_);
+                default:
+                    JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an object"));
+            }
+        }
+
+        const_array_range_type array_range() const
+        {
+            const basic_frozen_json& val = value();
+            switch (val.kind_)
+            {
+                case node_kind::array_value:
+                    return const_array_range_type(val.elements(), val.elements() + val.length_);
+                default:
+                    JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an array"));
+            }
+        }
+
+        void dump(basic_json_visitor<char_type>& visitor) const
+        {
+            std::error_code ec;
+            dump(visitor, ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec));
+            }
+        }
+
+        void dump(basic_json_visitor<char_type>& visitor, std::error_code& ec) const
+        {
+            value().dump_noflush(visitor, ec);
+            if (ec)
+            {
+                return;
+            }
+            visitor.flush();
+        }
+
+        template <class SAllocator=std::allocator<char_type>>
+        void dump(std::basic_string<char_type,char_traits_type,SAllocator>& s,
+                  const basic_json_encode_options<char_type>& options = basic_json_encode_options<char_type>(),
+                  indenting line_indent = indenting::no_indent) const
+        {
+            using string_type = std::basic_string<char_type,char_traits_type,SAllocator>;
+            if (line_indent == indenting::indent)
+            {
+                basic_json_encoder<char_type,jsoncons::string_sink<string_type>> encoder(s, options);
+                dump(encoder);
+            }
+            else
+            {
+                basic_compact_json_encoder<char_type,jsoncons::string_sink<string_type>> encoder(s, options);
+                dump(encoder);
+            }
+        }
+
+        void dump(std::basic_ostream<char_type>& os,
+                  const basic_json_encode_options<char_type>& options = basic_json_encode_options<char_type>(),
+                  indenting line_indent = indenting::no_indent) const
+        {
+            if (line_indent == indenting::indent)
+            {
+                basic_json_encoder<char_type> encoder(os, options);
+                dump(encoder);
+            }
+            else
+            {
+                basic_compact_json_encoder<char_type> encoder(os, options);
+                dump(encoder);
+            }
+        }
+
+        std::basic_string<char_type> to_string() const
+        {
+            std::basic_string<char_type> s;
+            dump(s);
+            return s;
+        }
+
+        friend bool operator==(const basic_frozen_json& lhs, const basic_frozen_json& rhs)
+        {
+            return lhs.value().equals(rhs.value());
+        }
+
+        friend bool operator!=(const basic_frozen_json& lhs, const basic_frozen_json& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+        friend std::basic_ostream<char_type>& operator<<(std::basic_ostream<char_type>& os, const basic_frozen_json& o)
+        {
+            o.dump(os);
+            return os;
+        }
+
+    private:
+        // The value this node stands for, the root of its block if it owns one
+        const basic_frozen_json& value() const noexcept
+        {
+            return kind_ == node_kind::document ? *reinterpret_cast<const basic_frozen_json*>(block_ + 1) : *this;
+        }
+
+        const unsigned char* target() const noexcept
+        {
+            return reinterpret_cast<const unsigned char*>(this) + offset_;
+        }
+
+        const basic_frozen_json* elements() const noexcept
+        {
+            return reinterpret_cast<const basic_frozen_json*>(target());
+        }
+
+        const key_value_type* members() const noexcept
+        {
+            return reinterpret_cast<const key_value_type*>(target());
+        }
+
+        // For a node known to be a string, such as a key
+        string_view_type string_view_unchecked() const noexcept
+        {
+            return kind_ == node_kind::short_string_value ? string_view_type(chars_, length_)
+                                                          : string_view_type(reinterpret_cast<const CharT*>(target()), length_);
+        }
+
+        // Binary search of the sorted members of an object
+        const key_value_type* find_member(const string_view_type& name) const noexcept
+        {
+            const key_value_type* first = members();
+            std::size_t count = length_;
+            while (count > 0)
+            {
+                std::size_t half = count / 2;
+                if (first[half].key_.string_view_unchecked().compare(name) < 0)
+                {
+                    first += half + 1;
+                    count -= half + 1;
+                }
+                else
+                {
+                    count = half;
+                }
+            }
+            return (first != members() + length_ && first->key_.string_view_unchecked() == name) ? first : nullptr;
+        }
+
+        // Compares with an explicit stack of the elements and member values still to compare,
+        // rather than by recursion
+        bool equals(const basic_frozen_json& other) const
+        {
+            std::vector<std::pair<const basic_frozen_json*,const basic_frozen_json*>> stack;
+            stack.emplace_back(this, &other);
+            while (!stack.empty())
+            {
+                const basic_frozen_json& lhs = *stack.back().first;
+                const basic_frozen_json& rhs = *stack.back().second;
+                stack.pop_back();
+                if (!lhs.equal_or_defer(rhs, stack))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Compares scalars, and for arrays and objects compares the lengths and keys and
+        // pushes the elements and member values onto the stack
+        bool equal_or_defer(const basic_frozen_json& other, 
+                            std::vector<std::pair<const basic_frozen_json*,const basic_frozen_json*>>& stack) const
+        {
+            switch (kind_)
+            {
+                case node_kind::null_value:
+                    return other.kind_ == node_kind::null_value;
+                case node_kind::bool_value:
+                    return other.kind_ == node_kind::bool_value && bool_val_ == other.bool_val_;
+                case node_kind::int64_value:
+                    return (other.kind_ == node_kind::int64_value && int64_val_ == other.int64_val_) ||
+                           (other.kind_ == node_kind::uint64_value && int64_val_ >= 0 && static_cast<uint64_t>(int64_val_) == other.uint64_val_) ||
+                           (other.kind_ == node_kind::double_value && static_cast<double>(int64_val_) == other.double_val_);
+                case node_kind::uint64_value:
+                    return (other.kind_ == node_kind::uint64_value && uint64_val_ == other.uint64_val_) ||
+                           (other.kind_ == node_kind::int64_value && other.equal_or_defer(*this, stack)) ||
+                           (other.kind_ == node_kind::double_value && static_cast<double>(uint64_val_) == other.double_val_);
+                case node_kind::half_value:
+                    return other.kind_ == node_kind::half_value ? half_val_ == other.half_val_ : other.is_number() && as_double() == other.as_double();
+                case node_kind::double_value:
+                    return other.is_number() && as_double() == other.as_double();
+                case node_kind::short_string_value:
+                case node_kind::long_string_value:
+                    return other.is_string() && as_string_view() == other.as_string_view();
+                case node_kind::byte_string_value:
+                    return other.is_byte_string() && as_byte_string_view() == other.as_byte_string_view();
+                case node_kind::array_value:
+                {
+                    if (other.kind_ != node_kind::array_value || length_ != other.length_)
+                    {
+                        return false;
+                    }
+                    for (std::size_t i = 0; i < length_; ++i)
+                    {
+                        stack.emplace_back(elements() + i, other.elements() + i);
+                    }
+                    return true;
+                }
+                case node_kind::object_value:
+                {
+                    if (other.kind_ != node_kind::object_value || length_ != other.length_)
+                    {
+                        return false;
+                    }
+                    for (std::size_t i = 0; i < length_; ++i)
+                    {
+                        if (members()[i].key() != other.members()[i].key())
+                        {
+                            return false;
+                        }
+                        stack.emplace_back(&members()[i].value(), &other.members()[i].value());
+                    }
+                    return true;
+                }
+                default:
+                    return false;
+            }
+        }
+
+        // A container whose elements or members are being written
+        struct dump_frame
+        {
+            const basic_frozen_json* container;
+            std::size_t index;
+        };
+
+        // Writes the value with an explicit stack of open containers rather than by recursion
+        void dump_noflush(basic_json_visitor<char_type>& visitor, std::error_code& ec) const
+        {
+            const ser_context context{};
+            std::vector<dump_frame> stack;
+            const basic_frozen_json* current = this;
+
+            while (current != nullptr && !ec)
+            {
+                switch (current->kind_)
+                {
+                    case node_kind::object_value:
+                        if (visitor.begin_object(current->length_, current->tag_, context, ec))
+                        {
+                            stack.push_back(dump_frame{current, 0});
+                        }
+                        break;
+                    case node_kind::array_value:
+                        if (visitor.begin_array(current->length_, current->tag_, context, ec))
+                        {
+                            stack.push_back(dump_frame{current, 0});
+                        }
+                        break;
+                    default:
+                        current->dump_leaf(visitor, context, ec);
+                        break;
+                }
+
+                // Find the next array or object to open, writing the other values of the
+                // enclosing containers, and closing the containers that are done
+                current = nullptr;
+                while (current == nullptr && !stack.empty() && !ec)
+                {
+                    dump_frame& frame = stack.back();
+                    const basic_frozen_json& container = *frame.container;
+                    if (container.kind_ == node_kind::array_value)
+                    {
+                        while (frame.index < container.length_)
+                        {
+                            const basic_frozen_json& item = container.elements()[frame.index++];
+                            if (item.kind_ == node_kind::array_value || item.kind_ == node_kind::object_value)
+                            {
+                                current = &item;
+                                break;
+                            }
+                            item.dump_leaf(visitor, context, ec);
+                        }
+                        if (current == nullptr)
+                        {
+                            visitor.end_array(context, ec);
+                            stack.pop_back();
+                        }
+                    }
+                    else
+                    {
+                        while (frame.index < container.length_)
+                        {
+                            const key_value_type& member = container.members()[frame.index++];
+                            visitor.key(member.key(), context, ec);
+                            const basic_frozen_json& item = member.value();
+                            if (item.kind_ == node_kind::array_value || item.kind_ == node_kind::object_value)
+                            {
+                                current = &item;
+                                break;
+                            }
+                            item.dump_leaf(visitor, context, ec);
+                        }
+                        if (current == nullptr)
+                        {
+                            visitor.end_object(context, ec);
+                            stack.pop_back();
+                        }
+                    }
+                }
+            }
+        }
+
+        // Writes a value that is not an array or object
+        void dump_leaf(basic_json_visitor<char_type>& visitor, const ser_context& context, std::error_code& ec) const
+        {
+            switch (kind_)
+            {
+                case node_kind::short_string_value:
+                case node_kind::long_string_value:
+                    visitor.string_value(as_string_view(), tag_, context, ec);
+                    break;
+                case node_kind::byte_string_value:
+                    if (tag_ == semantic_tag::ext)
+                    {
+                        visitor.byte_string_value(as_byte_string_view(), ext_tag(), context, ec);
+                    }
+                    else
+                    {
+                        visitor.byte_string_value(as_byte_string_view(), tag_, context, ec);
+                    }
+                    break;
+                case node_kind::half_value:
+                    visitor.half_value(half_val_, tag_, context, ec);
+                    break;
+                case node_kind::double_value:
+                    visitor.double_value(double_val_, tag_, context, ec);
+                    break;
+                case node_kind::int64_value:
+                    visitor.int64_value(int64_val_, tag_, context, ec);
+                    break;
+                case node_kind::uint64_value:
+                    visitor.uint64_value(uint64_val_, tag_, context, ec);
+                    break;
+                case node_kind::bool_value:
+                    visitor.bool_value(bool_val_, tag_, context, ec);
+                    break;
+                case node_kind::null_value:
+                    visitor.null_value(tag_, context, ec);
+                    break;
+                default:
+                    break;
+            }
+        }
+    };
+
+    template <class CharT>
+    constexpr std::size_t basic_frozen_json<CharT>::inline_capacity;
+
+    template <class CharT>
+    class frozen_key_value
+    {
+        friend class basic_frozen_json_decoder<CharT>;
+        friend class basic_frozen_json<CharT>;
+    public:
+        using char_type = CharT;
+        using string_view_type = typename basic_frozen_json<CharT>::string_view_type;
+    private:
+        basic_frozen_json<CharT> key_;
+        basic_frozen_json<CharT> value_;
+    public:
+        frozen_key_value() = default;
+        frozen_key_value(const frozen_key_value&) = delete;
+        frozen_key_value& operator=(const frozen_key_value&) = delete;
+
+        string_view_type key() const
+        {
+            return key_.string_view_unchecked();
+        }
+
+        const basic_frozen_json<CharT>& value() const
+        {
+            return value_;
+        }
+    };
+
+    // Builds a basic_frozen_json from a stream of events. The events are recorded in
+    // document order, with each array and object noting where it ends, and when the
+    // root value ends they are laid out in one block, each container's elements or
+    // sorted members together.
+    //
+    // Constructed with share_identical set to true, the decoder hash-conses the block:
+    // identical long strings, byte strings, arrays and objects are laid out once, and
+    // every node that stands for one of them refers to the same run. This is safe
+    // because the block is immutable, and can make documents with many repeated
+    // sub-trees much smaller.
+
+    template <class CharT>
+    class basic_frozen_json_decoder final : public basic_json_visitor<CharT>
+    {
+    public:
+        using char_type = CharT;
+        using typename basic_json_visitor<CharT>::string_view_type;
+        using json_type = basic_frozen_json<CharT>;
+    private:
+        using node_kind = typename json_type::node_kind;
+        using unit_type = typename json_type::unit_type;
+        using key_value_type = frozen_key_value<CharT>;
+
+        struct event
+        {
+            node_kind kind_;
+            semantic_tag tag_;
+            // length of a string, elements of an array, or members of an object
+            std::size_t length_;
+            // position of a string or bytes in the pools, or of the event after a container
+            std::size_t position_;
+            uint64_t value_;
+
+            event(node_kind kind, semantic_tag tag, std::size_t length = 0, std::size_t position = 0, uint64_t value = 0)
+                : kind_(kind), tag_(tag), length_(length), position_(position), value_(value)
+            {
+            }
+        };
+
+        std::vector<event> events_;
+        std::basic_string<CharT> chars_;
+        std::vector<uint8_t> bytes_;
+        std::vector<std::size_t> structure_stack_;
+        // A run that has been laid out, and that later identical runs can share
+        struct shared_run
+        {
+            node_kind kind_;
+            uint32_t length_;
+            const unsigned char* target_;
+        };
+
+        std::vector<std::pair<std::size_t,std::size_t>> members_;
+
+        // An array or object whose elements or member values are being placed
+        struct place_frame
+        {
+            json_type* node;
+            // where the node's elements or members start
+            unit_type* start;
+            // the event of the next element of an array
+            std::size_t index;
+            // where the object's members start in members_
+            std::size_t first;
+            // the elements or member values placed so far
+            std::size_t count;
+        };
+
+        std::size_t unit_count_;
+        json_type result_;
+        bool is_valid_;
+        bool share_identical_;
+        std::unordered_multimap<uint64_t,shared_run> runs_;
+    public:
+        explicit basic_frozen_json_decoder(bool share_identical = false)
+            : unit_count_(0), is_valid_(false), share_identical_(share_identical)
+        {
+        }
+
+        bool is_valid() const
+        {
+            return is_valid_;
+        }
+
+        json_type get_result()
+        {
+            JSONCONS_ASSERT(is_valid_);
+            is_valid_ = false;
+            return std::move(result_);
+        }
+
+        void reset()
+        {
+            events_.clear();
+            chars_.clear();
+            bytes_.clear();
+            structure_stack_.clear();
+            runs_.clear();
+            unit_count_ = 0;
+            is_valid_ = false;
+        }
+
+    private:
+        static std::size_t units_for(std::size_t bytes)
+        {
+            return (bytes + sizeof(unit_type) - 1) / sizeof(unit_type);
+        }
+
+        void add_event(const event& e)
+        {
+            if (!structure_stack_.empty() && events_[structure_stack_.back()].kind_ == node_kind::array_value)
+            {
+                ++events_[structure_stack_.back()].length_;
+            }
+            events_.push_back(e);
+        }
+
+        bool add_value(const event& e)
+        {
+            add_event(e);
+            if (structure_stack_.empty())
+            {
+                build();
+                return false;
+            }
+            return true;
+        }
+
+        bool add_string(const string_view_type& sv, semantic_tag tag, bool is_key)
+        {
+            node_kind kind = node_kind::short_string_value;
+            if (sv.length() > json_type::inline_capacity)
+            {
+                kind = node_kind::long_string_value;
+                unit_count_ += units_for((sv.length()+1)*sizeof(CharT));
+            }
+            event e(kind, tag, sv.length(), chars_.size());
+            chars_.append(sv.data(), sv.length());
+            if (is_key)
+            {
+                ++events_[structure_stack_.back()].length_;
+                events_.push_back(e);
+                return true;
+            }
+            return add_value(e);
+        }
+
+        void build()
+        {
+            // a header unit holding the size of the block, then the root
+            static_assert(sizeof(json_type) == sizeof(unit_type), "A node is one unit");
+            std::size_t count = 1 + events_.size() + unit_count_;
+            unit_type* block = std::allocator<unit_type>().allocate(count);
+            std::memcpy(block, &count, sizeof(count));
+
+            unit_type* next = block + 2;
+            json_type* root = ::new(static_cast<void*>(block + 1)) json_type();
+            place_root(*root, next);
+
+            if (share_identical_)
+            {
+                runs_.clear();
+                // Offsets are relative, so the used units can be moved to a block that fits
+                std::size_t used = static_cast<std::size_t>(next - block);
+                if (used < count)
+                {
+                    unit_type* fitted = std::allocator<unit_type>().allocate(used);
+                    std::memcpy(fitted, block, used*sizeof(unit_type));
+                    std::memcpy(fitted, &used, sizeof(used));
+                    std::allocator<unit_type>().deallocate(block, count);
+                    block = fitted;
+                }
+            }
+
+            result_ = json_type();
+            result_.kind_ = node_kind::document;
+            result_.block_ = block;
+            is_valid_ = true;
+
+            events_.clear();
+            chars_.clear();
+            bytes_.clear();
+            unit_count_ = 0;
+        }
+
+        std::size_t next_sibling(std::size_t index) const
+        {
+            const event& e = events_[index];
+            return (e.kind_ == node_kind::array_value || e.kind_ == node_kind::object_value) ? e.position_ : index + 1;
+        }
+
+        static void set_target(json_type& node, const void* p)
+        {
+            node.offset_ = reinterpret_cast<const unsigned char*>(p) - reinterpret_cast<const unsigned char*>(&node);
+        }
+
+        string_view_type string_at(std::size_t index) const
+        {
+            return string_view_type(chars_.data() + events_[index].position_, events_[index].length_);
+        }
+
+        // Places the root and everything under it with an explicit stack of the arrays and 
+        // objects being filled, rather than by recursion. The layout is depth first, each 
+        // container's elements or members followed by what is under them in order.
+        void place_root(json_type& root, unit_type*& next)
+        {
+            std::vector<place_frame> stack;
+            place(0, root, next, stack);
+            while (!stack.empty())
+            {
+                place_frame& frame = stack.back();
+                json_type& node = *frame.node;
+                if (frame.count < node.length_)
+                {
+                    const std::size_t k = frame.count++;
+                    if (node.kind_ == node_kind::array_value)
+                    {
+                        json_type* element = ::new(static_cast<void*>(reinterpret_cast<json_type*>(frame.start) + k)) json_type();
+                        const std::size_t index = frame.index;
+                        frame.index = next_sibling(index);
+                        place(index, *element, next, stack);
+                    }
+                    else
+                    {
+                        key_value_type* members = reinterpret_cast<key_value_type*>(frame.start);
+                        place(members_[frame.first + k].second, members[k].value_, next, stack);
+                    }
+                }
+                else
+                {
+                    if (node.kind_ == node_kind::object_value)
+                    {
+                        members_.resize(frame.first);
+                    }
+                    unit_type* start = frame.start;
+                    stack.pop_back();
+                    share(node, start, next);
+                }
+            }
+        }
+
+        // Places a scalar or string, or lays out an array's elements or an object's members
+        // and pushes it on the stack to have them placed
+        void place(std::size_t index, json_type& node, unit_type*& next, std::vector<place_frame>& stack)
+        {
+            const event& e = events_[index];
+            node.kind_ = e.kind_;
+            node.tag_ = e.tag_;
+            node.length_ = static_cast<uint32_t>(e.length_);
+            switch (e.kind_)
+            {
+                case node_kind::short_string_value:
+                    std::memcpy(node.chars_, chars_.data() + e.position_, e.length_*sizeof(CharT));
+                    break;
+                case node_kind::long_string_value:
+                {
+                    unit_type* start = next;
+                    CharT* p = reinterpret_cast<CharT*>(next);
+                    std::memcpy(p, chars_.data() + e.position_, e.length_*sizeof(CharT));
+                    p[e.length_] = 0;
+                    set_target(node, p);
+                    next += units_for((e.length_+1)*sizeof(CharT));
+                    share(node, start, next);
+                    break;
+                }
+                case node_kind::byte_string_value:
+                {
+                    unit_type* start = next;
+                    unsigned char* p = reinterpret_cast<unsigned char*>(next);
+                    std::memcpy(p, &e.value_, sizeof(uint64_t));
+                    if (e.length_ > 0)
+                    {
+                        std::memcpy(p + sizeof(uint64_t), bytes_.data() + e.position_, e.length_);
+                    }
+                    set_target(node, p);
+                    next += units_for(sizeof(uint64_t) + e.length_);
+                    share(node, start, next);
+                    break;
+                }
+                case node_kind::array_value:
+                {
+                    set_target(node, next);
+                    stack.push_back(place_frame{&node, next, index + 1, 0, 0});
+                    next += e.length_;
+                    break;
+                }
+                case node_kind::object_value:
+                    place_object(index, node, next, stack);
+                    break;
+                default:
+                    node.uint64_val_ = e.value_;
+                    break;
+            }
+        }
+
+        static bool is_indirect(node_kind kind)
+        {
+            return kind == node_kind::long_string_value || kind == node_kind::byte_string_value ||
+                   kind == node_kind::array_value || kind == node_kind::object_value;
+        }
+
+        // A node is identified by its kind, tag and length, and either its value or, since
+        // runs are shared bottom up, the address of its run
+        static uint64_t node_hash(const json_type& node)
+        {
+            uint64_t payload = is_indirect(node.kind_) ? static_cast<uint64_t>(reinterpret_cast<uintptr_t>(node.target())) : node.uint64_val_;
+            uint64_t head = static_cast<uint64_t>(node.kind_) | (static_cast<uint64_t>(node.tag_) << 8) | (static_cast<uint64_t>(node.length_) << 16);
+            return jsoncons::detail::combine_hash(head, payload);
+        }
+
+        static bool same_node(const json_type& a, const json_type& b)
+        {
+            if (a.kind_ != b.kind_ || a.tag_ != b.tag_ || a.length_ != b.length_)
+            {
+                return false;
+            }
+            return is_indirect(a.kind_) ? a.target() == b.target() : a.uint64_val_ == b.uint64_val_;
+        }
+
+        static uint64_t run_hash(node_kind kind, std::size_t length, const unsigned char* run)
+        {
+            uint64_t h = static_cast<uint64_t>(kind) + (static_cast<uint64_t>(length) << 8);
+            switch (kind)
+            {
+                case node_kind::long_string_value:
+                    return jsoncons::detail::combine_hash(h, jsoncons::detail::hash_chars(reinterpret_cast<const CharT*>(run), length));
+                case node_kind::byte_string_value:
+                    return jsoncons::detail::combine_hash(h, jsoncons::detail::hash_chars(run, sizeof(uint64_t) + length));
+                case node_kind::array_value:
+                {
+                    const json_type* elements = reinterpret_cast<const json_type*>(run);
+                    for (std::size_t i = 0; i < length; ++i)
+                    {
+                        h = jsoncons::detail::combine_hash(h, node_hash(elements[i]));
+                    }
+                    return h;
+                }
+                default:
+                {
+                    const key_value_type* members = reinterpret_cast<const key_value_type*>(run);
+                    for (std::size_t i = 0; i < length; ++i)
+                    {
+                        h = jsoncons::detail::combine_hash(h, node_hash(members[i].key_));
+                        h = jsoncons::detail::combine_hash(h, node_hash(members[i].value_));
+                    }
+                    return h;
+                }
+            }
+        }
+
+        static bool same_run(node_kind kind, std::size_t length, const unsigned char* a, const unsigned char* b)
+        {
+            switch (kind)
+            {
+                case node_kind::long_string_value:
+                    return std::memcmp(a, b, length*sizeof(CharT)) == 0;
+                case node_kind::byte_string_value:
+                    return std::memcmp(a, b, sizeof(uint64_t) + length) == 0;
+                case node_kind::array_value:
+                {
+                    const json_type* x = reinterpret_cast<const json_type*>(a);
+                    const json_type* y = reinterpret_cast<const json_type*>(b);
+                    for (std::size_t i = 0; i < length; ++i)
+                    {
+                        if (!same_node(x[i], y[i]))
+                        {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+                default:
+                {
+                    const key_value_type* x = reinterpret_cast<const key_value_type*>(a);
+                    const key_value_type* y = reinterpret_cast<const key_value_type*>(b);
+                    for (std::size_t i = 0; i < length; ++i)
+                    {
+                        if (!same_node(x[i].key_, y[i].key_) || !same_node(x[i].value_, y[i].value_))
+                        {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+            }
+        }
+
+        // When sharing, points node at an identical run laid out earlier, if there is one,
+        // and gives back the units from start, which hold the node's own run and everything
+        // under it. Nothing under a run that is given back was recorded in runs_, since a
+        // new run under it would have made it differ from every earlier run.
+        void share(json_type& node, unit_type* start, unit_type*& next)
+        {
+            if (!share_identical_)
+            {
+                return;
+            }
+            const unsigned char* run = node.target();
+            uint64_t h = run_hash(node.kind_, node.length_, run);
+            auto range = runs_.equal_range(h);
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                if (it->second.kind_ == node.kind_ && it->second.length_ == node.length_ && 
+                    same_run(node.kind_, node.length_, run, it->second.target_))
+                {
+                    set_target(node, it->second.target_);
+                    next = start;
+                    return;
+                }
+            }
+            runs_.emplace(h, shared_run{node.kind_, node.length_, run});
+        }
+
+        void place_object(std::size_t index, json_type& node, unit_type*& next, std::vector<place_frame>& stack)
+        {
+            const event& e = events_[index];
+
+            // Gather the members on top of a stack shared by enclosing objects, sort them
+            // stably by key, and drop later duplicates
+            const std::size_t first = members_.size();
+            std::size_t i = index + 1;
+            for (std::size_t k = 0; k < e.length_; ++k)
+            {
+                members_.emplace_back(i, i + 1);
+                i = next_sibling(i + 1);
+            }
+            auto compare = [this](const std::pair<std::size_t,std::size_t>& a, const std::pair<std::size_t,std::size_t>& b) -> bool
+            {
+                return string_at(a.first).compare(string_at(b.first)) < 0;
+            };
+            if (!std::is_sorted(members_.begin() + first, members_.end(), compare))
+            {
+                std::stable_sort(members_.begin() + first, members_.end(), compare);
+            }
+            auto last = std::unique(members_.begin() + first, members_.end(),
+                [this](const std::pair<std::size_t,std::size_t>& a, const std::pair<std::size_t,std::size_t>& b) -> bool
+                {
+                    return string_at(a.first) == string_at(b.first);
+                });
+            const std::size_t length = static_cast<std::size_t>(last - (members_.begin() + first));
+
+            unit_type* start = next;
+            key_value_type* members = reinterpret_cast<key_value_type*>(next);
+            set_target(node, members);
+            node.length_ = static_cast<uint32_t>(length);
+            next += 2*e.length_;
+            // The keys' characters follow the members, so that a binary search stays close by.
+            // Keys are strings, so placing them pushes nothing.
+            for (std::size_t k = 0; k < length; ++k)
+            {
+                key_value_type* member = ::new(static_cast<void*>(members + k)) key_value_type();
+                place(members_[first + k].first, member->key_, next, stack);
+            }
+            // The values are placed from the stack, and the members are dropped from members_ after them
+            stack.push_back(place_frame{&node, start, 0, first, 0});
+        }
+
+        void visit_flush() override
+        {
+        }
+
+        bool visit_begin_object(semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            add_event(event(node_kind::object_value, tag));
+            structure_stack_.push_back(events_.size() - 1);
+            return true;
+        }
+
+        bool visit_end_object(const ser_context&, std::error_code&) override
+        {
+            JSONCONS_ASSERT(!structure_stack_.empty());
+            events_[structure_stack_.back()].position_ = events_.size();
+            structure_stack_.pop_back();
+            if (structure_stack_.empty())
+            {
+                build();
+                return false;
+            }
+            return true;
+        }
+
+        bool visit_begin_array(semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            add_event(event(node_kind::array_value, tag));
+            structure_stack_.push_back(events_.size() - 1);
+            return true;
+        }
+
+        bool visit_end_array(const ser_context& context, std::error_code& ec) override
+        {
+            return visit_end_object(context, ec);
+        }
+
+        bool visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
+        {
+            return add_string(name, semantic_tag::none, true);
+        }
+
+        bool visit_string(const string_view_type& sv, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            return add_string(sv, tag, false);
+        }
+
+        bool visit_byte_string(const byte_string_view& b,
+                               semantic_tag tag,
+                               const ser_context&,
+                               std::error_code&) override
+        {
+            unit_count_ += units_for(sizeof(uint64_t) + b.size());
+            event e(node_kind::byte_string_value, tag, b.size(), bytes_.size());
+            bytes_.insert(bytes_.end(), b.begin(), b.end());
+            return add_value(e);
+        }
+
+        bool visit_byte_string(const byte_string_view& b,
+                               uint64_t ext_tag,
+                               const ser_context&,
+                               std::error_code&) override
+        {
+            unit_count_ += units_for(sizeof(uint64_t) + b.size());
+            event e(node_kind::byte_string_value, semantic_tag::ext, b.size(), bytes_.size(), ext_tag);
+            bytes_.insert(bytes_.end(), b.begin(), b.end());
+            return add_value(e);
+        }
+
+        template <class T>
+        static uint64_t to_bits(T value)
+        {
+            uint64_t bits = 0;
+            std::memcpy(&bits, &value, sizeof(T));
+            return bits;
+        }
+
+        bool visit_int64(int64_t value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            return add_value(event(node_kind::int64_value, tag, 0, 0, to_bits(value)));
+        }
+
+        bool visit_uint64(uint64_t value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            return add_value(event(node_kind::uint64_value, tag, 0, 0, value));
+        }
+
+        bool visit_half(uint16_t value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            return add_value(event(node_kind::half_value, tag, 0, 0, to_bits(value)));
+        }
+
+        bool visit_double(double value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            return add_value(event(node_kind::double_value, tag, 0, 0, to_bits(value)));
+        }
+
+        bool visit_bool(bool value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            return add_value(event(node_kind::bool_value, tag, 0, 0, to_bits(value)));
+        }
+
+        bool visit_null(semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            return add_value(event(node_kind::null_value, tag));
+        }
+    };
+
+    using frozen_json = basic_frozen_json<char>;
+    using wfrozen_json = basic_frozen_json<wchar_t>;
+    using frozen_json_decoder = basic_frozen_json_decoder<char>;
+    using wfrozen_json_decoder = basic_frozen_json_decoder<wchar_t>;
+
+} // namespace jsoncons
+
+#endif
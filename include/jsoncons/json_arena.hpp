@@ -0,0 +1,89 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_ARENA_HPP
+#define JSONCONS_JSON_ARENA_HPP
+
+#include <cstddef> // std::size_t
+#include <string>
+#include <istream> // std::basic_istream
+#include <new> // placement new
+#include <utility> // std::move
+#include <jsoncons/basic_json.hpp>
+#include <jsoncons/decode_json.hpp>
+#include <jsoncons/monotonic_allocator.hpp>
+
+namespace jsoncons {
+
+    // Parses whole documents into a monotonic_buffer_resource. Every string, array and
+    // object of a parsed document, and the document itself, live in the arena, and
+    // basic_json destructors are never run: release() or the arena's destructor returns
+    // all of the memory at once, without walking the documents.
+    //
+    // References returned by parse remain valid until the arena is released.
+
+    template <class CharT,class Policy = sorted_policy>
+    class basic_json_arena
+    {
+    public:
+        using char_type = CharT;
+        using allocator_type = monotonic_allocator<char>;
+        using json_type = basic_json<CharT,Policy,allocator_type>;
+    private:
+        monotonic_buffer_resource resource_;
+    public:
+        explicit basic_json_arena(std::size_t initial_size = 65536)
+            : resource_(initial_size)
+        {
+        }
+
+        basic_json_arena(const basic_json_arena&) = delete;
+        basic_json_arena& operator=(const basic_json_arena&) = delete;
+
+        allocator_type get_allocator()
+        {
+            return allocator_type(resource_);
+        }
+
+        json_type& parse(const std::basic_string<CharT>& s,
+                         const basic_json_decode_options<CharT>& options = basic_json_decode_options<CharT>())
+        {
+            return emplace(decode_json<json_type>(result_allocator_arg, get_allocator(), s, options));
+        }
+
+        json_type& parse(std::basic_istream<CharT>& is,
+                         const basic_json_decode_options<CharT>& options = basic_json_decode_options<CharT>())
+        {
+            return emplace(decode_json<json_type>(result_allocator_arg, get_allocator(), is, options));
+        }
+
+        // Invalidates every document parsed into the arena
+        void release() noexcept
+        {
+            resource_.release();
+        }
+
+        std::size_t bytes_allocated() const
+        {
+            return resource_.bytes_allocated();
+        }
+
+    private:
+        json_type& emplace(json_type&& val)
+        {
+            void* p = resource_.allocate(sizeof(json_type), alignof(json_type));
+            return *::new(p) json_type(std::move(val));
+        }
+    };
+
+    using json_arena = basic_json_arena<char,sorted_policy>;
+    using wjson_arena = basic_json_arena<wchar_t,sorted_policy>;
+    using ojson_arena = basic_json_arena<char,preserve_order_policy>;
+    using wojson_arena = basic_json_arena<wchar_t,preserve_order_policy>;
+
+} // namespace jsoncons
+
+#endif
@@ -21,6 +21,7 @@
 #include <type_traits> // std::enable_if
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/allocator_holder.hpp>
+#include <jsoncons/detail/hash_index.hpp>
 
 namespace jsoncons {
 
@@ -286,6 +287,11 @@ namespace jsoncons {
             {
                 value_type current = std::move(elements_.back());
                 elements_.pop_back();
+                if (current.use_count() > 1)
+                {
+                    // Shared with a copy, it is left for the copy to destroy
+                    continue;
+                }
                 switch (current.storage())
                 {
                     case storage_kind::array_value:
@@ -512,6 +518,14 @@ namespace jsoncons {
         }
     };
 
+    // Compares an object member's key with a name, key types that can compare without
+    // converting to a string view overload this
+    template <class KeyT,class CharT,class Traits>
+    int compare_key(const KeyT& key, const jsoncons::basic_string_view<CharT,Traits>& name)
+    {
+        return jsoncons::basic_string_view<CharT,Traits>(key.data(), key.length()).compare(name);
+    }
+
     struct sort_key_order
     {
         explicit sort_key_order() = default; 
@@ -522,6 +536,16 @@ namespace jsoncons {
         explicit preserve_key_order() = default; 
     };
 
+    struct hash_key_order
+    {
+        explicit hash_key_order() = default; 
+    };
+
+    struct hash_preserve_key_order
+    {
+        explicit hash_preserve_key_order() = default; 
+    };
+
     template <class KeyT,class Json,class Enable = void>
     class json_object
     {
@@ -699,7 +723,7 @@ namespace jsoncons {
         iterator find(const string_view_type& name) noexcept
         {
             auto it = std::lower_bound(members_.begin(),members_.end(), name, 
-                                       [](const key_value_type& a, const string_view_type& k) -> bool {return string_view_type(a.key()).compare(k) < 0;});        
+                                       [](const key_value_type& a, const string_view_type& k) -> bool {return compare_key(a.key(), k) < 0;});        
             auto result = (it != members_.end() && it->key() == name) ? it : members_.end();
             return result;
         }
@@ -708,7 +732,7 @@ namespace jsoncons {
         {
             auto it = std::lower_bound(members_.begin(),members_.end(), 
                                        name, 
-                                       [](const key_value_type& a, const string_view_type& k) -> bool {return string_view_type(a.key()).compare(k) < 0;});
+                                       [](const key_value_type& a, const string_view_type& k) -> bool {return compare_key(a.key(), k) < 0;});
             auto result = (it != members_.end() && it->key() == name) ? it : members_.end();
             return result;
         }
@@ -737,7 +761,7 @@ namespace jsoncons {
         void erase(const string_view_type& name) 
         {
             auto it = std::lower_bound(members_.begin(),members_.end(), name, 
-                                       [](const key_value_type& a, const string_view_type& k) -> bool {return string_view_type(a.key()).compare(k) < 0;});        
+                                       [](const key_value_type& a, const string_view_type& k) -> bool {return compare_key(a.key(), k) < 0;});        
             if (it != members_.end() && it->key() == name)
             {
                 members_.erase(it);
@@ -786,6 +810,39 @@ namespace jsoncons {
             }
         }
 
+        // Appends a member without maintaining the key order, for building an object
+        // in place. Call end_unchecked() after the last member has been appended.
+        template <class... Args>
+        Json& emplace_back_unchecked(key_type&& name, Args&& ... args)
+        {
+            members_.emplace_back(std::move(name), std::forward<Args>(args)...);
+            return members_.back().value();
+        }
+
+        // Sorts the members appended by emplace_back_unchecked, unless they arrived
+        // with their keys in order, and releases unused capacity. Duplicate keys keep
+        // their first value.
+        void end_unchecked()
+        {
+            auto it = std::adjacent_find(members_.begin(), members_.end(),
+                                         [](const key_value_type& a, const key_value_type& b) -> bool {return a.key().compare(b.key()) >= 0;});
+            if (it != members_.end())
+            {
+                std::stable_sort(members_.begin(),members_.end(),
+                                 [](const key_value_type& a, const key_value_type& b) -> bool {return a.key().compare(b.key()) < 0;});
+                auto last_unique = std::unique(members_.begin(), members_.end(),
+                                      [](const key_value_type& a, const key_value_type& b) -> bool { return !(a.key().compare(b.key()));});
+                members_.erase(last_unique, members_.end());
+            }
+            members_.shrink_to_fit();
+        }
+
+        // Completes a copy of source whose members have been appended in order by 
+        // emplace_back_unchecked. The members are already sorted, so there is nothing to do.
+        void copy_index_from(const json_object&)
+        {
+        }
+
         // insert_or_assign
 
         template <class T, class A=allocator_type>
@@ -794,7 +851,7 @@ namespace jsoncons {
         {
             bool inserted;
             auto it = std::lower_bound(members_.begin(),members_.end(), name, 
-                                       [](const key_value_type& a, const string_view_type& k) -> bool {return string_view_type(a.key()).compare(k) < 0;});        
+                                       [](const key_value_type& a, const string_view_type& k) -> bool {return compare_key(a.key(), k) < 0;});        
             if (it == members_.end())
             {
                 members_.emplace_back(key_type(name.begin(),name.end()), 
@@ -823,7 +880,7 @@ namespace jsoncons {
         {
             bool inserted;
             auto it = std::lower_bound(members_.begin(),members_.end(), name, 
-                                       [](const key_value_type& a, const string_view_type& k) -> bool {return string_view_type(a.key()).compare(k) < 0;});        
+                                       [](const key_value_type& a, const string_view_type& k) -> bool {return compare_key(a.key(), k) < 0;});        
             if (it == members_.end())
             {
                 members_.emplace_back(key_type(name.begin(),name.end(), get_allocator()), 
@@ -854,7 +911,7 @@ namespace jsoncons {
         {
             bool inserted;
             auto it = std::lower_bound(members_.begin(),members_.end(), name, 
-                                       [](const key_value_type& a, const string_view_type& k) -> bool {return string_view_type(a.key()).compare(k) < 0;});        
+                                       [](const key_value_type& a, const string_view_type& k) -> bool {return compare_key(a.key(), k) < 0;});        
             if (it == members_.end())
             {
                 members_.emplace_back(key_type(name.begin(),name.end()), 
@@ -882,7 +939,7 @@ namespace jsoncons {
         {
             bool inserted;
             auto it = std::lower_bound(members_.begin(),members_.end(), name, 
-                                       [](const key_value_type& a, const string_view_type& k) -> bool {return string_view_type(a.key()).compare(k) < 0;});        
+                                       [](const key_value_type& a, const string_view_type& k) -> bool {return compare_key(a.key(), k) < 0;});        
             if (it == members_.end())
             {
                 members_.emplace_back(key_type(name.begin(),name.end(), get_allocator()), 
@@ -913,12 +970,12 @@ namespace jsoncons {
             if (hint != members_.end() && hint->key() <= name)
             {
                 it = std::lower_bound(hint,members_.end(), name, 
-                                      [](const key_value_type& a, const string_view_type& k) -> bool {return string_view_type(a.key()).compare(k) < 0;});        
+                                      [](const key_value_type& a, const string_view_type& k) -> bool {return compare_key(a.key(), k) < 0;});        
             }
             else
             {
                 it = std::lower_bound(members_.begin(),members_.end(), name, 
-                                      [](const key_value_type& a, const string_view_type& k) -> bool {return string_view_type(a.key()).compare(k) < 0;});        
+                                      [](const key_value_type& a, const string_view_type& k) -> bool {return compare_key(a.key(), k) < 0;});        
             }
 
             if (it == members_.end())
@@ -948,12 +1005,12 @@ namespace jsoncons {
             if (hint != members_.end() && hint->key() <= name)
             {
                 it = std::lower_bound(hint,members_.end(), name, 
-                                      [](const key_value_type& a, const string_view_type& k) -> bool {return string_view_type(a.key()).compare(k) < 0;});        
+                                      [](const key_value_type& a, const string_view_type& k) -> bool {return compare_key(a.key(), k) < 0;});        
             }
             else
             {
                 it = std::lower_bound(members_.begin(),members_.end(), name, 
-                                      [](const key_value_type& a, const string_view_type& k) -> bool {return string_view_type(a.key()).compare(k) < 0;});        
+                                      [](const key_value_type& a, const string_view_type& k) -> bool {return compare_key(a.key(), k) < 0;});        
             }
 
             if (it == members_.end())
@@ -984,12 +1041,12 @@ namespace jsoncons {
             if (hint != members_.end() && hint->key() <= name)
             {
                 it = std::lower_bound(hint,members_.end(), name, 
-                                      [](const key_value_type& a, const string_view_type& k) -> bool {return string_view_type(a.key()).compare(k) < 0;});        
+                                      [](const key_value_type& a, const string_view_type& k) -> bool {return compare_key(a.key(), k) < 0;});        
             }
             else
             {
                 it = std::lower_bound(members_.begin(),members_.end(), name, 
-                                      [](const key_value_type& a, const string_view_type& k) -> bool {return string_view_type(a.key()).compare(k) < 0;});        
+                                      [](const key_value_type& a, const string_view_type& k) -> bool {return compare_key(a.key(), k) < 0;});        
             }
 
             if (it == members_.end())
@@ -1019,12 +1076,12 @@ namespace jsoncons {
             if (hint != members_.end() && hint->key() <= name)
             {
                 it = std::lower_bound(hint,members_.end(), name, 
-                                      [](const key_value_type& a, const string_view_type& k) -> bool {return string_view_type(a.key()).compare(k) < 0;});        
+                                      [](const key_value_type& a, const string_view_type& k) -> bool {return compare_key(a.key(), k) < 0;});        
             }
             else
             {
                 it = std::lower_bound(members_.begin(),members_.end(), name, 
-                                      [](const key_value_type& a, const string_view_type& k) -> bool {return string_view_type(a.key()).compare(k) < 0;});        
+                                      [](const key_value_type& a, const string_view_type& k) -> bool {return compare_key(a.key(), k) < 0;});        
             }
 
             if (it == members_.end())
@@ -1063,7 +1120,7 @@ namespace jsoncons {
             for (; it != end; ++it)
             {
                 auto pos = std::lower_bound(members_.begin(),members_.end(), it->key(), 
-                                            [](const key_value_type& a, const string_view_type& k) -> bool {return string_view_type(a.key()).compare(k) < 0;});   
+                                            [](const key_value_type& a, const string_view_type& k) -> bool {return compare_key(a.key(), k) < 0;});   
                 if (pos == members_.end() )
                 {
                     members_.emplace_back(*it);
@@ -1093,12 +1150,12 @@ namespace jsoncons {
                 if (hint != members_.end() && hint->key() <= it->key())
                 {
                     pos = std::lower_bound(hint,members_.end(), it->key(), 
-                                          [](const key_value_type& a, const string_view_type& k) -> bool {return string_view_type(a.key()).compare(k) < 0;});        
+                                          [](const key_value_type& a, const string_view_type& k) -> bool {return compare_key(a.key(), k) < 0;});        
                 }
                 else
                 {
                     pos = std::lower_bound(members_.begin(),members_.end(), it->key(), 
-                                          [](const key_value_type& a, const string_view_type& k) -> bool {return string_view_type(a.key()).compare(k) < 0;});        
+                                          [](const key_value_type& a, const string_view_type& k) -> bool {return compare_key(a.key(), k) < 0;});        
                 }
                 if (pos == members_.end() )
                 {
@@ -1129,7 +1186,7 @@ namespace jsoncons {
             for (; it != end; ++it)
             {
                 auto pos = std::lower_bound(members_.begin(),members_.end(), it->key(), 
-                                            [](const key_value_type& a, const string_view_type& k) -> bool {return string_view_type(a.key()).compare(k) < 0;});   
+                                            [](const key_value_type& a, const string_view_type& k) -> bool {return compare_key(a.key(), k) < 0;});   
                 if (pos == members_.end() )
                 {
                     members_.emplace_back(*it);
@@ -1159,12 +1216,12 @@ namespace jsoncons {
                 if (hint != members_.end() && hint->key() <= it->key())
                 {
                     pos = std::lower_bound(hint,members_.end(), it->key(), 
-                                          [](const key_value_type& a, const string_view_type& k) -> bool {return string_view_type(a.key()).compare(k) < 0;});        
+                                          [](const key_value_type& a, const string_view_type& k) -> bool {return compare_key(a.key(), k) < 0;});        
                 }
                 else
                 {
                     pos = std::lower_bound(members_.begin(),members_.end(), it->key(), 
-                                          [](const key_value_type& a, const string_view_type& k) -> bool {return string_view_type(a.key()).compare(k) < 0;});        
+                                          [](const key_value_type& a, const string_view_type& k) -> bool {return compare_key(a.key(), k) < 0;});        
                 }
                 if (pos == members_.end() )
                 {
@@ -1435,7 +1492,7 @@ namespace jsoncons {
         iterator find(const string_view_type& name) noexcept
         {
             auto it = std::lower_bound(index_.begin(),index_.end(), name, 
-                                        [&](std::size_t i, const string_view_type& k) -> bool {return string_view_type(members_.at(i).key()).compare(k) < 0;});        
+                                        [&](std::size_t i, const string_view_type& k) -> bool {return compare_key(members_.at(i).key(), k) < 0;});        
             if (it != index_.end() && members_.at(*it).key() == name)
             {
                 return members_.begin() + *it;
@@ -1449,7 +1506,7 @@ namespace jsoncons {
         const_iterator find(const string_view_type& name) const noexcept
         {
             auto it = std::lower_bound(index_.begin(),index_.end(), name, 
-                                        [&](std::size_t i, const string_view_type& k) -> bool {return string_view_type(members_.at(i).key()).compare(k) < 0;});        
+                                        [&](std::size_t i, const string_view_type& k) -> bool {return compare_key(members_.at(i).key(), k) < 0;});        
             if (it != index_.end() && members_.at(*it).key() == name)
             {
                 return members_.begin() + *it;
@@ -1507,7 +1564,36 @@ namespace jsoncons {
             {
                 members_.emplace_back(convert(*s));
             }
+            end_unchecked();
+        }
+
+        template<class InputIt, class Convert>
+        void insert(sorted_unique_range_tag, InputIt first, InputIt last, Convert convert)
+        {
+            std::size_t count = std::distance(first,last);
+
+            members_.reserve(members_.size() + count);
+            for (auto s = first; s != last; ++s)
+            {
+                members_.emplace_back(convert(*s));
+            }
+
+            build_index();
+        }
+
+        // Appends a member without maintaining the key order, for building an object
+        // in place. Call end_unchecked() after the last member has been appended.
+        template <class... Args>
+        Json& emplace_back_unchecked(key_type&& name, Args&& ... args)
+        {
+            members_.emplace_back(std::move(name), std::forward<Args>(args)...);
+            return members_.back().value();
+        }
 
+        // Indexes the members appended by emplace_back_unchecked and releases unused
+        // capacity. Duplicate keys keep their first value.
+        void end_unchecked()
+        {
             build_index();
             auto last_unique = std::unique(index_.begin(), index_.end(),
                 [&](std::size_t a, std::size_t b) { return !(members_.at(a).key().compare(members_.at(b).key())); });
@@ -1530,21 +1616,15 @@ namespace jsoncons {
                     }
                 }
             }
+            members_.shrink_to_fit();
             build_index();
         }
 
-        template<class InputIt, class Convert>
-        void insert(sorted_unique_range_tag, InputIt first, InputIt last, Convert convert)
+        // Completes a copy of source whose members have been appended in order by 
+        // emplace_back_unchecked, by taking its index instead of building one
+        void copy_index_from(const json_object& source)
         {
-            std::size_t count = std::distance(first,last);
-
-            members_.reserve(members_.size() + count);
-            for (auto s = first; s != last; ++s)
-            {
-                members_.emplace_back(convert(*s));
-            }
-
-            build_index();
+            index_ = source.index_;
         }
 
         template <class T, class A=allocator_type>
@@ -1905,7 +1985,7 @@ namespace jsoncons {
             JSONCONS_ASSERT(pos <= index_.size());
 
             auto it = std::lower_bound(index_.begin(),index_.end(), key, 
-                                        [&](std::size_t i, const string_view_type& k) -> bool {return string_view_type(members_.at(i).key()).compare(k) < 0;});        
+                                        [&](std::size_t i, const string_view_type& k) -> bool {return compare_key(members_.at(i).key(), k) < 0;});        
 
             if (it == index_.end())
             {
@@ -1948,18 +2028,9 @@ namespace jsoncons {
 
             const size_t offset = pos2 - pos1;
             const size_t n = index_.size() - offset;
-            for (std::size_t i = 0; i < index_.size(); ++i)
-            {
-                if (offset == index_.size())
-                {
-                    index_.erase(index_.begin()+i,index_.end());
-                    i += offset;
-                }
-                else if (index_[i] >= pos1 && index_[i] < pos2)
-                {
-                    index_.erase(index_.begin()+i);
-                }
-            }
+            auto last = std::remove_if(index_.begin(), index_.end(),
+                                       [&](std::size_t i) -> bool {return i >= pos1 && i < pos2;});
+            index_.erase(last, index_.end());
             for (std::size_t i = 0; i < index_.size(); ++i)
             {
                 if (index_[i] >= pos2)
@@ -1985,6 +2056,640 @@ namespace jsoncons {
         json_object& operator=(const json_object&) = delete;
     };
 
+    // Hash indexed. With hash_key_order, members are kept sorted by key, as with sort_key_order,
+    // so finding a member is O(1) on average, but inserting a new one moves the members after it.
+    // With hash_preserve_key_order, members stay in insertion order, new members go at the hint
+    // and comparisons follow member order, as with preserve_key_order.
+    template <class KeyT,class Json>
+    class json_object<KeyT,Json,typename std::enable_if<std::is_same<typename Json::implementation_policy::key_order,hash_key_order>::value ||
+                                                        std::is_same<typename Json::implementation_policy::key_order,hash_preserve_key_order>::value>::type> : 
+        public allocator_holder<typename Json::allocator_type>
+    {
+    public:
+        using allocator_type = typename Json::allocator_type;
+        using char_type = typename Json::char_type;
+        using key_type = KeyT;
+        //using mapped_type = Json;
+        using string_view_type = typename Json::string_view_type;
+        using key_value_type = key_value<KeyT,Json>;
+    private:
+        using implementation_policy = typename Json::implementation_policy;
+        using key_value_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<key_value_type>;                       
+        using key_value_container_type = typename implementation_policy::template sequence_container_type<key_value_type,key_value_allocator_type>;
+        using index_type = jsoncons::detail::hash_index<allocator_type>;
+        using positional = std::integral_constant<bool,std::is_same<typename implementation_policy::key_order,hash_preserve_key_order>::value>;
+
+        key_value_container_type members_;
+        index_type index_;
+    public:
+        using iterator = typename key_value_container_type::iterator;
+        using const_iterator = typename key_value_container_type::const_iterator;
+
+        using allocator_holder<allocator_type>::get_allocator;
+
+        json_object()
+        {
+        }
+
+        explicit json_object(const allocator_type& alloc)
+            : allocator_holder<allocator_type>(alloc), 
+              members_(key_value_allocator_type(alloc)), 
+              index_(alloc)
+        {
+        }
+
+        json_object(const json_object& val)
+            : allocator_holder<allocator_type>(val.get_allocator()), 
+              members_(val.members_),
+              index_(val.index_)
+        {
+        }
+
+        json_object(json_object&& val)
+            : allocator_holder<allocator_type>(val.get_allocator()), 
+              members_(std::move(val.members_)),
+              index_(std::move(val.index_))
+        {
+        }
+
+        json_object(const json_object& val, const allocator_type& alloc) 
+            : allocator_holder<allocator_type>(alloc), 
+              members_(val.members_,key_value_allocator_type(alloc)),
+              index_(val.index_,alloc)
+        {
+        }
+
+        json_object(json_object&& val,const allocator_type& alloc) 
+            : allocator_holder<allocator_type>(alloc), 
+              members_(std::move(val.members_),key_value_allocator_type(alloc)),
+              index_(std::move(val.index_),alloc)
+        {
+        }
+
+        template<class InputIt>
+        json_object(InputIt first, InputIt last)
+        {
+            insert(first, last, get_key_value<KeyT,Json>());
+        }
+
+        template<class InputIt>
+        json_object(InputIt first, InputIt last, 
+                    const allocator_type& alloc)
+            : allocator_holder<allocator_type>(alloc), 
+              members_(key_value_allocator_type(alloc)), 
+              index_(alloc)
+        {
+            insert(first, last, get_key_value<KeyT,Json>());
+        }
+
+        json_object(std::initializer_list<std::pair<std::basic_string<char_type>,Json>> init, 
+                    const allocator_type& alloc = allocator_type())
+            : allocator_holder<allocator_type>(alloc), 
+              members_(key_value_allocator_type(alloc)), 
+              index_(alloc)
+        {
+            reserve(init.size());
+            for (auto& item : init)
+            {
+                insert_or_assign(item.first, item.second);
+            }
+        }
+
+        ~json_object() noexcept
+        {
+            destroy();
+        }
+
+        void swap(json_object& val) noexcept
+        {
+            members_.swap(val.members_);
+            index_.swap(val.index_);
+        }
+
+        iterator begin()
+        {
+            return members_.begin();
+        }
+
+        iterator end()
+        {
+            return members_.end();
+        }
+
+        const_iterator begin() const
+        {
+            return members_.begin();
+        }
+
+        const_iterator end() const
+        {
+            return members_.end();
+        }
+
+        std::size_t size() const {return members_.size();}
+
+        std::size_t capacity() const {return members_.capacity();}
+
+        void clear() 
+        {
+            members_.clear();
+            index_.clear();
+        }
+
+        void shrink_to_fit() 
+        {
+            for (std::size_t i = 0; i < members_.size(); ++i)
+            {
+                members_[i].shrink_to_fit();
+            }
+            members_.shrink_to_fit();
+            index_.shrink_to_fit();
+        }
+
+        void reserve(std::size_t n) 
+        {
+            members_.reserve(n);
+            index_.reserve(n);
+        }
+
+        Json& at(std::size_t i) 
+        {
+            if (i >= members_.size())
+            {
+                JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+            }
+            return members_[i].value();
+        }
+
+        const Json& at(std::size_t i) const 
+        {
+            if (i >= members_.size())
+            {
+                JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+            }
+            return members_[i].value();
+        }
+
+        iterator find(const string_view_type& name) noexcept
+        {
+            std::size_t pos = find_position(name, hash_of(name));
+            return pos == index_type::npos ? members_.end() : members_.begin() + pos;
+        }
+
+        const_iterator find(const string_view_type& name) const noexcept
+        {
+            std::size_t pos = find_position(name, hash_of(name));
+            return pos == index_type::npos ? members_.end() : members_.begin() + pos;
+        }
+
+        void erase(const_iterator pos) 
+        {
+            erase(pos, pos + 1);
+        }
+
+        void erase(const_iterator first, const_iterator last) 
+        {
+            std::size_t pos1 = first - members_.begin();
+            std::size_t pos2 = last - members_.begin();
+
+            if (pos1 < pos2 && pos2 <= members_.size())
+            {
+                index_.erase(pos1, pos2);
+    #if defined(JSONCONS_NO_ERASE_TAKING_CONST_ITERATOR)
+                iterator it1 = members_.begin() + pos1;
+                iterator it2 = members_.begin() + pos2;
+                members_.erase(it1,it2);
+    #else
+                members_.erase(first,last);
+    #endif
+            }
+        }
+
+        void erase(const string_view_type& name) 
+        {
+            uint32_t hash = hash_of(name);
+            std::size_t pos = find_position(name, hash);
+            if (pos != index_type::npos)
+            {
+                index_.erase_entry(hash, pos);
+                members_.erase(members_.begin() + pos);
+            }
+        }
+
+        // Duplicate keys keep their first value, as with the other key orders
+        template<class InputIt, class Convert>
+        void insert(InputIt first, InputIt last, Convert convert)
+        {
+            const std::size_t sorted_size = members_.size();
+            reserve(members_.size() + std::distance(first,last));
+            for (auto s = first; s != last; ++s)
+            {
+                key_value_type kv = convert(*s);
+                string_view_type name(kv.key());
+                uint32_t hash = hash_of(name);
+                if (find_position(name, hash) == index_type::npos)
+                {
+                    members_.emplace_back(std::move(kv));
+                    index_.insert_unique(hash, members_.size() - 1);
+                }
+            }
+            sort_appended(sorted_size, positional());
+        }
+
+        template<class InputIt, class Convert>
+        void insert(sorted_unique_range_tag, InputIt first, InputIt last, Convert convert)
+        {
+            insert(first, last, convert);
+        }
+
+        // Appends a member without maintaining the key order, for building an object
+        // in place. Call end_unchecked() after the last member has been appended.
+        template <class... Args>
+        Json& emplace_back_unchecked(key_type&& name, Args&& ... args)
+        {
+            members_.emplace_back(std::move(name), std::forward<Args>(args)...);
+            return members_.back().value();
+        }
+
+        // Sorts the members appended by emplace_back_unchecked with hash_key_order, indexes them,
+        // and releases unused capacity. Duplicate keys keep their first value.
+        void end_unchecked()
+        {
+            end_unchecked(positional());
+            members_.shrink_to_fit();
+        }
+
+        // Completes a copy of source whose members have been appended in order by 
+        // emplace_back_unchecked, by taking its index instead of building one
+        void copy_index_from(const json_object& source)
+        {
+            index_ = source.index_;
+        }
+
+        // insert_or_assign
+
+        template <class T, class A=allocator_type>
+        typename std::enable_if<jsoncons::detail::is_stateless<A>::value,std::pair<iterator,bool>>::type
+        insert_or_assign(const string_view_type& name, T&& value)
+        {
+            uint32_t hash = hash_of(name);
+            std::size_t pos = find_position(name, hash);
+            if (pos == index_type::npos)
+            {
+                index_.reserve(members_.size() + 1);
+                members_.emplace_back(key_type(name.begin(),name.end()), 
+                                      std::forward<T>(value));
+                return std::make_pair(place_back(hash, positional()), true);
+            }
+            else
+            {
+                auto it = members_.begin() + pos;
+                it->value(Json(std::forward<T>(value)));
+                return std::make_pair(it, false);
+            }
+        }
+
+        template <class T, class A=allocator_type>
+        typename std::enable_if<!jsoncons::detail::is_stateless<A>::value,std::pair<iterator,bool>>::type
+        insert_or_assign(const string_view_type& name, T&& value)
+        {
+            uint32_t hash = hash_of(name);
+            std::size_t pos = find_position(name, hash);
+            if (pos == index_type::npos)
+            {
+                index_.reserve(members_.size() + 1);
+                members_.emplace_back(key_type(name.begin(),name.end(), get_allocator()), 
+                                      std::forward<T>(value),get_allocator());
+                return std::make_pair(place_back(hash, positional()), true);
+            }
+            else
+            {
+                auto it = members_.begin() + pos;
+                it->value(Json(std::forward<T>(value),get_allocator()));
+                return std::make_pair(it, false);
+            }
+        }
+
+        template <class T>
+        iterator insert_or_assign(iterator hint, const string_view_type& name, T&& value)
+        {
+            std::size_t pos = hint - members_.begin();
+            auto result = insert_or_assign(name, std::forward<T>(value));
+            return result.second ? move_back_to(pos, result.first, positional()) : result.first;
+        }
+
+        // try_emplace
+
+        template <class A=allocator_type, class... Args>
+        typename std::enable_if<jsoncons::detail::is_stateless<A>::value,std::pair<iterator,bool>>::type
+        try_emplace(const string_view_type& name, Args&&... args)
+        {
+            uint32_t hash = hash_of(name);
+            std::size_t pos = find_position(name, hash);
+            if (pos == index_type::npos)
+            {
+                index_.reserve(members_.size() + 1);
+                members_.emplace_back(key_type(name.begin(),name.end()), 
+                                      std::forward<Args>(args)...);
+                return std::make_pair(place_back(hash, positional()), true);
+            }
+            else
+            {
+                return std::make_pair(members_.begin() + pos, false);
+            }
+        }
+
+        template <class A=allocator_type, class... Args>
+        typename std::enable_if<!jsoncons::detail::is_stateless<A>::value,std::pair<iterator,bool>>::type
+        try_emplace(const string_view_type& name, Args&&... args)
+        {
+            uint32_t hash = hash_of(name);
+            std::size_t pos = find_position(name, hash);
+            if (pos == index_type::npos)
+            {
+                index_.reserve(members_.size() + 1);
+                members_.emplace_back(key_type(name.begin(),name.end(), get_allocator()), 
+                                      std::forward<Args>(args)...);
+                return std::make_pair(place_back(hash, positional()), true);
+            }
+            else
+            {
+                return std::make_pair(members_.begin() + pos, false);
+            }
+        }
+
+        template <class... Args>
+        iterator try_emplace(iterator hint, const string_view_type& name, Args&&... args)
+        {
+            std::size_t pos = hint - members_.begin();
+            auto result = try_emplace(name, std::forward<Args>(args)...);
+            return result.second ? move_back_to(pos, result.first, positional()) : result.first;
+        }
+
+        // merge
+
+        void merge(const json_object& source)
+        {
+            reserve(members_.size() + source.size());
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                try_emplace(it->key(),it->value());
+            }
+        }
+
+        void merge(json_object&& source)
+        {
+            reserve(members_.size() + source.size());
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                try_emplace(it->key(),std::move(it->value()));
+            }
+        }
+
+        void merge(iterator hint, const json_object& source)
+        {
+            std::size_t pos = hint - members_.begin();
+            reserve(members_.size() + source.size());
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                hint = try_emplace(members_.begin() + pos, it->key(),it->value());
+                if (static_cast<std::size_t>(hint - members_.begin()) == pos)
+                {
+                    ++pos;
+                }
+            }
+        }
+
+        void merge(iterator hint, json_object&& source)
+        {
+            std::size_t pos = hint - members_.begin();
+            reserve(members_.size() + source.size());
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                hint = try_emplace(members_.begin() + pos, it->key(),std::move(it->value()));
+                if (static_cast<std::size_t>(hint - members_.begin()) == pos)
+                {
+                    ++pos;
+                }
+            }
+        }
+
+        // merge_or_update
+
+        void merge_or_update(const json_object& source)
+        {
+            reserve(members_.size() + source.size());
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                insert_or_assign(it->key(),it->value());
+            }
+        }
+
+        void merge_or_update(json_object&& source)
+        {
+            reserve(members_.size() + source.size());
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                insert_or_assign(it->key(),std::move(it->value()));
+            }
+        }
+
+        void merge_or_update(iterator hint, const json_object& source)
+        {
+            std::size_t pos = hint - members_.begin();
+            reserve(members_.size() + source.size());
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                hint = insert_or_assign(members_.begin() + pos, it->key(),it->value());
+                if (static_cast<std::size_t>(hint - members_.begin()) == pos)
+                {
+                    ++pos;
+                }
+            }
+        }
+
+        void merge_or_update(iterator hint, json_object&& source)
+        {
+            std::size_t pos = hint - members_.begin();
+            reserve(members_.size() + source.size());
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                hint = insert_or_assign(members_.begin() + pos, it->key(),std::move(it->value()));
+                if (static_cast<std::size_t>(hint - members_.begin()) == pos)
+                {
+                    ++pos;
+                }
+            }
+        }
+
+        bool operator==(const json_object& rhs) const
+        {
+            return equals(rhs, positional());
+        }
+
+        bool operator<(const json_object& rhs) const
+        {
+            return members_ < rhs.members_;
+        }
+    private:
+
+        // Equal when they have the same members, in any order
+        bool equals(const json_object& rhs, std::false_type) const
+        {
+            if (members_.size() != rhs.members_.size())
+            {
+                return false;
+            }
+            for (const auto& kv : members_)
+            {
+                auto it = rhs.find(kv.key());
+                if (it == rhs.end() || !(it->value() == kv.value()))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool equals(const json_object& rhs, std::true_type) const
+        {
+            return members_ == rhs.members_;
+        }
+
+
+        // Indexes a new member that has been appended, with hash_key_order after moving it into place
+        iterator place_back(uint32_t hash, std::true_type)
+        {
+            index_.insert_unique(hash, members_.size() - 1);
+            return members_.end() - 1;
+        }
+
+        iterator place_back(uint32_t hash, std::false_type)
+        {
+            auto last = members_.end() - 1;
+            auto it = std::lower_bound(members_.begin(), last, *last,
+                                       [](const key_value_type& a, const key_value_type& b) -> bool {return a.key().compare(b.key()) < 0;});
+            std::size_t pos = it - members_.begin();
+            if (it != last)
+            {
+                key_value_type member(std::move(*last));
+                std::move_backward(it, last, members_.end());
+                *it = std::move(member);
+            }
+            index_.insert_at(hash, pos);
+            return members_.begin() + pos;
+        }
+
+        // A new member was inserted at it, with hash_preserve_key_order it goes at pos
+        iterator move_back_to(std::size_t pos, iterator it, std::true_type)
+        {
+            if (pos + 1 < members_.size())
+            {
+                std::rotate(members_.begin() + pos, members_.end() - 1, members_.end());
+                index_.move_back_to(pos);
+                return members_.begin() + pos;
+            }
+            return it;
+        }
+
+        iterator move_back_to(std::size_t, iterator it, std::false_type)
+        {
+            return it;
+        }
+
+        void sort_appended(std::size_t, std::true_type)
+        {
+        }
+
+        // Sorts the members appended after the first sorted_size, merges them in, and reindexes
+        void sort_appended(std::size_t sorted_size, std::false_type)
+        {
+            if (sorted_size == members_.size())
+            {
+                return;
+            }
+            auto less = [](const key_value_type& a, const key_value_type& b) -> bool {return a.key().compare(b.key()) < 0;};
+            auto mid = members_.begin() + sorted_size;
+            std::sort(mid, members_.end(), less);
+            std::inplace_merge(members_.begin(), mid, members_.end(), less);
+            reindex();
+        }
+
+        void reindex()
+        {
+            index_.reset();
+            index_.reserve(members_.size());
+            for (std::size_t i = 0; i < members_.size(); ++i)
+            {
+                string_view_type name(members_[i].key());
+                index_.insert_unique(hash_of(name), i);
+            }
+        }
+
+        // Keeps the first of duplicate keys, in the order they were appended
+        void end_unchecked(std::true_type)
+        {
+            index_.clear();
+            index_.reserve(members_.size());
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < members_.size(); ++i)
+            {
+                string_view_type name(members_[i].key());
+                uint32_t hash = hash_of(name);
+                if (find_position(name, hash) == index_type::npos)
+                {
+                    if (count != i)
+                    {
+                        members_[count] = std::move(members_[i]);
+                    }
+                    index_.insert_unique(hash, count);
+                    ++count;
+                }
+            }
+            members_.erase(members_.begin() + count, members_.end());
+        }
+
+        // Sorts stably, so that the first of duplicate keys is kept, and indexes once
+        void end_unchecked(std::false_type)
+        {
+            std::stable_sort(members_.begin(), members_.end(),
+                             [](const key_value_type& a, const key_value_type& b) -> bool {return a.key().compare(b.key()) < 0;});
+            auto last_unique = std::unique(members_.begin(), members_.end(),
+                                           [](const key_value_type& a, const key_value_type& b) -> bool {return !(a.key().compare(b.key()));});
+            members_.erase(last_unique, members_.end());
+            reindex();
+        }
+
+        static uint32_t hash_of(const string_view_type& name)
+        {
+            return jsoncons::detail::hash_key(name.data(), name.size());
+        }
+
+        std::size_t find_position(const string_view_type& name, uint32_t hash) const
+        {
+            return index_.find(hash, [&](std::size_t pos) -> bool {return members_[pos].key() == name;});
+        }
+
+        void destroy() noexcept
+        {
+            if (!members_.empty())
+            {
+                json_array<Json> temp(get_allocator());
+
+                for (auto&& kv : members_)
+                {
+                    if (kv.value().size() > 0)
+                    {
+                        temp.emplace_back(std::move(kv.value()));
+                        assert(kv.value().size() == 0);
+                    }
+                }
+            }
+        }
+
+        json_object& operator=(const json_object&) = delete;
+    };
+
 } // namespace jsoncons
 
 #endif
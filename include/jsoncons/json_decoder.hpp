@@ -200,7 +200,7 @@ private:
         const size_t count = item_stack_.size() - (structure_index + 1);
         auto first = item_stack_.begin() + (structure_index+1);
         auto last = first + count;
-        item_stack_[structure_index].value_.object_value().insert(
+        item_stack_[structure_index].value_.object_value_unchecked().insert(
             std::make_move_iterator(first),
             std::make_move_iterator(last),
             [](stack_item&& val){return key_value_type(std::move(val.name_), std::move(val.value_));}
@@ -236,7 +236,7 @@ private:
         const size_t container_index = structure_stack_.back().container_index_;
         JSONCONS_ASSERT(item_stack_.size() > container_index);
 
-        auto& container = item_stack_[container_index].value_;
+        auto& container = item_stack_[container_index].value_.array_value_unchecked();
 
         const size_t size = item_stack_.size() - (container_index + 1);
         //std::cout << "size on item stack: " << size << "\n";
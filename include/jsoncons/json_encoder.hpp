@@ -23,6 +23,7 @@
 #include <jsoncons/json_visitor.hpp>
 #include <jsoncons/sink.hpp>
 #include <jsoncons/detail/write_number.hpp>
+#include <jsoncons/detail/simd_scan.hpp>
 
 namespace jsoncons { 
 namespace detail {
@@ -39,6 +40,32 @@ namespace detail {
         return cp >= 0x80;
     }
 
+    // Writes a backslash followed by c
+    template <class Sink>
+    void write_escape(typename Sink::value_type c, Sink& sink)
+    {
+        sink_window<Sink,2> window(sink, 2);
+        typename Sink::value_type* p = window.data();
+        p[0] = '\\';
+        p[1] = c;
+        window.commit(2);
+    }
+
+    // Writes \uXXXX for a code unit of at most 0xFFFF
+    template <class Sink>
+    void write_unicode_escape(uint32_t cu, Sink& sink)
+    {
+        sink_window<Sink,6> window(sink, 6);
+        typename Sink::value_type* p = window.data();
+        p[0] = '\\';
+        p[1] = 'u';
+        p[2] = jsoncons::detail::to_hex_character(cu >> 12 & 0x000F);
+        p[3] = jsoncons::detail::to_hex_character(cu >> 8 & 0x000F);
+        p[4] = jsoncons::detail::to_hex_character(cu >> 4 & 0x000F);
+        p[5] = jsoncons::detail::to_hex_character(cu & 0x000F);
+        window.commit(6);
+    }
+
     template <class CharT, class Sink>
     std::size_t escape_string(const CharT* s, std::size_t length,
                          bool escape_all_non_ascii, bool escape_solidus,
@@ -49,49 +76,54 @@ namespace detail {
         const CharT* end = s + length;
         for (const CharT* it = begin; it != end; ++it)
         {
+            // Copy the run of characters that need no escaping in one append
+            const CharT* run_end = find_escape_special(it, end, escape_all_non_ascii, escape_solidus);
+            if (run_end != it)
+            {
+                sink.append(it, static_cast<std::size_t>(run_end - it));
+                count += static_cast<std::size_t>(run_end - it);
+                it = run_end;
+                if (it == end)
+                {
+                    break;
+                }
+            }
+
             CharT c = *it;
             switch (c)
             {
                 case '\\':
-                    sink.push_back('\\');
-                    sink.push_back('\\');
+                    write_escape('\\', sink);
                     count += 2;
                     break;
                 case '"':
-                    sink.push_back('\\');
-                    sink.push_back('\"');
+                    write_escape('\"', sink);
                     count += 2;
                     break;
                 case '\b':
-                    sink.push_back('\\');
-                    sink.push_back('b');
+                    write_escape('b', sink);
                     count += 2;
                     break;
                 case '\f':
-                    sink.push_back('\\');
-                    sink.push_back('f');
+                    write_escape('f', sink);
                     count += 2;
                     break;
                 case '\n':
-                    sink.push_back('\\');
-                    sink.push_back('n');
+                    write_escape('n', sink);
                     count += 2;
                     break;
                 case '\r':
-                    sink.push_back('\\');
-                    sink.push_back('r');
+                    write_escape('r', sink);
                     count += 2;
                     break;
                 case '\t':
-                    sink.push_back('\\');
-                    sink.push_back('t');
+                    write_escape('t', sink);
                     count += 2;
                     break;
                 default:
                     if (escape_solidus && c == '/')
                     {
-                        sink.push_back('\\');
-                        sink.push_back('/');
+                        write_escape('/', sink);
                         count += 2;
                     }
                     else if (is_control_character(c) || escape_all_non_ascii)
@@ -112,28 +144,13 @@ namespace detail {
                                 uint32_t first = (cp >> 10) + 0xD800;
                                 uint32_t second = ((cp & 0x03FF) + 0xDC00);
 
-                                sink.push_back('\\');
-                                sink.push_back('u');
-                                sink.push_back(jsoncons::detail::to_hex_character(first >> 12 & 0x000F));
-                                sink.push_back(jsoncons::detail::to_hex_character(first >> 8 & 0x000F));
-                                sink.push_back(jsoncons::detail::to_hex_character(first >> 4 & 0x000F));
-                                sink.push_back(jsoncons::detail::to_hex_character(first & 0x000F));
-                                sink.push_back('\\');
-                                sink.push_back('u');
-                                sink.push_back(jsoncons::detail::to_hex_character(second >> 12 & 0x000F));
-                                sink.push_back(jsoncons::detail::to_hex_character(second >> 8 & 0x000F));
-                                sink.push_back(jsoncons::detail::to_hex_character(second >> 4 & 0x000F));
-                                sink.push_back(jsoncons::detail::to_hex_character(second & 0x000F));
+                                write_unicode_escape(first, sink);
+                                write_unicode_escape(second, sink);
                                 count += 12;
                             }
                             else
                             {
-                                sink.push_back('\\');
-                                sink.push_back('u');
-                                sink.push_back(jsoncons::detail::to_hex_character(cp >> 12 & 0x000F));
-                                sink.push_back(jsoncons::detail::to_hex_character(cp >> 8 & 0x000F));
-                                sink.push_back(jsoncons::detail::to_hex_character(cp >> 4 & 0x000F));
-                                sink.push_back(jsoncons::detail::to_hex_character(cp & 0x000F));
+                                write_unicode_escape(cp, sink);
                                 count += 6;
                             }
                         }
@@ -216,6 +233,17 @@ namespace detail {
     private:
         enum class container_type {object, array};
 
+        enum class line_break {none, break_line, break_line_if_over_limit, break_line_if_multi_line, new_line_if_over_limit};
+
+        // How an object or array nested in a container is split into lines, 
+        // decided once from the options
+        struct nesting_rule
+        {
+            line_split_kind line_splits;
+            bool indent_once;
+            line_break before;
+        };
+
         class encoding_context
         {
             container_type type_;
@@ -225,11 +253,12 @@ namespace detail {
             bool new_line_after_;
             std::size_t begin_pos_;
             std::size_t data_pos_;
+            const nesting_rule* nesting_rules_;
         public:
             encoding_context(container_type type, line_split_kind split_lines, bool indent_once,
-                                  std::size_t begin_pos, std::size_t data_pos)
+                                  std::size_t begin_pos, std::size_t data_pos, const nesting_rule* nesting_rules)
                : type_(type), count_(0), line_splits_(split_lines), indent_before_(indent_once), new_line_after_(false),
-                 begin_pos_(begin_pos), data_pos_(data_pos)
+                 begin_pos_(begin_pos), data_pos_(data_pos), nesting_rules_(nesting_rules)
             {
             }
 
@@ -301,6 +330,11 @@ namespace detail {
                 return count_ == 0 ? indent_before_ : false;
             }
 
+            // The rule for an object or array nested in this container
+            const nesting_rule& nesting(container_type type) const
+            {
+                return nesting_rules_[static_cast<int>(type)];
+            }
         };
         typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<encoding_context> encoding_context_allocator_type;
 
@@ -311,6 +345,9 @@ namespace detail {
         std::vector<encoding_context,encoding_context_allocator_type> stack_;
         int indent_amount_;
         std::size_t column_;
+        nesting_rule nesting_rules_[2][2]; // by the type of the container, then of the nested container
+        std::basic_string<CharT> new_line_str_; // a comma, the new line characters, then spaces
+        std::size_t new_line_length_; // the length of the new line characters
         std::basic_string<CharT> colon_str_;
         std::basic_string<CharT> comma_str_;
         std::basic_string<CharT> open_object_brace_str_;
@@ -338,6 +375,7 @@ namespace detail {
              stack_(alloc),
              indent_amount_(0), 
              column_(0),
+             new_line_length_(options.new_line_chars().length()),
              nesting_depth_(0)
         {
             switch (options.spaces_around_colon())
@@ -390,6 +428,23 @@ namespace detail {
                 open_array_bracket_str_.push_back('[');
                 close_array_bracket_str_.push_back(']');
             }
+
+            const int object = static_cast<int>(container_type::object);
+            const int array = static_cast<int>(container_type::array);
+            line_split_kind splits = options.object_object_line_splits();
+            nesting_rules_[object][object] = {splits, false, 
+                splits == line_split_kind::multi_line ? line_break::none : line_break::break_line_if_over_limit};
+            splits = options.object_array_line_splits();
+            nesting_rules_[object][array] = {splits, splits != line_split_kind::same_line, line_break::none};
+            splits = options.array_object_line_splits();
+            nesting_rules_[array][object] = {splits, false, 
+                splits == line_split_kind::same_line ? line_break::new_line_if_over_limit : line_break::break_line};
+            splits = options.array_array_line_splits();
+            nesting_rules_[array][array] = {splits, false, 
+                splits == line_split_kind::same_line ? line_break::break_line_if_multi_line : line_break::break_line};
+
+            new_line_str_ = comma_str_ + options.new_line_chars();
+            new_line_str_.append(8*options.indent_size(), ' ');
         }
 
         ~basic_json_encoder() noexcept
@@ -417,64 +472,16 @@ namespace detail {
                 ec = json_errc::max_nesting_depth_exceeded;
                 return false;
             } 
-            if (!stack_.empty() && stack_.back().is_array() && stack_.back().count() > 0)
-            {
-                sink_.append(comma_str_.data(),comma_str_.length());
-                column_ += comma_str_.length();
-            }
-
             if (!stack_.empty()) // object or array
             {
-                if (stack_.back().is_object())
-                {
-                    switch (options_.object_object_line_splits())
-                    {
-                        case line_split_kind::same_line:
-                            if (column_ >= options_.line_length_limit())
-                            {
-                                break_line();
-                            }
-                            break;
-                        case line_split_kind::new_line:
-                            if (column_ >= options_.line_length_limit())
-                            {
-                                break_line();
-                            }
-                            break;
-                        default: // multi_line
-                            break;
-                    }
-                    stack_.emplace_back(container_type::object,options_.object_object_line_splits(), false,
-                                        column_, column_+open_object_brace_str_.length());
-                }
-                else // array
-                {
-                    switch (options_.array_object_line_splits())
-                    {
-                        case line_split_kind::same_line:
-                            if (column_ >= options_.line_length_limit())
-                            {
-                                //stack_.back().new_line_after(true);
-                                new_line();
-                            }
-                            break;
-                        case line_split_kind::new_line:
-                            stack_.back().new_line_after(true);
-                            new_line();
-                            break;
-                        default: // multi_line
-                            stack_.back().new_line_after(true);
-                            new_line();
-                            break;
-                    }
-                    stack_.emplace_back(container_type::object,options_.array_object_line_splits(), false,
-                                        column_, column_+open_object_brace_str_.length());
-                }
+                begin_nested(container_type::object, open_object_brace_str_.length(), 
+                             stack_.back().is_array() && stack_.back().count() > 0);
             }
             else 
             {
                 stack_.emplace_back(container_type::object, line_split_kind::multi_line, false,
-                                    column_, column_+open_object_brace_str_.length());
+                                    column_, column_+open_object_brace_str_.length(), 
+                                    nesting_rules_[static_cast<int>(container_type::object)]);
             }
             indent();
             
@@ -508,66 +515,16 @@ namespace detail {
                 ec = json_errc::max_nesting_depth_exceeded;
                 return false;
             } 
-            if (!stack_.empty() && stack_.back().is_array() && stack_.back().count() > 0)
-            {
-                sink_.append(comma_str_.data(),comma_str_.length());
-                column_ += comma_str_.length();
-            }
             if (!stack_.empty())
             {
-                if (stack_.back().is_object())
-                {
-                    switch (options_.object_array_line_splits())
-                    {
-                        case line_split_kind::same_line:
-                            stack_.emplace_back(container_type::array,options_.object_array_line_splits(),false,
-                                                column_, column_ + open_array_bracket_str_.length());
-                            break;
-                        case line_split_kind::new_line:
-                        {
-                            stack_.emplace_back(container_type::array,options_.object_array_line_splits(),true,
-                                                column_, column_+open_array_bracket_str_.length());
-                            break;
-                        }
-                        default: // multi_line
-                            stack_.emplace_back(container_type::array,options_.object_array_line_splits(),true,
-                                                column_, column_+open_array_bracket_str_.length());
-                            break;
-                    }
-                }
-                else // array
-                {
-                    switch (options_.array_array_line_splits())
-                    {
-                        case line_split_kind::same_line:
-                            if (stack_.back().is_multi_line())
-                            {
-                                stack_.back().new_line_after(true);
-                                new_line();
-                            }
-                            stack_.emplace_back(container_type::array,options_.array_array_line_splits(), false,
-                                                column_, column_+open_array_bracket_str_.length());
-                            break;
-                        case line_split_kind::new_line:
-                            stack_.back().new_line_after(true);
-                            new_line();
-                            stack_.emplace_back(container_type::array,options_.array_array_line_splits(), false,
-                                                column_, column_+open_array_bracket_str_.length());
-                            break;
-                        default: // multi_line
-                            stack_.back().new_line_after(true);
-                            new_line();
-                            stack_.emplace_back(container_type::array,options_.array_array_line_splits(), false,
-                                                column_, column_+open_array_bracket_str_.length());
-                            //new_line();
-                            break;
-                    }
-                }
+                begin_nested(container_type::array, open_array_bracket_str_.length(), 
+                             stack_.back().is_array() && stack_.back().count() > 0);
             }
             else 
             {
                 stack_.emplace_back(container_type::array, line_split_kind::multi_line, false,
-                                    column_, column_+open_array_bracket_str_.length());
+                                    column_, column_+open_array_bracket_str_.length(),
+                                    nesting_rules_[static_cast<int>(container_type::array)]);
             }
             indent();
             sink_.append(open_array_bracket_str_.data(), open_array_bracket_str_.length());
@@ -595,21 +552,19 @@ namespace detail {
         bool visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
         {
             JSONCONS_ASSERT(!stack_.empty());
-            if (stack_.back().count() > 0)
-            {
-                sink_.append(comma_str_.data(),comma_str_.length());
-                column_ += comma_str_.length();
-            }
-
             if (stack_.back().is_multi_line())
             {
                 stack_.back().new_line_after(true);
-                new_line();
+                new_line(static_cast<std::size_t>(indent_amount_), stack_.back().count() > 0);
             }
-            else if (stack_.back().count() > 0 && column_ >= options_.line_length_limit())
+            else if (stack_.back().count() > 0)
             {
-                //stack_.back().new_line_after(true);
-                new_line(stack_.back().data_pos());
+                sink_.append(comma_str_.data(),comma_str_.length());
+                column_ += comma_str_.length();
+                if (column_ >= options_.line_length_limit())
+                {
+                    new_line(stack_.back().data_pos());
+                }
             }
 
             if (stack_.back().count() == 0)
@@ -824,8 +779,7 @@ namespace detail {
             }
             else
             {
-                std::size_t length = fp_(value, sink_);
-                column_ += length;
+                fp_(value, sink_);
             }
 
             end_value();
@@ -909,15 +863,15 @@ namespace detail {
         {
             if (!stack_.empty())
             {
-                if (stack_.back().count() > 0)
-                {
-                    sink_.append(comma_str_.data(),comma_str_.length());
-                    column_ += comma_str_.length();
-                }
                 if (stack_.back().is_multi_line() || stack_.back().is_indent_once())
                 {
                     stack_.back().new_line_after(true);
-                    new_line();
+                    new_line(static_cast<std::size_t>(indent_amount_), stack_.back().count() > 0);
+                }
+                else if (stack_.back().count() > 0)
+                {
+                    sink_.append(comma_str_.data(),comma_str_.length());
+                    column_ += comma_str_.length();
                 }
             }
         }
@@ -1007,23 +961,63 @@ namespace detail {
             indent_amount_ -= static_cast<int>(options_.indent_size());
         }
 
-        void new_line()
+        // Writes the comma before a nested object or array, if any, and breaks the line before it
+        // as its nesting rule says
+        void begin_nested(container_type type, std::size_t open_length, bool comma)
         {
-            sink_.append(options_.new_line_chars().data(),options_.new_line_chars().length());
-            for (int i = 0; i < indent_amount_; ++i)
+            encoding_context& parent = stack_.back();
+            const nesting_rule& rule = parent.nesting(type);
+            std::size_t column = comma ? column_ + comma_str_.length() : column_;
+
+            bool is_break;
+            switch (rule.before)
             {
-                sink_.push_back(' ');
+                case line_break::break_line:
+                    is_break = true;
+                    break;
+                case line_break::break_line_if_over_limit:
+                case line_break::new_line_if_over_limit:
+                    is_break = column >= options_.line_length_limit();
+                    break;
+                case line_break::break_line_if_multi_line:
+                    is_break = parent.is_multi_line();
+                    break;
+                default:
+                    is_break = false;
+                    break;
             }
-            column_ = indent_amount_;
+            if (is_break)
+            {
+                if (rule.before != line_break::new_line_if_over_limit)
+                {
+                    parent.new_line_after(true);
+                }
+                new_line(static_cast<std::size_t>(indent_amount_), comma);
+            }
+            else if (comma)
+            {
+                sink_.append(comma_str_.data(),comma_str_.length());
+                column_ = column;
+            }
+            stack_.emplace_back(type, rule.line_splits, rule.indent_once,
+                                column_, column_+open_length, nesting_rules_[static_cast<int>(type)]);
+        }
+
+        void new_line()
+        {
+            new_line(static_cast<std::size_t>(indent_amount_));
         }
 
-        void new_line(std::size_t len)
+        // Writes a comma if asked, the new line characters and len spaces in one append
+        void new_line(std::size_t len, bool comma = false)
         {
-            sink_.append(options_.new_line_chars().data(),options_.new_line_chars().length());
-            for (std::size_t i = 0; i < len; ++i)
+            std::size_t offset = comma ? 0 : comma_str_.length();
+            std::size_t length = comma_str_.length() + new_line_length_ + len;
+            if (length > new_line_str_.length())
             {
-                sink_.push_back(' ');
+                new_line_str_.resize((std::max)(length, 2*new_line_str_.length()), ' ');
             }
+            sink_.append(new_line_str_.data() + offset, length - offset);
             column_ = len;
         }
 
@@ -0,0 +1,191 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_HASH_HPP
+#define JSONCONS_JSON_HASH_HPP
+
+#include <cstddef> // std::size_t
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <vector>
+#include <functional> // std::hash
+#include <type_traits> // std::enable_if, std::make_unsigned
+#include <jsoncons/basic_json.hpp>
+
+namespace jsoncons {
+namespace detail {
+
+    // The finalizer of splitmix64
+    inline uint64_t mix_hash(uint64_t h) noexcept
+    {
+        h ^= h >> 30;
+        h *= 0xbf58476d1ce4e5b9ULL;
+        h ^= h >> 27;
+        h *= 0x94d049bb133111ebULL;
+        h ^= h >> 31;
+        return h;
+    }
+
+    // Order dependent: combine_hash(combine_hash(s, a), b) differs from combine_hash(combine_hash(s, b), a)
+    inline uint64_t combine_hash(uint64_t seed, uint64_t h) noexcept
+    {
+        return mix_hash(seed + 0x9e3779b97f4a7c15ULL + h);
+    }
+
+    // 64 bit FNV-1a over code units
+    template <class CharT>
+    uint64_t hash_chars(const CharT* s, std::size_t length) noexcept
+    {
+        using unsigned_type = typename std::make_unsigned<CharT>::type;
+
+        uint64_t h = 14695981039346656037ULL;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            h ^= static_cast<uint64_t>(static_cast<unsigned_type>(s[i]));
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }
+
+    // Numbers of different storage that compare equal, like 1 and 1.0, convert to the
+    // same double, and so hash the same
+    inline uint64_t hash_number(double value) noexcept
+    {
+        if (value == 0)
+        {
+            value = 0; // -0.0 == 0.0
+        }
+        uint64_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(double));
+        return mix_hash(bits);
+    }
+
+    enum class hash_seed : uint64_t {null_value=1,false_value,true_value,number_value,string_value,byte_string_value,array_value,object_value};
+
+    template <class Json>
+    uint64_t leaf_hash(const Json& val)
+    {
+        switch (val.storage())
+        {
+            case storage_kind::null_value:
+                return mix_hash(static_cast<uint64_t>(hash_seed::null_value));
+            case storage_kind::bool_value:
+                return mix_hash(static_cast<uint64_t>(val.as_bool() ? hash_seed::true_value : hash_seed::false_value));
+            case storage_kind::int64_value:
+            case storage_kind::uint64_value:
+            case storage_kind::half_value:
+            case storage_kind::double_value:
+                return hash_number(val.as_double());
+            case storage_kind::short_string_value:
+            case storage_kind::long_string_value:
+            {
+                auto sv = val.as_string_view();
+                return combine_hash(static_cast<uint64_t>(hash_seed::string_value), hash_chars(sv.data(), sv.length()));
+            }
+            case storage_kind::byte_string_value:
+            {
+                auto bytes = val.as_byte_string_view();
+                return combine_hash(static_cast<uint64_t>(hash_seed::byte_string_value), hash_chars(bytes.data(), bytes.size()));
+            }
+            case storage_kind::array_value:
+                return combine_hash(static_cast<uint64_t>(hash_seed::array_value), 0);
+            default: // empty object
+                return combine_hash(static_cast<uint64_t>(hash_seed::object_value), 0);
+        }
+    }
+
+} // namespace detail
+
+    // A hash of the structure and contents of a value that is consistent with operator==:
+    // values that compare equal hash the same, whatever their storage and semantic tags.
+    // Array elements are hashed in order. Object members are hashed in any order, which
+    // suits every key order policy, since each object holds its keys once.
+    //
+    // Nested arrays and objects are walked with an explicit stack.
+
+    template <class Json>
+    typename std::enable_if<is_basic_json<Json>::value,std::size_t>::type
+    structural_hash(const Json& val)
+    {
+        struct frame
+        {
+            const Json* container;
+            std::size_t index;
+            uint64_t acc;
+        };
+
+        std::vector<frame> stack;
+        const Json* current = &val;
+        uint64_t h = 0;
+        while (true)
+        {
+            if ((current->is_array() || current->is_object()) && current->size() > 0)
+            {
+                stack.push_back(frame{current, 0, 0});
+            }
+            else
+            {
+                h = jsoncons::detail::leaf_hash(*current);
+                if (stack.empty())
+                {
+                    return static_cast<std::size_t>(h);
+                }
+            }
+
+            // Fold finished values into their containers until one has a value left to hash
+            current = nullptr;
+            while (current == nullptr)
+            {
+                frame& f = stack.back();
+                if (f.index > 0)
+                {
+                    if (f.container->is_array())
+                    {
+                        f.acc = jsoncons::detail::combine_hash(f.acc, h);
+                    }
+                    else
+                    {
+                        auto key = (f.container->object_range().begin() + (f.index-1))->key();
+                        f.acc += jsoncons::detail::combine_hash(jsoncons::detail::hash_chars(key.data(), key.length()), h);
+                    }
+                }
+                if (f.index < f.container->size())
+                {
+                    current = f.container->is_array() ? &f.container->array_range().begin()[f.index]
+                                                      : &(f.container->object_range().begin() + f.index)->value();
+                    ++f.index;
+                }
+                else
+                {
+                    jsoncons::detail::hash_seed seed = f.container->is_array() ? jsoncons::detail::hash_seed::array_value
+                                                                               : jsoncons::detail::hash_seed::object_value;
+                    h = jsoncons::detail::combine_hash(static_cast<uint64_t>(seed) + f.container->size(), f.acc);
+                    stack.pop_back();
+                    if (stack.empty())
+                    {
+                        return static_cast<std::size_t>(h);
+                    }
+                }
+            }
+        }
+    }
+
+} // namespace jsoncons
+
+namespace std {
+
+    template <class CharT,class ImplementationPolicy,class Allocator>
+    struct hash<jsoncons::basic_json<CharT,ImplementationPolicy,Allocator>>
+    {
+        std::size_t operator()(const jsoncons::basic_json<CharT,ImplementationPolicy,Allocator>& val) const
+        {
+            return jsoncons::structural_hash(val);
+        }
+    };
+
+} // namespace std
+
+#endif
@@ -0,0 +1,282 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_INPLACE_DECODER_HPP
+#define JSONCONS_JSON_INPLACE_DECODER_HPP
+
+#include <string>
+#include <vector>
+#include <memory> // std::allocator
+#include <utility> // std::move
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_visitor.hpp>
+
+namespace jsoncons {
+
+// Builds the result in place: each value is constructed directly in the array or object
+// that contains it, and each key is moved into its key_value, without staging values on
+// a separate stack. An open container is always the last element of its parent, and its
+// parent does not grow until it is closed, so pointers to open containers stay valid.
+
+template <class Json,class TempAllocator=std::allocator<char>>
+class json_inplace_decoder final : public basic_json_visitor<typename Json::char_type>
+{
+public:
+    using char_type = typename Json::char_type;
+    using typename basic_json_visitor<char_type>::string_view_type;
+
+    using key_value_type = typename Json::key_value_type;
+    using key_type = typename Json::key_type;
+    using array = typename Json::array;
+    using object = typename Json::object;
+    using result_allocator_type = typename Json::allocator_type;
+    using json_string_allocator = typename key_type::allocator_type;
+    using json_array_allocator = typename array::allocator_type;
+    using json_object_allocator = typename object::allocator_type;
+    typedef typename std::allocator_traits<result_allocator_type>:: template rebind_alloc<uint8_t> json_byte_allocator_type;
+private:
+    enum class structure_type {root_t, array_t, object_t};
+
+    struct structure_info
+    {
+        structure_type type_;
+        Json* container_;
+
+        structure_info(structure_type type, Json* container)
+            : type_(type), container_(container)
+        {
+        }
+    };
+
+    using temp_allocator_type = TempAllocator;
+    typedef typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<structure_info> structure_info_allocator_type;
+
+    json_string_allocator string_allocator_;
+    json_byte_allocator_type byte_allocator_;
+    json_object_allocator object_allocator_;
+    json_array_allocator array_allocator_;
+    structure_info_allocator_type structure_info_allocator_;
+
+    Json result_;
+
+    key_type name_;
+    std::vector<structure_info,structure_info_allocator_type> structure_stack_;
+    bool is_valid_;
+
+public:
+    json_inplace_decoder(const temp_allocator_type& temp_alloc = temp_allocator_type())
+        : string_allocator_(result_allocator_type()),
+          byte_allocator_(result_allocator_type()),
+          object_allocator_(result_allocator_type()),
+          array_allocator_(result_allocator_type()),
+          structure_info_allocator_(temp_alloc),
+          result_(),
+          name_(string_allocator_),
+          structure_stack_(structure_info_allocator_),
+          is_valid_(false)
+    {
+        structure_stack_.reserve(100);
+        structure_stack_.emplace_back(structure_type::root_t, nullptr);
+    }
+
+    json_inplace_decoder(result_allocator_arg_t,
+                         const result_allocator_type& result_alloc)
+        : string_allocator_(result_alloc),
+          byte_allocator_(result_alloc),
+          object_allocator_(result_alloc),
+          array_allocator_(result_alloc),
+          structure_info_allocator_(),
+          result_(),
+          name_(string_allocator_),
+          structure_stack_(),
+          is_valid_(false)
+    {
+        structure_stack_.reserve(100);
+        structure_stack_.emplace_back(structure_type::root_t, nullptr);
+    }
+
+    json_inplace_decoder(result_allocator_arg_t,
+                         const result_allocator_type& result_alloc,
+                         const temp_allocator_type& temp_alloc)
+        : string_allocator_(result_alloc),
+          byte_allocator_(result_alloc),
+          object_allocator_(result_alloc),
+          array_allocator_(result_alloc),
+          structure_info_allocator_(temp_alloc),
+          result_(),
+          name_(string_allocator_),
+          structure_stack_(structure_info_allocator_),
+          is_valid_(false)
+    {
+        structure_stack_.reserve(100);
+        structure_stack_.emplace_back(structure_type::root_t, nullptr);
+    }
+
+    void reset()
+    {
+        is_valid_ = false;
+        structure_stack_.clear();
+        structure_stack_.emplace_back(structure_type::root_t, nullptr);
+    }
+
+    bool is_valid() const
+    {
+        return is_valid_;
+    }
+
+    Json get_result()
+    {
+        is_valid_ = false;
+        return std::move(result_);
+    }
+
+private:
+
+    template <class... Args>
+    Json* emplace_value(Args&& ... args)
+    {
+        switch (structure_stack_.back().type_)
+        {
+            case structure_type::object_t:
+                return &structure_stack_.back().container_->object_value_unchecked().emplace_back_unchecked(std::move(name_), std::forward<Args>(args)...);
+            case structure_type::array_t:
+                return &structure_stack_.back().container_->array_value_unchecked().emplace_back(std::forward<Args>(args)...);
+            default:
+                is_valid_ = false;
+                result_ = Json(std::forward<Args>(args)...);
+                return &result_;
+        }
+    }
+
+    template <class... Args>
+    bool visit_value(Args&& ... args)
+    {
+        emplace_value(std::forward<Args>(args)...);
+        if (structure_stack_.back().type_ == structure_type::root_t)
+        {
+            is_valid_ = true;
+            return false;
+        }
+        return true;
+    }
+
+    bool end_structure()
+    {
+        structure_stack_.pop_back();
+        if (structure_stack_.back().type_ == structure_type::root_t)
+        {
+            is_valid_ = true;
+            return false;
+        }
+        return true;
+    }
+
+    void visit_flush() override
+    {
+    }
+
+    bool visit_begin_object(semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        Json* container = emplace_value(json_object_arg, tag, object_allocator_);
+        structure_stack_.emplace_back(structure_type::object_t, container);
+        return true;
+    }
+
+    bool visit_end_object(const ser_context&, std::error_code&) override
+    {
+        JSONCONS_ASSERT(structure_stack_.size() > 1);
+        JSONCONS_ASSERT(structure_stack_.back().type_ == structure_type::object_t);
+        structure_stack_.back().container_->object_value_unchecked().end_unchecked();
+        return end_structure();
+    }
+
+    bool visit_begin_array(semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        Json* container = emplace_value(json_array_arg, tag, array_allocator_);
+        structure_stack_.emplace_back(structure_type::array_t, container);
+        return true;
+    }
+
+    bool visit_end_array(const ser_context&, std::error_code&) override
+    {
+        JSONCONS_ASSERT(structure_stack_.size() > 1);
+        JSONCONS_ASSERT(structure_stack_.back().type_ == structure_type::array_t);
+        return end_structure();
+    }
+
+    bool visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
+    {
+        name_ = key_type(name.data(),name.length(),string_allocator_);
+        return true;
+    }
+
+    bool visit_string(const string_view_type& sv, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        return visit_value(sv, tag, string_allocator_);
+    }
+
+    bool visit_byte_string(const byte_string_view& b,
+                           semantic_tag tag,
+                           const ser_context&,
+                           std::error_code&) override
+    {
+        return visit_value(byte_string_arg, b, tag, byte_allocator_);
+    }
+
+    bool visit_byte_string(const byte_string_view& b,
+                           uint64_t ext_tag,
+                           const ser_context&,
+                           std::error_code&) override
+    {
+        return visit_value(byte_string_arg, b, ext_tag, byte_allocator_);
+    }
+
+    bool visit_int64(int64_t value,
+                     semantic_tag tag,
+                     const ser_context&,
+                     std::error_code&) override
+    {
+        return visit_value(value, tag);
+    }
+
+    bool visit_uint64(uint64_t value,
+                      semantic_tag tag,
+                      const ser_context&,
+                      std::error_code&) override
+    {
+        return visit_value(value, tag);
+    }
+
+    bool visit_half(uint16_t value,
+                    semantic_tag tag,
+                    const ser_context&,
+                    std::error_code&) override
+    {
+        return visit_value(half_arg, value, tag);
+    }
+
+    bool visit_double(double value,
+                      semantic_tag tag,
+                      const ser_context&,
+                      std::error_code&) override
+    {
+        return visit_value(value, tag);
+    }
+
+    bool visit_bool(bool value, semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        return visit_value(value, tag);
+    }
+
+    bool visit_null(semantic_tag tag, const ser_context&, std::error_code&) override
+    {
+        return visit_value(null_type(), tag);
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,661 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_LINES_READER_HPP
+#define JSONCONS_JSON_LINES_READER_HPP
+
+#include <memory> // std::allocator
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <algorithm> // std::find
+#include <functional> // std::function
+#include <system_error>
+#include <exception> // std::exception_ptr
+#include <utility> // std::move
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <jsoncons/basic_json.hpp>
+#include <jsoncons/source.hpp>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_options.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/detail/span.hpp>
+
+namespace jsoncons {
+
+// Settings for splitting newline delimited JSON across threads
+
+class json_lines_options
+{
+    std::size_t num_threads_;
+    std::size_t chunk_size_;
+    bool ordered_;
+public:
+    json_lines_options()
+        : num_threads_(0), chunk_size_(1024*1024), ordered_(true)
+    {
+    }
+
+    // The number of worker threads, 0 means std::thread::hardware_concurrency()
+    std::size_t num_threads() const
+    {
+        return num_threads_;
+    }
+
+    json_lines_options& num_threads(std::size_t value)
+    {
+        num_threads_ = value;
+        return *this;
+    }
+
+    // The approximate number of characters handed to a worker at a time,
+    // chunks are extended to the end of the line they stop in
+    std::size_t chunk_size() const
+    {
+        return chunk_size_;
+    }
+
+    json_lines_options& chunk_size(std::size_t value)
+    {
+        chunk_size_ = value > 0 ? value : 1;
+        return *this;
+    }
+
+    // Whether documents are delivered in input order, or as soon as their chunk is parsed
+    bool ordered() const
+    {
+        return ordered_;
+    }
+
+    json_lines_options& ordered(bool value)
+    {
+        ordered_ = value;
+        return *this;
+    }
+};
+
+// Reads newline delimited JSON, one document per line, parsing chunks of lines on a pool
+// of worker threads, each with its own parser and decoder. Results are delivered on the
+// calling thread. Blank lines are skipped.
+
+template<class Json,class Src=jsoncons::stream_source<typename Json::char_type>,class Allocator=std::allocator<char>>
+class basic_json_lines_reader : public ser_context
+{
+public:
+    using value_type = Json;
+    using char_type = typename Json::char_type;
+    using source_type = Src;
+    using temp_allocator_type = Allocator;
+private:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    struct chunk
+    {
+        std::size_t index;
+        const char_type* data;
+        std::size_t length;
+        std::basic_string<char_type> storage; // used when the source cannot lend its input
+
+        chunk()
+            : index(0), data(nullptr), length(0)
+        {
+        }
+    };
+
+    struct chunk_result
+    {
+        std::vector<Json> values;
+        std::size_t line_count;
+        std::error_code ec;
+        std::size_t line;   // of the error, relative to the chunk
+        std::size_t column;
+        std::exception_ptr exception;
+
+        chunk_result()
+            : line_count(0), line(0), column(0)
+        {
+        }
+    };
+
+    // State shared between the calling thread and the workers
+    struct work_queue
+    {
+        std::mutex mutex;
+        std::condition_variable work_available;
+        std::condition_variable result_available;
+        std::deque<chunk> pending;
+        std::map<std::size_t,chunk_result> ready;
+        bool input_done;
+        bool stop;
+
+        work_queue()
+            : input_done(false), stop(false)
+        {
+        }
+    };
+
+    // Stops and joins the workers however the calling thread leaves read
+    class worker_pool
+    {
+        work_queue& queue_;
+        std::vector<std::thread> threads_;
+    public:
+        worker_pool(work_queue& queue)
+            : queue_(queue)
+        {
+        }
+
+        ~worker_pool() noexcept
+        {
+            {
+                std::lock_guard<std::mutex> lock(queue_.mutex);
+                queue_.stop = true;
+            }
+            queue_.work_available.notify_all();
+            for (auto& t : threads_)
+            {
+                t.join();
+            }
+        }
+
+        template <class F>
+        void add(F&& f)
+        {
+            threads_.emplace_back(std::forward<F>(f));
+        }
+    };
+
+    Src source_;
+    json_lines_options lines_options_;
+    basic_json_decode_options<char_type> options_;
+    std::function<bool(json_errc,const ser_context&)> err_handler_;
+    temp_allocator_type alloc_;
+
+    bool contiguous_;
+    bool input_loaded_;
+    jsoncons::detail::span<const char_type> input_;
+    std::size_t input_pos_;
+    std::basic_string<char_type> carry_;
+    bool eof_;
+    std::size_t line_;
+    std::size_t column_;
+
+    // Noncopyable and nonmoveable
+    basic_json_lines_reader(const basic_json_lines_reader&) = delete;
+    basic_json_lines_reader& operator=(const basic_json_lines_reader&) = delete;
+
+public:
+    template <class Source>
+    explicit basic_json_lines_reader(Source&& source, const temp_allocator_type& alloc = temp_allocator_type())
+        : basic_json_lines_reader(std::forward<Source>(source),
+                                  json_lines_options(),
+                                  basic_json_decode_options<char_type>(),
+                                  default_json_parsing(),
+                                  alloc)
+    {
+    }
+
+    template <class Source>
+    basic_json_lines_reader(Source&& source,
+                            const json_lines_options& lines_options,
+                            const temp_allocator_type& alloc = temp_allocator_type())
+        : basic_json_lines_reader(std::forward<Source>(source),
+                                  lines_options,
+                                  basic_json_decode_options<char_type>(),
+                                  default_json_parsing(),
+                                  alloc)
+    {
+    }
+
+    template <class Source>
+    basic_json_lines_reader(Source&& source,
+                            const json_lines_options& lines_options,
+                            const basic_json_decode_options<char_type>& options,
+                            const temp_allocator_type& alloc = temp_allocator_type())
+        : basic_json_lines_reader(std::forward<Source>(source),
+                                  lines_options,
+                                  options,
+                                  default_json_parsing(),
+                                  alloc)
+    {
+    }
+
+    // err_handler is copied to every worker and may be called concurrently
+    template <class Source>
+    basic_json_lines_reader(Source&& source,
+                            const json_lines_options& lines_options,
+                            const basic_json_decode_options<char_type>& options,
+                            std::function<bool(json_errc,const ser_context&)> err_handler,
+                            const temp_allocator_type& alloc = temp_allocator_type(),
+                            typename std::enable_if<!std::is_constructible<basic_string_view<char_type>,Source>::value>::type* = 0)
+       : source_(std::forward<Source>(source)),
+         lines_options_(lines_options),
+         options_(options),
+         err_handler_(err_handler),
+         alloc_(alloc),
+         contiguous_(jsoncons::detail::has_read_buffer<Src>::value),
+         input_loaded_(false),
+         input_pos_(0),
+         eof_(false),
+         line_(0),
+         column_(0)
+    {
+    }
+
+    // Strings are read in place, and must outlive the reader
+    template <class Source>
+    basic_json_lines_reader(Source&& source,
+                            const json_lines_options& lines_options,
+                            const basic_json_decode_options<char_type>& options,
+                            std::function<bool(json_errc,const ser_context&)> err_handler,
+                            const temp_allocator_type& alloc = temp_allocator_type(),
+                            typename std::enable_if<std::is_constructible<basic_string_view<char_type>,Source>::value>::type* = 0)
+       : lines_options_(lines_options),
+         options_(options),
+         err_handler_(err_handler),
+         alloc_(alloc),
+         contiguous_(true),
+         input_loaded_(true),
+         input_pos_(0),
+         eof_(false),
+         line_(0),
+         column_(0)
+    {
+        basic_string_view<char_type> sv(std::forward<Source>(source));
+        input_ = jsoncons::detail::span<const char_type>(sv.data(), sv.size());
+    }
+
+    std::size_t line() const override
+    {
+        return line_;
+    }
+
+    std::size_t column() const override
+    {
+        return column_;
+    }
+
+    // Returns all documents, in input order unless unordered delivery was requested
+
+    std::vector<Json> read()
+    {
+        std::error_code ec;
+        std::vector<Json> values = read(ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,line_,column_));
+        }
+        return values;
+    }
+
+    std::vector<Json> read(std::error_code& ec)
+    {
+        std::vector<Json> values;
+        read_each([&values](Json&& value) {values.push_back(std::move(value));}, ec);
+        return values;
+    }
+
+    // Calls f(Json&&) on the calling thread for each document. When a line fails to parse,
+    // the documents on the lines before it are delivered, and, when ordered, none after it.
+
+    template <class F>
+    void read_each(F f)
+    {
+        std::error_code ec;
+        read_each(f, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,line_,column_));
+        }
+    }
+
+    template <class F>
+    void read_each(F f, std::error_code& ec)
+    {
+        if (source_.is_error())
+        {
+            ec = json_errc::source_error;
+            return;
+        }
+        line_ = 0;
+        column_ = 0;
+
+        std::size_t num_threads = lines_options_.num_threads();
+        if (num_threads == 0)
+        {
+            num_threads = (std::max)(std::thread::hardware_concurrency(), 1u);
+        }
+        const std::size_t max_in_flight = 2*num_threads;
+        const bool ordered = lines_options_.ordered();
+
+        work_queue queue;
+        worker_pool pool(queue);
+        for (std::size_t i = 0; i < num_threads; ++i)
+        {
+            pool.add([this,&queue](){run_worker(queue);});
+        }
+
+        std::size_t produced = 0;
+        std::size_t in_flight = 0;
+        std::size_t next_ordered = 0;
+        std::vector<std::size_t> line_counts;
+        std::vector<bool> delivered;
+        std::size_t error_index = npos;
+        chunk_result error_result;
+
+        for (;;)
+        {
+            // Keep the workers supplied, without letting the input run far ahead of delivery
+            while (error_index == npos && in_flight < max_in_flight && !eof_)
+            {
+                chunk c;
+                if (!next_chunk(c, ec))
+                {
+                    if (ec)
+                    {
+                        return;
+                    }
+                    break;
+                }
+                c.index = produced++;
+                line_counts.push_back(0);
+                delivered.push_back(false);
+                ++in_flight;
+                {
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    queue.pending.push_back(std::move(c));
+                }
+                queue.work_available.notify_one();
+            }
+            if (eof_ || error_index != npos)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    queue.input_done = true;
+                    if (error_index != npos)
+                    {
+                        queue.pending.clear();
+                    }
+                }
+                queue.work_available.notify_all();
+            }
+
+            if (error_index != npos && all_delivered_before(delivered, error_index))
+            {
+                break;
+            }
+            if (in_flight == 0)
+            {
+                break;
+            }
+
+            // Take the next deliverable result
+            std::size_t index;
+            chunk_result result;
+            {
+                std::unique_lock<std::mutex> lock(queue.mutex);
+                if (ordered)
+                {
+                    queue.result_available.wait(lock, [&](){return queue.ready.count(next_ordered) > 0;});
+                    auto it = queue.ready.find(next_ordered);
+                    index = it->first;
+                    result = std::move(it->second);
+                    queue.ready.erase(it);
+                    ++next_ordered;
+                }
+                else
+                {
+                    queue.result_available.wait(lock, [&](){return !queue.ready.empty();});
+                    auto it = queue.ready.begin();
+                    index = it->first;
+                    result = std::move(it->second);
+                    queue.ready.erase(it);
+                }
+            }
+            --in_flight;
+
+            if (result.exception)
+            {
+                std::rethrow_exception(result.exception);
+            }
+            if (error_index != npos && index > error_index)
+            {
+                continue;
+            }
+            for (auto& value : result.values)
+            {
+                f(std::move(value));
+            }
+            line_counts[index] = result.line_count;
+            delivered[index] = true;
+            if (result.ec && error_index == npos)
+            {
+                error_index = index;
+                error_result = std::move(result);
+            }
+        }
+
+        if (error_index != npos)
+        {
+            std::size_t lines_before = 0;
+            for (std::size_t i = 0; i < error_index; ++i)
+            {
+                lines_before += line_counts[i];
+            }
+            ec = error_result.ec;
+            line_ = lines_before + error_result.line;
+            column_ = error_result.column;
+        }
+    }
+
+private:
+
+    static bool all_delivered_before(const std::vector<bool>& delivered, std::size_t index)
+    {
+        for (std::size_t i = 0; i < index; ++i)
+        {
+            if (!delivered[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool next_chunk(chunk& c, std::error_code& ec)
+    {
+        return contiguous_ ? next_contiguous_chunk(c) : next_buffered_chunk(c, ec);
+    }
+
+    template <class S = Src>
+    typename std::enable_if<jsoncons::detail::has_read_buffer<S>::value>::type
+    load_input()
+    {
+        input_ = source_.read_buffer();
+    }
+
+    template <class S = Src>
+    typename std::enable_if<!jsoncons::detail::has_read_buffer<S>::value>::type
+    load_input()
+    {
+    }
+
+    // The whole input is in memory, chunks are views into it
+    bool next_contiguous_chunk(chunk& c)
+    {
+        if (!input_loaded_)
+        {
+            load_input();
+            input_loaded_ = true;
+        }
+        const std::size_t size = input_.size();
+        if (input_pos_ >= size)
+        {
+            eof_ = true;
+            return false;
+        }
+        std::size_t last = input_pos_ + (std::min)(lines_options_.chunk_size(), size - input_pos_);
+        if (last < size)
+        {
+            const char_type* p = std::find(input_.data() + last, input_.data() + size, '\n');
+            last = p == input_.data() + size ? size : static_cast<std::size_t>(p - input_.data()) + 1;
+        }
+        c.data = input_.data() + input_pos_;
+        c.length = last - input_pos_;
+        input_pos_ = last;
+        if (input_pos_ == size)
+        {
+            eof_ = true;
+        }
+        return true;
+    }
+
+    // The source is read in blocks, chunks own their characters and end at the last
+    // complete line, the rest is carried over to the next chunk
+    bool next_buffered_chunk(chunk& c, std::error_code& ec)
+    {
+        std::basic_string<char_type> buffer = std::move(carry_);
+        carry_.clear();
+        for (;;)
+        {
+            const std::size_t old_size = buffer.size();
+            buffer.resize(old_size + lines_options_.chunk_size());
+            const std::size_t count = source_.read(&buffer[old_size], lines_options_.chunk_size());
+            buffer.resize(old_size + count);
+            if (source_.is_error())
+            {
+                ec = json_errc::source_error;
+                return false;
+            }
+            if (count == 0)
+            {
+                eof_ = true;
+                break;
+            }
+            const std::size_t pos = buffer.find_last_of('\n');
+            if (pos != std::basic_string<char_type>::npos)
+            {
+                carry_.assign(buffer.data() + pos + 1, buffer.size() - (pos + 1));
+                buffer.resize(pos + 1);
+                break;
+            }
+        }
+        if (buffer.empty())
+        {
+            return false;
+        }
+        c.length = buffer.size();
+        c.storage = std::move(buffer);
+        return true;
+    }
+
+    void run_worker(work_queue& queue)
+    {
+        basic_json_parser<char_type,temp_allocator_type> parser(options_, err_handler_, alloc_);
+        json_decoder<Json,temp_allocator_type> decoder(alloc_);
+
+        for (;;)
+        {
+            chunk c;
+            {
+                std::unique_lock<std::mutex> lock(queue.mutex);
+                queue.work_available.wait(lock, [&](){return queue.stop || !queue.pending.empty() || queue.input_done;});
+                if (queue.stop || queue.pending.empty())
+                {
+                    return;
+                }
+                c = std::move(queue.pending.front());
+                queue.pending.pop_front();
+            }
+
+            chunk_result result;
+            JSONCONS_TRY
+            {
+                parse_chunk(c, parser, decoder, result);
+            }
+            JSONCONS_CATCH(...)
+            {
+                result.exception = std::current_exception();
+            }
+            {
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                queue.ready.emplace(c.index, std::move(result));
+            }
+            queue.result_available.notify_all();
+        }
+    }
+
+    void parse_chunk(const chunk& c,
+                     basic_json_parser<char_type,temp_allocator_type>& parser,
+                     json_decoder<Json,temp_allocator_type>& decoder,
+                     chunk_result& result)
+    {
+        const char_type* p = c.storage.empty() ? c.data : c.storage.data();
+        const char_type* end = p + c.length;
+
+        while (p < end)
+        {
+            const char_type* line_end = std::find(p, end, '\n');
+            ++result.line_count;
+
+            const char_type* last = line_end;
+            if (last > p && *(last-1) == '\r')
+            {
+                --last;
+            }
+            if (!is_blank(p, last))
+            {
+                std::error_code ec;
+                parser.reset();
+                parser.update(p, static_cast<std::size_t>(last - p));
+                parser.finish_parse(decoder, ec);
+                if (!ec)
+                {
+                    parser.check_done(ec);
+                }
+                if (ec)
+                {
+                    result.ec = ec;
+                    result.line = result.line_count;
+                    result.column = parser.column();
+                    decoder.reset();
+                    return;
+                }
+                if (decoder.is_valid())
+                {
+                    result.values.push_back(decoder.get_result());
+                }
+            }
+            p = line_end == end ? end : line_end + 1;
+        }
+    }
+
+    static bool is_blank(const char_type* p, const char_type* last)
+    {
+        for (; p < last; ++p)
+        {
+            if (*p != ' ' && *p != '\t' && *p != '\r')
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+using json_lines_reader = basic_json_lines_reader<json>;
+using wjson_lines_reader = basic_json_lines_reader<wjson>;
+using ojson_lines_reader = basic_json_lines_reader<ojson>;
+using wojson_lines_reader = basic_json_lines_reader<wojson>;
+
+}
+
+#endif
+
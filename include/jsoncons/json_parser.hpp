@@ -21,6 +21,9 @@
 #include <jsoncons/json_visitor.hpp>
 #include <jsoncons/json_error.hpp>
 #include <jsoncons/detail/parse_number.hpp>
+#include <jsoncons/detail/decimal_to_double.hpp>
+#include <jsoncons/detail/simd_scan.hpp>
+#include <jsoncons/detail/structural_index.hpp>
 
 #define JSONCONS_ILLEGAL_CONTROL_CHARACTER \
         case 0x00:case 0x01:case 0x02:case 0x03:case 0x04:case 0x05:case 0x06:case 0x07:case 0x08:case 0x0b: \
@@ -133,6 +136,7 @@ private:
     using temp_allocator_type = TempAllocator;
     using char_allocator_type = typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<CharT>;
     using parse_state_allocator_type = typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<json_parse_state>;
+    using offset_allocator_type = typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<uint32_t>;
 
     static constexpr size_t initial_string_buffer_capacity_ = 1024;
     static constexpr int default_initial_stack_capacity_ = 100;
@@ -156,9 +160,21 @@ private:
     std::basic_string<CharT,std::char_traits<CharT>,char_allocator_type> string_buffer_;
     jsoncons::detail::to_double_t to_double_;
 
+    // The magnitude of the integer being parsed, accumulated as its digits are read, 
+    // string_buffer_ is only needed if it overflows
+    uint64_t integer_value_;
+    bool integer_overflow_;
+
     std::vector<json_parse_state,parse_state_allocator_type> state_stack_;
     std::vector<std::pair<string_view_type,double>> string_double_map_;
 
+    // Structural index over [begin_input_,input_end_), see parse_indexed
+    bool index_built_;
+    std::vector<uint32_t,offset_allocator_type> structural_index_;
+    std::vector<uint32_t,offset_allocator_type> string_special_index_;
+    std::size_t next_structural_;
+    std::size_t next_string_special_;
+
     // Noncopyable and nonmoveable
     basic_json_parser(const basic_json_parser&) = delete;
     basic_json_parser& operator=(const basic_json_parser&) = delete;
@@ -199,7 +215,14 @@ public:
          more_(true),
          done_(false),
          string_buffer_(alloc),
-         state_stack_(alloc)
+         integer_value_(0),
+         integer_overflow_(false),
+         state_stack_(alloc),
+         index_built_(false),
+         structural_index_(alloc),
+         string_special_index_(alloc),
+         next_structural_(0),
+         next_string_special_(0)
     {
         string_buffer_.reserve(initial_string_buffer_capacity_);
 
@@ -252,30 +275,26 @@ public:
 
     void skip_space()
     {
-        const CharT* local_input_end = input_end_;
-        while (input_ptr_ != local_input_end) 
+        std::size_t lines = 0;
+        const CharT* line_start = nullptr;
+        const CharT* p = jsoncons::detail::skip_json_whitespace(input_ptr_, input_end_, lines, line_start);
+        if (lines > 0)
         {
-            switch (*input_ptr_)
-            {
-                case ' ':
-                case '\t':
-                    ++input_ptr_;
-                    ++column_;                     
-                    break;
-                case '\r': 
-                    push_state(state_);
-                    ++input_ptr_;
-                    ++column_;
-                    state_ = json_parse_state::cr;
-                    return; 
-                case '\n': 
-                    ++input_ptr_;
-                    ++line_;
-                    column_ = 1;
-                    return;   
-                default:
-                    return;
-            }
+            line_ += lines;
+            column_ = (p - line_start) + 1;
+        }
+        else
+        {
+            column_ += (p - input_ptr_);
+        }
+        input_ptr_ = p;
+        // A '\r' at the end of the buffer may be followed by '\n' in the next one 
+        if (input_ptr_ != input_end_ && *input_ptr_ == '\r')
+        {
+            push_state(state_);
+            ++input_ptr_;
+            ++column_;
+            state_ = json_parse_state::cr;
         }
     }
 
@@ -497,6 +516,7 @@ public:
         begin_input_ = data;
         input_end_ = data + length;
         input_ptr_ = begin_input_;
+        index_built_ = false;
     }
 
     void parse_some(basic_json_visitor<CharT>& visitor)
@@ -532,6 +552,213 @@ public:
         }
     }
 
+    // Two stage alternative to parse_some, for when the current buffer holds the entire input.
+    // The first stage indexes the positions of all tokens in the buffer, the second walks the
+    // index, so that whitespace and string contents are jumped over rather than scanned.
+    // When the walk meets anything other than well formed JSON, it hands over to the state
+    // machine at that point, so error reporting and recovery are the same as for parse_some.
+
+    void parse_indexed(basic_json_visitor<CharT>& visitor)
+    {
+        std::error_code ec;
+        parse_indexed(visitor, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,line_,column_));
+        }
+    }
+
+    void parse_indexed(basic_json_visitor<CharT>& visitor, std::error_code& ec)
+    {
+        if (!index_built_)
+        {
+            if (!jsoncons::detail::build_structural_index(begin_input_, input_end_ - begin_input_, 
+                                                          structural_index_, string_special_index_))
+            {
+                structural_index_.clear();
+                string_special_index_.clear();
+            }
+            next_structural_ = 0;
+            next_string_special_ = 0;
+            index_built_ = true;
+        }
+        if (state_ != json_parse_state::start || structural_index_.empty())
+        {
+            parse_some_(visitor, ec);
+            return;
+        }
+
+        bool handover = false;
+        while (!handover && more_ && state_ != json_parse_state::before_done)
+        {
+            skip_index_entries_before_input_ptr();
+            if (next_structural_ == structural_index_.size())
+            {
+                break;
+            }
+            // Only whitespace lies between input_ptr_ and the next token
+            advance_to(begin_input_ + structural_index_[next_structural_]);
+
+            switch (state_)
+            {
+                case json_parse_state::start:
+                case json_parse_state::expect_value:
+                case json_parse_state::expect_value_or_end:
+                    switch (*input_ptr_)
+                    {
+                        case '{':
+                            begin_object(visitor, ec);
+                            if (ec) return;
+                            ++input_ptr_;
+                            ++column_;
+                            break;
+                        case '[':
+                            begin_array(visitor, ec);
+                            if (ec) return;
+                            ++input_ptr_;
+                            ++column_;
+                            break;
+                        case ']':
+                            if (state_ == json_parse_state::expect_value_or_end)
+                            {
+                                end_array(visitor, ec);
+                                if (ec) return;
+                                ++input_ptr_;
+                                ++column_;
+                            }
+                            else
+                            {
+                                handover = true;
+                            }
+                            break;
+                        case '\"':
+                            handover = !parse_indexed_string(visitor, ec);
+                            break;
+                        case '-':
+                            string_buffer_.clear();
+                            string_buffer_.push_back('-');
+                            ++input_ptr_;
+                            ++column_;
+                            state_ = json_parse_state::minus;
+                            parse_number(visitor, ec);
+                            break;
+                        case '0': 
+                            string_buffer_.clear();
+                            string_buffer_.push_back(static_cast<char>(*input_ptr_));
+                            ++input_ptr_;
+                            ++column_;
+                            state_ = json_parse_state::zero;
+                            parse_number(visitor, ec);
+                            break;
+                        case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
+                            string_buffer_.clear();
+                            string_buffer_.push_back(static_cast<char>(*input_ptr_));
+                            ++input_ptr_;
+                            ++column_;
+                            state_ = json_parse_state::integer;
+                            parse_number(visitor, ec);
+                            break;
+                        case 'n':
+                            parse_null(visitor, ec);
+                            handover = !end_of_indexed_literal();
+                            break;
+                        case 't':
+                            parse_true(visitor, ec);
+                            handover = !end_of_indexed_literal();
+                            break;
+                        case 'f':
+                            parse_false(visitor, ec);
+                            handover = !end_of_indexed_literal();
+                            break;
+                        default:
+                            handover = true;
+                            break;
+                    }
+                    break;
+                case json_parse_state::expect_member_name_or_end:
+                case json_parse_state::expect_member_name:
+                    switch (*input_ptr_)
+                    {
+                        case '\"':
+                            push_state(json_parse_state::member_name);
+                            handover = !parse_indexed_string(visitor, ec);
+                            if (handover && *input_ptr_ == '\"')
+                            {
+                                pop_state(); // unterminated, not started
+                            }
+                            break;
+                        case '}':
+                            if (state_ == json_parse_state::expect_member_name_or_end)
+                            {
+                                end_object(visitor, ec);
+                                if (ec) return;
+                                ++input_ptr_;
+                                ++column_;
+                            }
+                            else
+                            {
+                                handover = true;
+                            }
+                            break;
+                        default:
+                            handover = true;
+                            break;
+                    }
+                    break;
+                case json_parse_state::expect_colon:
+                    if (*input_ptr_ == ':')
+                    {
+                        state_ = json_parse_state::expect_value;
+                        ++input_ptr_;
+                        ++column_;
+                    }
+                    else
+                    {
+                        handover = true;
+                    }
+                    break;
+                case json_parse_state::expect_comma_or_end:
+                    switch (*input_ptr_)
+                    {
+                        case '}':
+                            end_object(visitor, ec);
+                            if (ec) return;
+                            ++input_ptr_;
+                            ++column_;
+                            break;
+                        case ']':
+                            end_array(visitor, ec);
+                            if (ec) return;
+                            ++input_ptr_;
+                            ++column_;
+                            break;
+                        case ',':
+                            begin_member_or_element(ec);
+                            if (ec) return;
+                            ++input_ptr_;
+                            ++column_;
+                            break;
+                        default:
+                            handover = true;
+                            break;
+                    }
+                    break;
+                default:
+                    handover = true;
+                    break;
+            }
+            if (ec)
+            {
+                return;
+            }
+        }
+
+        if (handover)
+        {
+            parse_some_(visitor, ec);
+        }
+    }
+
     void parse_some_(basic_json_visitor<CharT>& visitor, std::error_code& ec)
     {
         if (state_ == json_parse_state::before_done)
@@ -617,18 +844,7 @@ public:
                                     return;
                                 }
                                 break;
-                            case '\r': 
-                                push_state(state_);
-                                ++input_ptr_;
-                                ++column_;
-                                state_ = json_parse_state::cr;
-                                break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                column_ = 1;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':case '\r':
                                 skip_space();
                                 break;
                             case '/': 
@@ -729,18 +945,7 @@ public:
                                 ++input_ptr_;
                                 ++column_;
                                 break;
-                            case '\r': 
-                                ++input_ptr_;
-                                ++column_;
-                                push_state(state_);
-                                state_ = json_parse_state::cr;
-                                break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                column_ = 1;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':case '\r':
                                 skip_space();
                                 break;
                             case '/':
@@ -806,18 +1011,7 @@ public:
                                 ++input_ptr_;
                                 ++column_;
                                 break;
-                            case '\r': 
-                                ++input_ptr_;
-                                ++column_;
-                                push_state(state_);
-                                state_ = json_parse_state::cr;
-                                break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                column_ = 1;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':case '\r':
                                 skip_space();
                                 break;
                             case '/':
@@ -878,18 +1072,7 @@ public:
                                 ++input_ptr_;
                                 ++column_;
                                 break;
-                            case '\r': 
-                                ++input_ptr_;
-                                ++column_;
-                                push_state(state_);
-                                state_ = json_parse_state::cr;
-                                break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                column_ = 1;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':case '\r':
                                 skip_space();
                                 break;
                             case '/': 
@@ -956,18 +1139,7 @@ public:
                                 ++input_ptr_;
                                 ++column_;
                                 break;
-                            case '\r': 
-                                push_state(state_);
-                                state_ = json_parse_state::cr;
-                                ++input_ptr_;
-                                ++column_;
-                                break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                column_ = 1;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':case '\r':
                                 skip_space();
                                 break;
                             case '/': 
@@ -1009,18 +1181,7 @@ public:
                                 ++input_ptr_;
                                 ++column_;
                                 break;
-                            case '\r': 
-                                push_state(state_);
-                                ++input_ptr_;
-                                ++column_;
-                                state_ = json_parse_state::cr;
-                                break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                column_ = 1;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':case '\r':
                                 skip_space();
                                 break;
                             case '/': 
@@ -1149,18 +1310,7 @@ public:
                                 ++input_ptr_;
                                 ++column_;
                                 break;
-                            case '\r': 
-                                ++input_ptr_;
-                                ++column_;
-                                push_state(state_);
-                                state_ = json_parse_state::cr;
-                                break; 
-                            case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                column_ = 1;
-                                break;   
-                            case ' ':case '\t':
+                            case ' ':case '\t':case '\n':case '\r':
                                 skip_space();
                                 break;
                             case '/': 
@@ -1661,8 +1811,11 @@ public:
             case json_parse_state::minus:
                 goto minus_sign;
             case json_parse_state::zero:
+                integer_value_ = 0;
+                integer_overflow_ = false;
                 goto zero;
             case json_parse_state::integer:
+                accumulate_integer_buffer(); // usually the one digit seen by the caller
                 goto integer;
             case json_parse_state::fraction1:
                 goto fraction1;
@@ -1686,11 +1839,15 @@ minus_sign:
         switch (*input_ptr_)
         {
             case '0': 
+                integer_value_ = 0;
+                integer_overflow_ = false;
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
                 ++column_;
                 goto zero;
             case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
+                integer_value_ = static_cast<uint64_t>(*input_ptr_ - '0');
+                integer_overflow_ = false;
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
                 ++column_;
@@ -1709,22 +1866,7 @@ zero:
         }
         switch (*input_ptr_)
         {
-            case '\r': 
-                end_integer_value(visitor, ec);
-                if (ec) return;
-                ++input_ptr_;
-                ++column_;
-                push_state(state_);
-                state_ = json_parse_state::cr;
-                return; 
-            case '\n': 
-                end_integer_value(visitor, ec);
-                if (ec) return;
-                ++input_ptr_;
-                ++line_;
-                column_ = 1;
-                return;   
-            case ' ':case '\t':
+            case ' ':case '\t':case '\n':case '\r':
                 end_integer_value(visitor, ec);
                 if (ec) return;
                 skip_space();
@@ -1786,22 +1928,7 @@ integer:
         }
         switch (*input_ptr_)
         {
-            case '\r': 
-                end_integer_value(visitor, ec);
-                if (ec) return;
-                push_state(state_);
-                ++input_ptr_;
-                ++column_;
-                state_ = json_parse_state::cr;
-                return; 
-            case '\n': 
-                end_integer_value(visitor, ec);
-                if (ec) return;
-                ++input_ptr_;
-                ++line_;
-                column_ = 1;
-                return;   
-            case ' ':case '\t':
+            case ' ':case '\t':case '\n':case '\r':
                 end_integer_value(visitor, ec);
                 if (ec) return;
                 skip_space();
@@ -1825,6 +1952,7 @@ integer:
                 state_ = json_parse_state::expect_comma_or_end;
                 return;
             case '0': case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
+                accumulate_digit(*input_ptr_);
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
                 ++column_;
@@ -1882,22 +2010,7 @@ fraction2:
         }
         switch (*input_ptr_)
         {
-            case '\r': 
-                end_fraction_value(visitor, ec);
-                if (ec) return;
-                push_state(state_);
-                ++input_ptr_;
-                ++column_;
-                state_ = json_parse_state::cr;
-                return; 
-            case '\n': 
-                end_fraction_value(visitor, ec);
-                if (ec) return;
-                ++input_ptr_;
-                ++line_;
-                column_ = 1;
-                return;   
-            case ' ':case '\t':
+            case ' ':case '\t':case '\n':case '\r':
                 end_fraction_value(visitor, ec);
                 if (ec) return;
                 skip_space();
@@ -2003,22 +2116,7 @@ exp3:
         }
         switch (*input_ptr_)
         {
-            case '\r': 
-                end_fraction_value(visitor, ec);
-                if (ec) return;
-                ++input_ptr_;
-                ++column_;
-                push_state(state_);
-                state_ = json_parse_state::cr;
-                return; 
-            case '\n': 
-                end_fraction_value(visitor, ec);
-                if (ec) return;
-                ++input_ptr_;
-                ++line_;
-                column_ = 1;
-                return;   
-            case ' ':case '\t':
+            case ' ':case '\t':case '\n':case '\r':
                 end_fraction_value(visitor, ec);
                 if (ec) return;
                 skip_space();
@@ -2101,6 +2199,8 @@ exp3:
         }
 
 string_u1:
+        // Skip over the run of characters that need no further inspection
+        input_ptr_ = jsoncons::detail::find_string_special(input_ptr_, local_input_end);
         while (input_ptr_ < local_input_end)
         {
             switch (*input_ptr_)
@@ -2474,6 +2574,87 @@ escape_u9:
         JSONCONS_UNREACHABLE();               
     }
 
+    // Parses the string whose opening quote is at input_ptr_, returns false if the 
+    // state machine has to finish it
+    bool parse_indexed_string(basic_json_visitor<CharT>& visitor, std::error_code& ec)
+    {
+        if (next_structural_ + 1 >= structural_index_.size())
+        {
+            return false;
+        }
+        const CharT* first = input_ptr_ + 1;
+        const CharT* last = begin_input_ + structural_index_[next_structural_ + 1];
+
+        while (next_string_special_ < string_special_index_.size() && 
+               begin_input_ + string_special_index_[next_string_special_] < first)
+        {
+            ++next_string_special_;
+        }
+        input_ptr_ = first;
+        ++column_;
+        if (next_string_special_ < string_special_index_.size() &&
+            begin_input_ + string_special_index_[next_string_special_] < last)
+        {
+            // Escapes or control characters, take the slow path
+            state_ = json_parse_state::string;
+            string_buffer_.clear();
+            parse_string(visitor, ec);
+            return input_ptr_ > last;
+        }
+        end_string_value(first, last - first, visitor, ec);
+        if (ec)
+        {
+            return true;
+        }
+        input_ptr_ = last + 1;
+        column_ += (last - first) + 1;
+        return true;
+    }
+
+    // A literal is only well formed if it isn't followed by more of the same token
+    bool end_of_indexed_literal() const
+    {
+        if (input_ptr_ == input_end_)
+        {
+            return true;
+        }
+        switch (*input_ptr_)
+        {
+            case ' ': case '\t': case '\n': case '\r':
+            case '{': case '}': case '[': case ']': case ':': case ',': case '\"':
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // Advances input_ptr_ over whitespace to p
+    void advance_to(const CharT* p)
+    {
+        std::size_t lines = 0;
+        const CharT* line_start = nullptr;
+        jsoncons::detail::count_line_breaks(input_ptr_, p, lines, line_start);
+        if (lines > 0)
+        {
+            line_ += lines;
+            column_ = (p - line_start) + 1;
+        }
+        else
+        {
+            column_ += (p - input_ptr_);
+        }
+        input_ptr_ = p;
+    }
+
+    void skip_index_entries_before_input_ptr()
+    {
+        while (next_structural_ < structural_index_.size() && 
+               begin_input_ + structural_index_[next_structural_] < input_ptr_)
+        {
+            ++next_structural_;
+        }
+    }
+
     void translate_conv_errc(unicons::conv_errc result, std::error_code& ec)
     {
         switch (result)
@@ -2579,12 +2760,13 @@ private:
 
     void end_negative_value(basic_json_visitor<CharT>& visitor, std::error_code& ec)
     {
-        auto result = jsoncons::detail::integer_from_json<int64_t>(string_buffer_.data(), string_buffer_.length());
-        if (result)
+        const uint64_t min_magnitude = uint64_t(1) << 63;
+        if (!integer_overflow_ && integer_value_ <= min_magnitude)
         {
-            more_ = visitor.int64_value(result.value(), semantic_tag::none, *this, ec);
+            int64_t val = integer_value_ == min_magnitude ? (std::numeric_limits<int64_t>::lowest)() : -static_cast<int64_t>(integer_value_);
+            more_ = visitor.int64_value(val, semantic_tag::none, *this, ec);
         }
-        else // Must be overflow
+        else 
         {
             more_ = visitor.string_value(string_buffer_, semantic_tag::bigint, *this, ec);
         }
@@ -2593,18 +2775,46 @@ private:
 
     void end_positive_value(basic_json_visitor<CharT>& visitor, std::error_code& ec)
     {
-        auto result = jsoncons::detail::integer_from_json<uint64_t>(string_buffer_.data(), string_buffer_.length());
-        if (result)
+        if (!integer_overflow_)
         {
-            more_ = visitor.uint64_value(result.value(), semantic_tag::none, *this, ec);
+            more_ = visitor.uint64_value(integer_value_, semantic_tag::none, *this, ec);
         }
-        else // Must be overflow
+        else 
         {
             more_ = visitor.string_value(string_buffer_, semantic_tag::bigint, *this, ec);
         }
         after_value(ec);
     }
 
+    void accumulate_digit(CharT c)
+    {
+        static constexpr uint64_t max_value_div_10 = (std::numeric_limits<uint64_t>::max)() / 10;
+        static constexpr uint64_t max_value_mod_10 = (std::numeric_limits<uint64_t>::max)() % 10;
+
+        const uint64_t d = static_cast<uint64_t>(c - '0');
+        if (JSONCONS_LIKELY(integer_value_ < max_value_div_10 || (integer_value_ == max_value_div_10 && d <= max_value_mod_10)))
+        {
+            integer_value_ = integer_value_*10 + d;
+        }
+        else
+        {
+            integer_overflow_ = true;
+        }
+    }
+
+    void accumulate_integer_buffer()
+    {
+        integer_value_ = 0;
+        integer_overflow_ = false;
+        for (auto c : string_buffer_)
+        {
+            if (c != '-')
+            {
+                accumulate_digit(c);
+            }
+        }
+    }
+
     void end_fraction_value(basic_json_visitor<CharT>& visitor, std::error_code& ec)
     {
         JSONCONS_TRY
@@ -2615,7 +2825,13 @@ private:
             }
             else
             {
-                double d = to_double_(string_buffer_.c_str(), string_buffer_.length());
+                double d;
+                if (options_.strtod_number() || 
+                    !jsoncons::detail::decimal_to_double(string_buffer_.data(), string_buffer_.length(), 
+                                                         to_double_.get_decimal_point(), d))
+                {
+                    d = to_double_(string_buffer_.c_str(), string_buffer_.length());
+                }
                 more_ = visitor.double_value(d, semantic_tag::none, *this, ec);
             }
         }
@@ -169,6 +169,7 @@ private:
     source_type source_;
     bool eof_;
     bool begin_;
+    bool structural_index_;
     std::size_t buffer_length_;
     std::vector<CharT,char_allocator_type> buffer_;
 
@@ -274,6 +275,7 @@ public:
          source_(std::forward<Source>(source)),
          eof_(false),
          begin_(true),
+         structural_index_(options.structural_index() && jsoncons::detail::has_read_buffer<Src>::value),
          buffer_length_(default_max_buffer_length),
          buffer_(alloc)
     {
@@ -291,6 +293,7 @@ public:
          parser_(options,err_handler,alloc),
          eof_(false),
          begin_(false),
+         structural_index_(options.structural_index()),
          buffer_length_(0),
          buffer_(alloc)
     {
@@ -345,6 +348,17 @@ public:
             return;
         }        
         parser_.reset();
+        if (structural_index_)
+        {
+            // The whole input is, or is lent in one piece, in the parser's buffer
+            if (parser_.source_exhausted() && !source_.eof())
+            {
+                read_buffer(ec);
+                if (ec) return;
+            }
+            parser_.parse_indexed(visitor_, ec);
+            if (ec) return;
+        }
         while (!parser_.finished())
         {
             if (parser_.source_exhausted())
@@ -482,31 +496,51 @@ private:
 
     void read_buffer(std::error_code& ec)
     {
-        buffer_.clear();
-        buffer_.resize(buffer_length_);
-        std::size_t count = source_.read(buffer_.data(), buffer_length_);
-        buffer_.resize(static_cast<std::size_t>(count));
-        if (buffer_.size() == 0)
+        jsoncons::detail::span<const CharT> s = next_buffer();
+        if (s.size() == 0)
         {
+            if (source_.is_error())
+            {
+                ec = json_errc::source_error;
+                return;
+            }
             eof_ = true;
         }
         else if (begin_)
         {
-            auto result = unicons::skip_bom(buffer_.begin(), buffer_.end());
+            auto result = unicons::skip_bom(s.begin(), s.end());
             if (result.ec != unicons::encoding_errc())
             {
                 ec = result.ec;
                 return;
             }
-            std::size_t offset = result.it - buffer_.begin();
-            parser_.update(buffer_.data()+offset,buffer_.size()-offset);
+            std::size_t offset = result.it - s.begin();
+            parser_.update(s.data()+offset,s.size()-offset);
             begin_ = false;
         }
         else
         {
-            parser_.update(buffer_.data(),buffer_.size());
+            parser_.update(s.data(),s.size());
         }
     }
+
+    template <class S = Src>
+    typename std::enable_if<jsoncons::detail::has_read_buffer<S>::value,jsoncons::detail::span<const CharT>>::type
+    next_buffer()
+    {
+        return source_.read_buffer();
+    }
+
+    template <class S = Src>
+    typename std::enable_if<!jsoncons::detail::has_read_buffer<S>::value,jsoncons::detail::span<const CharT>>::type
+    next_buffer()
+    {
+        buffer_.clear();
+        buffer_.resize(buffer_length_);
+        std::size_t count = source_.read(buffer_.data(), buffer_length_);
+        buffer_.resize(static_cast<std::size_t>(count));
+        return jsoncons::detail::span<const CharT>(buffer_.data(), buffer_.size());
+    }
 };
 
 using json_reader = basic_json_reader<char>;
@@ -0,0 +1,391 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_MMAP_SOURCE_HPP
+#define JSONCONS_MMAP_SOURCE_HPP
+
+#include <algorithm> // std::min
+#include <string>
+#include <cstring> // std::memcpy
+#include <utility> // std::swap
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/source.hpp>
+#include <jsoncons/detail/span.hpp>
+
+#if defined(_WIN32)
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace jsoncons {
+
+namespace detail {
+
+    // Read only mapping of an entire file
+
+    class mapped_file
+    {
+        const uint8_t* data_;
+        std::size_t size_;
+        bool is_error_;
+
+        // Noncopyable
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+    public:
+        mapped_file()
+            : data_(nullptr), size_(0), is_error_(false)
+        {
+        }
+
+        explicit mapped_file(const char* path)
+            : data_(nullptr), size_(0), is_error_(false)
+        {
+            open(path);
+        }
+
+        mapped_file(mapped_file&& other) noexcept
+            : data_(nullptr), size_(0), is_error_(false)
+        {
+            std::swap(data_,other.data_);
+            std::swap(size_,other.size_);
+            std::swap(is_error_,other.is_error_);
+        }
+
+        mapped_file& operator=(mapped_file&& other) noexcept
+        {
+            std::swap(data_,other.data_);
+            std::swap(size_,other.size_);
+            std::swap(is_error_,other.is_error_);
+            return *this;
+        }
+
+        ~mapped_file() noexcept
+        {
+            close();
+        }
+
+        const uint8_t* data() const
+        {
+            return data_;
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+        bool is_error() const
+        {
+            return is_error_;
+        }
+
+    private:
+#if defined(_WIN32)
+        void open(const char* path)
+        {
+            HANDLE file = ::CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+            {
+                is_error_ = true;
+                return;
+            }
+            LARGE_INTEGER file_size;
+            if (!::GetFileSizeEx(file, &file_size))
+            {
+                ::CloseHandle(file);
+                is_error_ = true;
+                return;
+            }
+            if (file_size.QuadPart == 0) // empty files cannot be mapped
+            {
+                ::CloseHandle(file);
+                return;
+            }
+            HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            ::CloseHandle(file);
+            if (mapping == nullptr)
+            {
+                is_error_ = true;
+                return;
+            }
+            void* p = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            ::CloseHandle(mapping);
+            if (p == nullptr)
+            {
+                is_error_ = true;
+                return;
+            }
+            data_ = static_cast<const uint8_t*>(p);
+            size_ = static_cast<std::size_t>(file_size.QuadPart);
+        }
+
+        void close() noexcept
+        {
+            if (data_ != nullptr)
+            {
+                ::UnmapViewOfFile(data_);
+                data_ = nullptr;
+                size_ = 0;
+            }
+        }
+#else
+        void open(const char* path)
+        {
+            int fd = ::open(path, O_RDONLY);
+            if (fd == -1)
+            {
+                is_error_ = true;
+                return;
+            }
+            struct stat st;
+            if (::fstat(fd, &st) == -1)
+            {
+                ::close(fd);
+                is_error_ = true;
+                return;
+            }
+            if (st.st_size == 0) // empty files cannot be mapped
+            {
+                ::close(fd);
+                return;
+            }
+            void* p = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (p == MAP_FAILED)
+            {
+                is_error_ = true;
+                return;
+            }
+            // The parsers read front to back, let the kernel read ahead and drop pages behind
+            ::madvise(p, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+            data_ = static_cast<const uint8_t*>(p);
+            size_ = static_cast<std::size_t>(st.st_size);
+        }
+
+        void close() noexcept
+        {
+            if (data_ != nullptr)
+            {
+                ::munmap(const_cast<uint8_t*>(data_), size_);
+                data_ = nullptr;
+                size_ = 0;
+            }
+        }
+#endif
+    };
+
+} // namespace detail
+
+    // mmap_source
+
+    template <class CharT>
+    class mmap_source
+    {
+    public:
+        using value_type = CharT;
+    private:
+        jsoncons::detail::mapped_file file_;
+        const value_type* data_;
+        const value_type* current_;
+        const value_type* end_;
+
+        // Noncopyable
+        mmap_source(const mmap_source&) = delete;
+        mmap_source& operator=(const mmap_source&) = delete;
+    public:
+        mmap_source()
+            : data_(nullptr), current_(nullptr), end_(nullptr)
+        {
+        }
+
+        explicit mmap_source(const char* path)
+            : file_(path),
+              data_(reinterpret_cast<const value_type*>(file_.data())),
+              current_(data_),
+              end_(data_ + file_.size()/sizeof(value_type))
+        {
+        }
+
+        explicit mmap_source(const std::string& path)
+            : mmap_source(path.c_str())
+        {
+        }
+
+        mmap_source(mmap_source&& other) noexcept
+            : data_(nullptr), current_(nullptr), end_(nullptr)
+        {
+            std::swap(file_,other.file_);
+            std::swap(data_,other.data_);
+            std::swap(current_,other.current_);
+            std::swap(end_,other.end_);
+        }
+
+        mmap_source& operator=(mmap_source&& other) noexcept
+        {
+            std::swap(file_,other.file_);
+            std::swap(data_,other.data_);
+            std::swap(current_,other.current_);
+            std::swap(end_,other.end_);
+            return *this;
+        }
+
+        bool eof() const
+        {
+            return current_ == end_;
+        }
+
+        bool is_error() const
+        {
+            return file_.is_error();
+        }
+
+        std::size_t position() const
+        {
+            return (current_ - data_) + 1;
+        }
+
+        character_result<value_type> get_character()
+        {
+            return current_ < end_ ? character_result<value_type>(*current_++) : character_result<value_type>();
+        }
+
+        void ignore(std::size_t count)
+        {
+            current_ += (std::min)(count, static_cast<std::size_t>(end_ - current_));
+        }
+
+        character_result<value_type> peek_character()
+        {
+            return current_ < end_ ? character_result<value_type>(*current_) : character_result<value_type>();
+        }
+
+        std::size_t read(value_type* p, std::size_t length)
+        {
+            std::size_t len = (std::min)(length, static_cast<std::size_t>(end_ - current_));
+            std::memcpy(p, current_, len*sizeof(value_type));
+            current_ += len;
+            return len;
+        }
+
+        // Lends the rest of the mapping, valid for the lifetime of the source
+        jsoncons::detail::span<const value_type> read_buffer()
+        {
+            jsoncons::detail::span<const value_type> s(current_, end_ - current_);
+            current_ = end_;
+            return s;
+        }
+    };
+
+    // mmap_binary_source
+
+    class mmap_binary_source
+    {
+    public:
+        using value_type = uint8_t;
+    private:
+        jsoncons::detail::mapped_file file_;
+        const value_type* current_;
+
+        // Noncopyable
+        mmap_binary_source(const mmap_binary_source&) = delete;
+        mmap_binary_source& operator=(const mmap_binary_source&) = delete;
+    public:
+        mmap_binary_source()
+            : current_(nullptr)
+        {
+        }
+
+        explicit mmap_binary_source(const char* path)
+            : file_(path), current_(file_.data())
+        {
+        }
+
+        explicit mmap_binary_source(const std::string& path)
+            : mmap_binary_source(path.c_str())
+        {
+        }
+
+        mmap_binary_source(mmap_binary_source&& other) noexcept
+            : current_(nullptr)
+        {
+            std::swap(file_,other.file_);
+            std::swap(current_,other.current_);
+        }
+
+        mmap_binary_source& operator=(mmap_binary_source&& other) noexcept
+        {
+            std::swap(file_,other.file_);
+            std::swap(current_,other.current_);
+            return *this;
+        }
+
+        bool eof() const
+        {
+            return current_ == end();
+        }
+
+        bool is_error() const
+        {
+            return file_.is_error();
+        }
+
+        std::size_t position() const
+        {
+            return (current_ - file_.data()) + 1;
+        }
+
+        character_result<value_type> get_character()
+        {
+            return current_ < end() ? character_result<value_type>(*current_++) : character_result<value_type>();
+        }
+
+        void ignore(std::size_t count)
+        {
+            current_ += (std::min)(count, static_cast<std::size_t>(end() - current_));
+        }
+
+        character_result<value_type> peek_character()
+        {
+            return current_ < end() ? character_result<value_type>(*current_) : character_result<value_type>();
+        }
+
+        std::size_t read(value_type* p, std::size_t length)
+        {
+            std::size_t len = (std::min)(length, static_cast<std::size_t>(end() - current_));
+            std::memcpy(p, current_, len);
+            current_ += len;
+            return len;
+        }
+
+        // Lends the rest of the mapping, valid for the lifetime of the source
+        jsoncons::detail::span<const value_type> read_buffer()
+        {
+            jsoncons::detail::span<const value_type> s(current_, end() - current_);
+            current_ = end();
+            return s;
+        }
+    private:
+        const value_type* end() const
+        {
+            return file_.data() + file_.size();
+        }
+    };
+
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,174 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_MONOTONIC_ALLOCATOR_HPP
+#define JSONCONS_MONOTONIC_ALLOCATOR_HPP
+
+#include <cstddef> // std::size_t, std::max_align_t
+#include <cstdint> // uintptr_t
+#include <memory> // std::addressof
+#include <new> // placement new, std::bad_alloc
+#include <type_traits> // std::true_type
+#include <utility> // std::forward
+#include <jsoncons/config/compiler_support.hpp>
+
+namespace jsoncons {
+
+    // Hands out memory from a chain of blocks, each larger than the last, and frees it
+    // only all at once, in release() or on destruction. Individual deallocations are
+    // ignored. Like std::pmr::monotonic_buffer_resource, it is not thread safe.
+
+    class monotonic_buffer_resource
+    {
+        struct block
+        {
+            block* next;
+            std::size_t size;
+        };
+
+        static constexpr std::size_t header_size = (sizeof(block) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+        std::size_t initial_size_;
+        std::size_t next_size_;
+        block* blocks_;
+        char* current_;
+        std::size_t available_;
+        std::size_t allocated_;
+    public:
+        explicit monotonic_buffer_resource(std::size_t initial_size = 4096)
+            : initial_size_(initial_size < 64 ? 64 : initial_size), next_size_(initial_size_),
+              blocks_(nullptr), current_(nullptr), available_(0), allocated_(0)
+        {
+        }
+
+        monotonic_buffer_resource(const monotonic_buffer_resource&) = delete;
+        monotonic_buffer_resource& operator=(const monotonic_buffer_resource&) = delete;
+
+        ~monotonic_buffer_resource() noexcept
+        {
+            release();
+        }
+
+        void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
+        {
+            std::size_t padding = (alignment - (reinterpret_cast<uintptr_t>(current_) & (alignment - 1))) & (alignment - 1);
+            if (padding + bytes > available_)
+            {
+                add_block(bytes + alignment);
+                padding = (alignment - (reinterpret_cast<uintptr_t>(current_) & (alignment - 1))) & (alignment - 1);
+            }
+            char* p = current_ + padding;
+            current_ = p + bytes;
+            available_ -= padding + bytes;
+            return p;
+        }
+
+        void deallocate(void*, std::size_t, std::size_t = alignof(std::max_align_t)) noexcept
+        {
+        }
+
+        // Frees all memory handed out, without running any destructors
+        void release() noexcept
+        {
+            while (blocks_ != nullptr)
+            {
+                block* next = blocks_->next;
+                ::operator delete(blocks_);
+                blocks_ = next;
+            }
+            next_size_ = initial_size_;
+            current_ = nullptr;
+            available_ = 0;
+            allocated_ = 0;
+        }
+
+        // The total size of the blocks obtained from the system
+        std::size_t bytes_allocated() const
+        {
+            return allocated_;
+        }
+
+        bool is_equal(const monotonic_buffer_resource& other) const noexcept
+        {
+            return this == &other;
+        }
+
+    private:
+        void add_block(std::size_t min_size)
+        {
+            std::size_t size = next_size_;
+            while (size < min_size)
+            {
+                size *= 2;
+            }
+            block* b = static_cast<block*>(::operator new(header_size + size));
+            b->next = blocks_;
+            b->size = size;
+            blocks_ = b;
+            current_ = reinterpret_cast<char*>(b) + header_size;
+            available_ = size;
+            allocated_ += header_size + size;
+            next_size_ = size * 2;
+        }
+    };
+
+    // A stateful allocator that allocates from a monotonic_buffer_resource. Containers and
+    // basic_json values built with it share the resource, and their memory is reclaimed
+    // when the resource is released.
+
+    template <class T>
+    class monotonic_allocator
+    {
+        template <class U> friend class monotonic_allocator;
+
+        monotonic_buffer_resource* resource_;
+    public:
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        monotonic_allocator(monotonic_buffer_resource& resource) noexcept
+            : resource_(std::addressof(resource))
+        {
+        }
+
+        template <class U>
+        monotonic_allocator(const monotonic_allocator<U>& other) noexcept
+            : resource_(other.resource_)
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+            return static_cast<T*>(resource_->allocate(n*sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T*, std::size_t) noexcept
+        {
+        }
+
+        monotonic_buffer_resource* resource() const noexcept
+        {
+            return resource_;
+        }
+
+        template <class U>
+        friend bool operator==(const monotonic_allocator& lhs, const monotonic_allocator<U>& rhs) noexcept
+        {
+            return lhs.resource() == rhs.resource();
+        }
+
+        template <class U>
+        friend bool operator!=(const monotonic_allocator& lhs, const monotonic_allocator<U>& rhs) noexcept
+        {
+            return lhs.resource() != rhs.resource();
+        }
+    };
+
+} // namespace jsoncons
+
+#endif
@@ -15,11 +15,19 @@
 #include <exception>
 #include <memory> // std::addressof
 #include <cstring> // std::memcpy
+#include <type_traits> // std::enable_if
+#include <utility> // std::declval
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons/detail/more_type_traits.hpp>
 
 namespace jsoncons { 
 
+    // Sinks have flush(), push_back(ch) and append(s, length). The buffered stream sinks also
+    // have reserve(n), which returns a pointer to space for at least n characters at the
+    // end of the output, and commit(n), which adds the first n of them to the output.
+    // A commit must follow each reserve, before any other call. string_sink and bytes_sink
+    // do not, the container would be resized twice for every value.
+
     // stream_sink
 
     template <class CharT>
@@ -87,16 +95,33 @@ namespace jsoncons {
 
         void push_back(CharT ch)
         {
-            if (p_ < end_buffer_)
+            if (p_ == end_buffer_)
             {
-                *p_++ = ch;
+                stream_ptr_->write(begin_buffer_, buffer_length());
+                p_ = begin_buffer_;
             }
-            else
+            *p_++ = ch;
+        }
+
+        CharT* reserve(std::size_t n)
+        {
+            if (static_cast<std::size_t>(end_buffer_ - p_) < n)
             {
                 stream_ptr_->write(begin_buffer_, buffer_length());
+                if (buffer_.size() < n)
+                {
+                    buffer_.resize(n);
+                    begin_buffer_ = buffer_.data();
+                    end_buffer_ = begin_buffer_ + buffer_.size();
+                }
                 p_ = begin_buffer_;
-                push_back(ch);
             }
+            return p_;
+        }
+
+        void commit(std::size_t n)
+        {
+            p_ += n;
         }
     private:
 
@@ -177,16 +202,33 @@ namespace jsoncons {
 
         void push_back(uint8_t ch)
         {
-            if (p_ < end_buffer_)
+            if (p_ == end_buffer_)
             {
-                *p_++ = ch;
+                stream_ptr_->write((char*)begin_buffer_, buffer_length());
+                p_ = begin_buffer_;
             }
-            else
+            *p_++ = ch;
+        }
+
+        uint8_t* reserve(std::size_t n)
+        {
+            if (static_cast<std::size_t>(end_buffer_ - p_) < n)
             {
                 stream_ptr_->write((char*)begin_buffer_, buffer_length());
+                if (buffer_.size() < n)
+                {
+                    buffer_.resize(n);
+                    begin_buffer_ = buffer_.data();
+                    end_buffer_ = begin_buffer_ + buffer_.size();
+                }
                 p_ = begin_buffer_;
-                push_back(ch);
             }
+            return p_;
+        }
+
+        void commit(std::size_t n)
+        {
+            p_ += n;
         }
     private:
 
@@ -276,8 +318,92 @@ namespace jsoncons {
         {
             buf_ptr->push_back(static_cast<value_type>(ch));
         }
+
+        void append(const value_type* s, std::size_t length)
+        {
+            buf_ptr->insert(buf_ptr->end(), s, s+length);
+        }
     };
 
+namespace detail {
+
+    // has_reserve_commit
+
+    template <class Sink, class Enable=void>
+    struct has_reserve_commit : std::false_type
+    {};
+
+    template <class Sink>
+    struct has_reserve_commit<Sink,
+                              typename std::enable_if<std::is_same<decltype(std::declval<Sink&>().reserve(std::size_t())),typename Sink::value_type*>::value &&
+                                                      std::is_void<decltype(std::declval<Sink&>().commit(std::size_t()))>::value>::type> 
+        : std::true_type
+    {};
+
+    // sink_window
+
+    // Space for up to N characters to format a value into. Written in place in a sink
+    // with reserve and commit, and otherwise in a local buffer that is appended to the 
+    // sink on commit. The capacity asked for must not exceed N.
+
+    template <class Sink, std::size_t N, class Enable=void>
+    class sink_window
+    {
+    public:
+        using value_type = typename Sink::value_type;
+    private:
+        Sink& sink_;
+        value_type buffer_[N];
+    public:
+        sink_window(Sink& sink, std::size_t)
+            : sink_(sink)
+        {
+        }
+
+        sink_window(const sink_window&) = delete;
+        sink_window& operator=(const sink_window&) = delete;
+
+        value_type* data()
+        {
+            return buffer_;
+        }
+
+        void commit(std::size_t n)
+        {
+            sink_.append(buffer_, n);
+        }
+    };
+
+    template <class Sink, std::size_t N>
+    class sink_window<Sink,N,typename std::enable_if<has_reserve_commit<Sink>::value>::type>
+    {
+    public:
+        using value_type = typename Sink::value_type;
+    private:
+        Sink& sink_;
+        value_type* data_;
+    public:
+        sink_window(Sink& sink, std::size_t capacity)
+            : sink_(sink), data_(sink.reserve(capacity))
+        {
+        }
+
+        sink_window(const sink_window&) = delete;
+        sink_window& operator=(const sink_window&) = delete;
+
+        value_type* data()
+        {
+            return data_;
+        }
+
+        void commit(std::size_t n)
+        {
+            sink_.commit(n);
+        }
+    };
+
+} // namespace detail
+
 } // namespace jsoncons
 
 #endif
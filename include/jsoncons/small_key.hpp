@@ -0,0 +1,374 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_SMALL_KEY_HPP
+#define JSONCONS_SMALL_KEY_HPP
+
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <string>
+#include <ostream>
+#include <memory> // std::allocator, std::allocator_traits
+#include <iterator> // std::distance
+#include <utility> // std::swap
+#include <algorithm> // std::min
+#include <jsoncons/config/compiler_support.hpp>
+#include <jsoncons/detail/string_view.hpp>
+#include <jsoncons/detail/more_type_traits.hpp>
+#include <jsoncons/json_exception.hpp>
+
+namespace jsoncons {
+
+    // An immutable string for object member names, 16 bytes with a stateless allocator.
+    // Names of up to 12 bytes are stored inline. Longer names are stored on the heap,
+    // with their first 4 bytes kept inline as a prefix, so that comparisons that differ
+    // early never leave the key_value. The length is cached alongside.
+
+    template <class CharT,class Traits = std::char_traits<CharT>,class Allocator = std::allocator<CharT>>
+    class basic_small_key : private std::allocator_traits<Allocator>:: template rebind_alloc<CharT>
+    {
+        static_assert(sizeof(CharT) <= 4, "basic_small_key supports characters of up to 4 bytes");
+    public:
+        using char_type = CharT;
+        using traits_type = Traits;
+        using allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<CharT>;
+        using size_type = std::size_t;
+        using const_iterator = const CharT*;
+        using string_view_type = jsoncons::basic_string_view<CharT,Traits>;
+
+        static constexpr size_type inline_capacity = 12 / sizeof(CharT);
+        static constexpr size_type prefix_length = 4 / sizeof(CharT);
+    private:
+        using allocator_traits_type = std::allocator_traits<allocator_type>;
+
+        uint32_t length_;
+        CharT chars_[inline_capacity];
+    public:
+        basic_small_key()
+            : length_(0)
+        {
+        }
+
+        explicit basic_small_key(const allocator_type& alloc)
+            : allocator_type(alloc), length_(0)
+        {
+        }
+
+        basic_small_key(const CharT* s, size_type length, const allocator_type& alloc = allocator_type())
+            : allocator_type(alloc), length_(0)
+        {
+            assign(s, length);
+        }
+
+        basic_small_key(const CharT* s, const allocator_type& alloc = allocator_type())
+            : allocator_type(alloc), length_(0)
+        {
+            assign(s, Traits::length(s));
+        }
+
+        template <class InputIt>
+        basic_small_key(InputIt first, InputIt last, const allocator_type& alloc = allocator_type())
+            : allocator_type(alloc), length_(0)
+        {
+            size_type length = static_cast<size_type>(std::distance(first, last));
+            CharT* p = allocate_for(length);
+            for (size_type i = 0; first != last; ++first, ++i)
+            {
+                p[i] = *first;
+            }
+            finish_for(length);
+        }
+
+        template <class StringAllocator>
+        basic_small_key(const std::basic_string<CharT,Traits,StringAllocator>& s, const allocator_type& alloc = allocator_type())
+            : allocator_type(alloc), length_(0)
+        {
+            assign(s.data(), s.length());
+        }
+
+        basic_small_key(const basic_small_key& other)
+            : allocator_type(allocator_traits_type::select_on_container_copy_construction(other.get_allocator())), length_(0)
+        {
+            assign(other.data(), other.length());
+        }
+
+        basic_small_key(const basic_small_key& other, const allocator_type& alloc)
+            : allocator_type(alloc), length_(0)
+        {
+            assign(other.data(), other.length());
+        }
+
+        basic_small_key(basic_small_key&& other) noexcept
+            : allocator_type(other.get_allocator()), length_(other.length_)
+        {
+            std::memcpy(chars_, other.chars_, sizeof(chars_));
+            other.length_ = 0;
+        }
+
+        basic_small_key(basic_small_key&& other, const allocator_type& alloc)
+            : allocator_type(alloc), length_(0)
+        {
+            if (other.get_allocator() == alloc)
+            {
+                length_ = other.length_;
+                std::memcpy(chars_, other.chars_, sizeof(chars_));
+                other.length_ = 0;
+            }
+            else
+            {
+                assign(other.data(), other.length());
+            }
+        }
+
+        ~basic_small_key() noexcept
+        {
+            deallocate();
+        }
+
+        basic_small_key& operator=(const basic_small_key& other)
+        {
+            if (this != &other)
+            {
+                basic_small_key temp(other, get_allocator());
+                swap(temp);
+            }
+            return *this;
+        }
+
+        basic_small_key& operator=(basic_small_key&& other) noexcept
+        {
+            if (this != &other)
+            {
+                basic_small_key temp(std::move(other), get_allocator());
+                swap(temp);
+            }
+            return *this;
+        }
+
+        void swap(basic_small_key& other) noexcept
+        {
+            std::swap(length_, other.length_);
+            CharT temp[inline_capacity];
+            std::memcpy(temp, chars_, sizeof(chars_));
+            std::memcpy(chars_, other.chars_, sizeof(chars_));
+            std::memcpy(other.chars_, temp, sizeof(chars_));
+        }
+
+        allocator_type get_allocator() const
+        {
+            return static_cast<const allocator_type&>(*this);
+        }
+
+        const CharT* data() const
+        {
+            return is_inline() ? chars_ : heap_pointer();
+        }
+
+        size_type size() const
+        {
+            return length_;
+        }
+
+        size_type length() const
+        {
+            return length_;
+        }
+
+        bool empty() const
+        {
+            return length_ == 0;
+        }
+
+        const_iterator begin() const
+        {
+            return data();
+        }
+
+        const_iterator end() const
+        {
+            return data() + length_;
+        }
+
+        // Keys are sized exactly, there is nothing to release
+        void shrink_to_fit()
+        {
+        }
+
+        operator string_view_type() const noexcept
+        {
+            return string_view_type(data(), length_);
+        }
+
+        int compare(const basic_small_key& other) const
+        {
+            return compare(other.chars_, other.data(), other.length_);
+        }
+
+        int compare(const string_view_type& s) const
+        {
+            return compare(s.data(), s.data(), s.length());
+        }
+
+        friend bool operator==(const basic_small_key& lhs, const basic_small_key& rhs)
+        {
+            return lhs.length_ == rhs.length_ && lhs.compare(rhs) == 0;
+        }
+
+        friend bool operator==(const basic_small_key& lhs, const string_view_type& rhs)
+        {
+            return lhs.length_ == rhs.length() && lhs.compare(rhs) == 0;
+        }
+
+        friend bool operator==(const string_view_type& lhs, const basic_small_key& rhs)
+        {
+            return rhs == lhs;
+        }
+
+        friend bool operator==(const basic_small_key& lhs, const CharT* rhs)
+        {
+            return lhs == string_view_type(rhs);
+        }
+
+        friend bool operator==(const CharT* lhs, const basic_small_key& rhs)
+        {
+            return rhs == string_view_type(lhs);
+        }
+
+        template <class StringAllocator>
+        friend bool operator==(const basic_small_key& lhs, const std::basic_string<CharT,Traits,StringAllocator>& rhs)
+        {
+            return lhs == string_view_type(rhs.data(), rhs.length());
+        }
+
+        template <class StringAllocator>
+        friend bool operator==(const std::basic_string<CharT,Traits,StringAllocator>& lhs, const basic_small_key& rhs)
+        {
+            return rhs == string_view_type(lhs.data(), lhs.length());
+        }
+
+        template <class T>
+        friend bool operator!=(const basic_small_key& lhs, const T& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator!=(const string_view_type& lhs, const basic_small_key& rhs)
+        {
+            return !(rhs == lhs);
+        }
+
+        friend bool operator<(const basic_small_key& lhs, const basic_small_key& rhs)
+        {
+            return lhs.compare(rhs) < 0;
+        }
+
+        friend std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, const basic_small_key& key)
+        {
+            os.write(key.data(), key.length());
+            return os;
+        }
+
+    private:
+        bool is_inline() const
+        {
+            return length_ <= inline_capacity;
+        }
+
+        CharT* heap_pointer() const
+        {
+            CharT* p;
+            std::memcpy(&p, reinterpret_cast<const char*>(chars_) + 4, sizeof(p));
+            return p;
+        }
+
+        // The first prefix_length characters are compared from head, which for another
+        // key is its inline prefix, so that keys that differ early are told apart without
+        // reading either heap allocation
+        int compare(const CharT* head, const CharT* s, size_type length) const
+        {
+            const size_type n = (std::min)(static_cast<size_type>(length_), length);
+            const size_type prefix = (std::min)(n, prefix_length);
+            for (size_type i = 0; i < prefix; ++i)
+            {
+                if (!Traits::eq(chars_[i], head[i]))
+                {
+                    return Traits::lt(chars_[i], head[i]) ? -1 : 1;
+                }
+            }
+            int result = n > prefix ? Traits::compare(data() + prefix, s + prefix, n - prefix) : 0;
+            if (result == 0)
+            {
+                result = length_ < length ? -1 : (length_ > length ? 1 : 0);
+            }
+            return result;
+        }
+
+        // Returns where to put length characters, either the inline buffer or a new
+        // heap allocation
+        CharT* allocate_for(size_type length)
+        {
+            if (length > static_cast<size_type>(UINT32_MAX))
+            {
+                JSONCONS_THROW(json_runtime_error<std::length_error>("Key too long"));
+            }
+            if (length <= inline_capacity)
+            {
+                return chars_;
+            }
+            allocator_type& alloc = *this;
+            CharT* p = jsoncons::detail::to_plain_pointer(allocator_traits_type::allocate(alloc, length));
+            std::memcpy(reinterpret_cast<char*>(chars_) + 4, &p, sizeof(p));
+            return p;
+        }
+
+        void finish_for(size_type length)
+        {
+            length_ = static_cast<uint32_t>(length);
+            if (!is_inline())
+            {
+                Traits::copy(chars_, heap_pointer(), prefix_length);
+            }
+        }
+
+        void assign(const CharT* s, size_type length)
+        {
+            CharT* p = allocate_for(length);
+            if (length > 0)
+            {
+                Traits::copy(p, s, length);
+            }
+            finish_for(length);
+        }
+
+        void deallocate() noexcept
+        {
+            if (!is_inline())
+            {
+                allocator_type& alloc = *this;
+                allocator_traits_type::deallocate(alloc, heap_pointer(), length_);
+            }
+            length_ = 0;
+        }
+    };
+
+    template <class CharT,class Traits,class Allocator>
+    constexpr std::size_t basic_small_key<CharT,Traits,Allocator>::inline_capacity;
+
+    template <class CharT,class Traits,class Allocator>
+    constexpr std::size_t basic_small_key<CharT,Traits,Allocator>::prefix_length;
+
+    template <class CharT,class Traits,class Allocator>
+    int compare_key(const basic_small_key<CharT,Traits,Allocator>& key, const jsoncons::basic_string_view<CharT,Traits>& name)
+    {
+        return key.compare(name);
+    }
+
+    using small_key = basic_small_key<char>;
+    using wsmall_key = basic_small_key<wchar_t>;
+
+} // namespace jsoncons
+
+#endif
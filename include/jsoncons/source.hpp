@@ -18,6 +18,7 @@
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons/byte_string.hpp> // jsoncons::byte_traits
 #include <jsoncons/detail/more_type_traits.hpp>
+#include <jsoncons/detail/span.hpp>
 
 namespace jsoncons { 
 
@@ -345,6 +346,13 @@ namespace jsoncons {
             current_  += len;
             return len;
         }
+
+        jsoncons::detail::span<const value_type> read_buffer()
+        {
+            jsoncons::detail::span<const value_type> s(current_, end_ - current_);
+            current_ = end_;
+            return s;
+        }
     };
 
     // iterator source
@@ -659,6 +667,13 @@ namespace jsoncons {
             current_  += len;
             return len;
         }
+
+        jsoncons::detail::span<const value_type> read_buffer()
+        {
+            jsoncons::detail::span<const value_type> s(current_, end_ - current_);
+            current_ = end_;
+            return s;
+        }
     };
 
     // binary_iterator source
@@ -737,6 +752,19 @@ namespace jsoncons {
         }
     };
 
+namespace detail {
+
+    // Sources that hold their input in memory may provide read_buffer(), which lends all of 
+    // the unread input, in one piece, to a reader instead of copying it into the reader's buffer
+
+    template <class Source>
+    using source_read_buffer_t = decltype(std::declval<Source&>().read_buffer());
+
+    template <class Source>
+    using has_read_buffer = is_detected_exact<span<const typename Source::value_type>,source_read_buffer_t,Source>;
+
+} // namespace detail
+
     template <class Source>
     struct source_reader
     {
@@ -0,0 +1,189 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_COMPRESSION_COMPRESS_SINK_HPP
+#define JSONCONS_COMPRESSION_COMPRESS_SINK_HPP
+
+#include <algorithm> // std::min, std::max
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <memory> // std::unique_ptr
+#include <type_traits>
+#include <utility> // std::forward
+#include <vector>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons_ext/compression/compression_options.hpp>
+
+namespace jsoncons { namespace compression {
+
+// Compresses the characters written to it with Compressor, and writes the compressed bytes
+// to Sink. The compressed stream is finished when the sink is destroyed.
+
+template <class CharT,class Sink,class Compressor>
+class basic_compress_sink
+{
+public:
+    using value_type = CharT;
+    using sink_type = Sink;
+private:
+    static_assert(sizeof(CharT) == 1, "basic_compress_sink requires a character type of size 1");
+
+    using sink_value_type = typename std::decay<Sink>::type::value_type;
+    static_assert(sizeof(sink_value_type) == 1, "basic_compress_sink requires a byte sink");
+
+    // A flush that fills the output exactly is followed by another flush marker,
+    // which must fit in the next output buffer
+    static constexpr std::size_t min_output_length = 256;
+
+    Sink sink_;
+    std::unique_ptr<Compressor> compressor_;
+    std::vector<value_type> input_;
+    std::size_t length_;
+    std::vector<uint8_t> output_;
+    bool is_error_;
+
+    // Noncopyable
+    basic_compress_sink(const basic_compress_sink&) = delete;
+    basic_compress_sink& operator=(const basic_compress_sink&) = delete;
+public:
+    explicit basic_compress_sink(Sink&& sink, const compression_options& options = compression_options())
+        : sink_(std::forward<Sink>(sink)),
+          compressor_(new Compressor(options.level())),
+          input_(options.buffer_length()),
+          length_(0),
+          output_((std::max)(options.buffer_length(), min_output_length)),
+          is_error_(compressor_->is_error())
+    {
+    }
+
+    basic_compress_sink(basic_compress_sink&&) = default;
+
+    ~basic_compress_sink() noexcept
+    {
+        if (compressor_)
+        {
+            JSONCONS_TRY
+            {
+                compress(detail::compress_op::finish);
+                sink_.flush();
+            }
+            JSONCONS_CATCH(...)
+            {
+            }
+        }
+    }
+
+    // True if the compressor failed. Output after an error is discarded.
+    bool is_error() const
+    {
+        return is_error_;
+    }
+
+    // Compresses the buffered characters, and writes everything compressed so far
+    // to the sink, without finishing the compressed stream
+    void flush()
+    {
+        compress(detail::compress_op::flush);
+        sink_.flush();
+    }
+
+    void push_back(value_type ch)
+    {
+        if (length_ == input_.size())
+        {
+            compress(detail::compress_op::process);
+        }
+        input_[length_++] = ch;
+    }
+
+    void append(const value_type* s, std::size_t length)
+    {
+        if (length >= input_.size())
+        {
+            // Compress the caller's characters where they are
+            compress(detail::compress_op::process);
+            compress(s, length, detail::compress_op::process);
+            return;
+        }
+        while (length > 0)
+        {
+            if (length_ == input_.size())
+            {
+                compress(detail::compress_op::process);
+            }
+            std::size_t n = (std::min)(length, input_.size() - length_);
+            std::memcpy(input_.data() + length_, s, n);
+            length_ += n;
+            s += n;
+            length -= n;
+        }
+    }
+
+    value_type* reserve(std::size_t n)
+    {
+        if (input_.size() - length_ < n)
+        {
+            compress(detail::compress_op::process);
+            if (input_.size() < n)
+            {
+                input_.resize(n);
+            }
+        }
+        return input_.data() + length_;
+    }
+
+    void commit(std::size_t n)
+    {
+        length_ += n;
+    }
+private:
+    void compress(detail::compress_op op)
+    {
+        compress(input_.data(), length_, op);
+        length_ = 0;
+    }
+
+    void compress(const value_type* data, std::size_t length, detail::compress_op op)
+    {
+        if (is_error_)
+        {
+            return;
+        }
+        detail::codec_buffer buf;
+        buf.next_in = reinterpret_cast<const uint8_t*>(data);
+        buf.avail_in = length;
+        while (true)
+        {
+            std::size_t avail_in = buf.avail_in;
+            buf.next_out = output_.data();
+            buf.avail_out = output_.size();
+            int rc = compressor_->compress(buf, op);
+            std::size_t produced = output_.size() - buf.avail_out;
+            if (produced > 0)
+            {
+                sink_.append(reinterpret_cast<const sink_value_type*>(output_.data()), produced);
+            }
+            if (rc < 0 || (rc == 0 && produced == 0 && buf.avail_in == avail_in))
+            {
+                is_error_ = true;
+                return;
+            }
+            if (rc > 0)
+            {
+                return;
+            }
+        }
+    }
+};
+
+template <class CharT,class Sink,class Compressor>
+constexpr std::size_t basic_compress_sink<CharT,Sink,Compressor>::min_output_length;
+
+} // namespace compression
+} // namespace jsoncons
+
+#endif
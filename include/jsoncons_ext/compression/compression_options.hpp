@@ -0,0 +1,74 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_COMPRESSION_COMPRESSION_OPTIONS_HPP
+#define JSONCONS_COMPRESSION_COMPRESSION_OPTIONS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits> // std::numeric_limits
+#include <jsoncons/config/jsoncons_config.hpp>
+
+namespace jsoncons { namespace compression {
+
+class compression_options
+{
+    int level_;
+    std::size_t buffer_length_;
+public:
+    // Selects the default level of the compression format
+    static constexpr int default_level = (std::numeric_limits<int>::min)();
+    static constexpr std::size_t default_buffer_length = 65536;
+
+    compression_options()
+        : level_(default_level),
+          buffer_length_(default_buffer_length)
+    {
+    }
+
+    int level() const
+    {
+        return level_;
+    }
+
+    compression_options& level(int value)
+    {
+        level_ = value;
+        return *this;
+    }
+
+    std::size_t buffer_length() const
+    {
+        return buffer_length_;
+    }
+
+    compression_options& buffer_length(std::size_t value)
+    {
+        buffer_length_ = value > 0 ? value : 1;
+        return *this;
+    }
+};
+
+namespace detail {
+
+    // The input and output of one step of a compressor or decompressor
+
+    struct codec_buffer
+    {
+        const uint8_t* next_in;
+        std::size_t avail_in;
+        uint8_t* next_out;
+        std::size_t avail_out;
+    };
+
+    enum class compress_op {process, flush, finish};
+
+} // namespace detail
+
+} // namespace compression
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,202 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_COMPRESSION_DECOMPRESS_SOURCE_HPP
+#define JSONCONS_COMPRESSION_DECOMPRESS_SOURCE_HPP
+
+#include <algorithm> // std::min
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <memory> // std::unique_ptr
+#include <type_traits>
+#include <utility> // std::forward
+#include <vector>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/source.hpp>
+#include <jsoncons_ext/compression/compression_options.hpp>
+
+namespace jsoncons { namespace compression {
+
+// Reads compressed bytes from Source in chunks, and decompresses them with Decompressor
+// as the characters are read. Concatenated compressed streams are read as one.
+
+template <class CharT,class Source,class Decompressor>
+class basic_decompress_source
+{
+public:
+    using value_type = CharT;
+    using source_type = Source;
+private:
+    static_assert(sizeof(CharT) == 1, "basic_decompress_source requires a character type of size 1");
+
+    using source_value_type = typename std::decay<Source>::type::value_type;
+    static_assert(sizeof(source_value_type) == 1, "basic_decompress_source requires a byte source");
+
+    Source source_;
+    std::unique_ptr<Decompressor> decompressor_;
+    std::vector<source_value_type> input_;
+    std::size_t input_offset_;
+    std::size_t input_length_;
+    std::vector<value_type> output_;
+    std::size_t output_offset_;
+    std::size_t output_length_;
+    std::size_t position_;
+    bool output_full_;
+    bool in_stream_;
+    bool done_;
+    bool is_error_;
+
+    // Noncopyable
+    basic_decompress_source(const basic_decompress_source&) = delete;
+    basic_decompress_source& operator=(const basic_decompress_source&) = delete;
+public:
+    explicit basic_decompress_source(Source&& source, const compression_options& options = compression_options())
+        : source_(std::forward<Source>(source)),
+          decompressor_(new Decompressor()),
+          input_(options.buffer_length()),
+          input_offset_(0),
+          input_length_(0),
+          output_(options.buffer_length()),
+          output_offset_(0),
+          output_length_(0),
+          position_(0),
+          output_full_(false),
+          in_stream_(false),
+          done_(decompressor_->is_error()),
+          is_error_(decompressor_->is_error())
+    {
+    }
+
+    basic_decompress_source(basic_decompress_source&&) = default;
+
+    ~basic_decompress_source() noexcept = default;
+
+    bool eof() const
+    {
+        return output_offset_ == output_length_ && done_;
+    }
+
+    // True if the compressed input could not be read, is corrupt or is truncated
+    bool is_error() const
+    {
+        return is_error_;
+    }
+
+    std::size_t position() const
+    {
+        return position_;
+    }
+
+    character_result<value_type> get_character()
+    {
+        if (output_offset_ == output_length_ && !fill())
+        {
+            return character_result<value_type>();
+        }
+        ++position_;
+        return character_result<value_type>(output_[output_offset_++]);
+    }
+
+    void ignore(std::size_t count)
+    {
+        while (count > 0 && (output_offset_ < output_length_ || fill()))
+        {
+            std::size_t n = (std::min)(count, output_length_ - output_offset_);
+            output_offset_ += n;
+            position_ += n;
+            count -= n;
+        }
+    }
+
+    character_result<value_type> peek_character()
+    {
+        if (output_offset_ == output_length_ && !fill())
+        {
+            return character_result<value_type>();
+        }
+        return character_result<value_type>(output_[output_offset_]);
+    }
+
+    std::size_t read(value_type* p, std::size_t length)
+    {
+        std::size_t count = 0;
+        while (count < length && (output_offset_ < output_length_ || fill()))
+        {
+            std::size_t n = (std::min)(length - count, output_length_ - output_offset_);
+            std::memcpy(p + count, output_.data() + output_offset_, n);
+            output_offset_ += n;
+            count += n;
+        }
+        position_ += count;
+        return count;
+    }
+private:
+    // Decompresses the next part of the input into the output buffer
+    bool fill()
+    {
+        output_offset_ = 0;
+        output_length_ = 0;
+        while (output_length_ == 0 && !done_)
+        {
+            if (input_offset_ == input_length_ && !output_full_)
+            {
+                input_offset_ = 0;
+                input_length_ = source_.read(input_.data(), input_.size());
+                if (source_.is_error() || (input_length_ == 0 && in_stream_))
+                {
+                    fail();
+                    break;
+                }
+                if (input_length_ == 0)
+                {
+                    done_ = true;
+                    break;
+                }
+            }
+
+            detail::codec_buffer buf;
+            buf.next_in = reinterpret_cast<const uint8_t*>(input_.data() + input_offset_);
+            buf.avail_in = input_length_ - input_offset_;
+            std::size_t avail_in = buf.avail_in;
+            buf.next_out = reinterpret_cast<uint8_t*>(output_.data());
+            buf.avail_out = output_.size();
+            int rc = decompressor_->decompress(buf);
+
+            std::size_t consumed = avail_in - buf.avail_in;
+            input_offset_ += consumed;
+            output_length_ = output_.size() - buf.avail_out;
+            output_full_ = buf.avail_out == 0;
+            if (rc < 0 || (rc == 0 && avail_in > 0 && consumed == 0 && output_length_ == 0))
+            {
+                fail();
+                break;
+            }
+            if (rc > 0)
+            {
+                // End of a compressed stream, another may follow
+                in_stream_ = false;
+                decompressor_->reset();
+            }
+            else
+            {
+                in_stream_ = true;
+            }
+        }
+        return output_length_ > 0;
+    }
+
+    void fail()
+    {
+        is_error_ = true;
+        done_ = true;
+    }
+};
+
+} // namespace compression
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,185 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_COMPRESSION_GZIP_HPP
+#define JSONCONS_COMPRESSION_GZIP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memset
+#include <limits> // std::numeric_limits
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/sink.hpp>
+#include <jsoncons/source.hpp>
+#include <jsoncons_ext/compression/compression_options.hpp>
+#include <jsoncons_ext/compression/compress_sink.hpp>
+#include <jsoncons_ext/compression/decompress_source.hpp>
+#include <zlib.h>
+
+namespace jsoncons { namespace compression {
+
+namespace detail {
+
+    // zlib takes lengths as uInt
+    inline
+    uInt zlib_length(std::size_t length)
+    {
+        return length < (std::numeric_limits<uInt>::max)() ? static_cast<uInt>(length) : (std::numeric_limits<uInt>::max)();
+    }
+
+    class gzip_compressor
+    {
+        z_stream strm_;
+        bool is_error_;
+
+        // Noncopyable and nonmoveable, zlib keeps a pointer to strm_
+        gzip_compressor(const gzip_compressor&) = delete;
+        gzip_compressor& operator=(const gzip_compressor&) = delete;
+    public:
+        explicit gzip_compressor(int level)
+        {
+            std::memset(&strm_, 0, sizeof(strm_));
+            if (level == compression_options::default_level)
+            {
+                level = Z_DEFAULT_COMPRESSION;
+            }
+            // 15 + 16 selects the largest window and the gzip format
+            is_error_ = deflateInit2(&strm_, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK;
+        }
+
+        ~gzip_compressor() noexcept
+        {
+            if (!is_error_)
+            {
+                deflateEnd(&strm_);
+            }
+        }
+
+        bool is_error() const
+        {
+            return is_error_;
+        }
+
+        // Returns 1 when the input is consumed, and for flush and finish, all of the output
+        // has been produced, 0 when it should be called again with an empty output buffer,
+        // and -1 on error
+        int compress(codec_buffer& buf, compress_op op)
+        {
+            int flush = op == compress_op::process ? Z_NO_FLUSH : op == compress_op::flush ? Z_SYNC_FLUSH : Z_FINISH;
+
+            uInt avail_in = zlib_length(buf.avail_in);
+            uInt avail_out = zlib_length(buf.avail_out);
+            strm_.next_in = const_cast<Bytef*>(buf.next_in);
+            strm_.avail_in = avail_in;
+            strm_.next_out = buf.next_out;
+            strm_.avail_out = avail_out;
+            int rc = deflate(&strm_, buf.avail_in > avail_in ? Z_NO_FLUSH : flush);
+            buf.next_in += avail_in - strm_.avail_in;
+            buf.avail_in -= avail_in - strm_.avail_in;
+            buf.next_out += avail_out - strm_.avail_out;
+            buf.avail_out -= avail_out - strm_.avail_out;
+
+            if (rc == Z_STREAM_ERROR)
+            {
+                return -1;
+            }
+            if (rc == Z_STREAM_END)
+            {
+                // Later output starts a new gzip member
+                deflateReset(&strm_);
+                return 1;
+            }
+            if (buf.avail_in > 0)
+            {
+                return 0;
+            }
+            switch (op)
+            {
+                case compress_op::process:
+                    return 1;
+                case compress_op::flush:
+                    return strm_.avail_out > 0 ? 1 : 0;
+                default:
+                    return 0;
+            }
+        }
+    };
+
+    class gzip_decompressor
+    {
+        z_stream strm_;
+        bool is_error_;
+
+        // Noncopyable and nonmoveable, zlib keeps a pointer to strm_
+        gzip_decompressor(const gzip_decompressor&) = delete;
+        gzip_decompressor& operator=(const gzip_decompressor&) = delete;
+    public:
+        gzip_decompressor()
+        {
+            std::memset(&strm_, 0, sizeof(strm_));
+            // 15 + 32 selects the largest window and detects the gzip or zlib format
+            is_error_ = inflateInit2(&strm_, 15 + 32) != Z_OK;
+        }
+
+        ~gzip_decompressor() noexcept
+        {
+            if (!is_error_)
+            {
+                inflateEnd(&strm_);
+            }
+        }
+
+        bool is_error() const
+        {
+            return is_error_;
+        }
+
+        void reset()
+        {
+            inflateReset(&strm_);
+        }
+
+        // Returns 1 at the end of a compressed stream, 0 when it should be called again
+        // with more input or an empty output buffer, and -1 on error
+        int decompress(codec_buffer& buf)
+        {
+            uInt avail_in = zlib_length(buf.avail_in);
+            uInt avail_out = zlib_length(buf.avail_out);
+            strm_.next_in = const_cast<Bytef*>(buf.next_in);
+            strm_.avail_in = avail_in;
+            strm_.next_out = buf.next_out;
+            strm_.avail_out = avail_out;
+            int rc = inflate(&strm_, Z_NO_FLUSH);
+            buf.next_in += avail_in - strm_.avail_in;
+            buf.avail_in -= avail_in - strm_.avail_in;
+            buf.next_out += avail_out - strm_.avail_out;
+            buf.avail_out -= avail_out - strm_.avail_out;
+
+            switch (rc)
+            {
+                case Z_STREAM_END:
+                    return 1;
+                case Z_OK:
+                case Z_BUF_ERROR:
+                    return 0;
+                default:
+                    return -1;
+            }
+        }
+    };
+
+} // namespace detail
+
+template <class CharT,class Sink=jsoncons::binary_stream_sink>
+using gzip_sink = basic_compress_sink<CharT,Sink,detail::gzip_compressor>;
+
+template <class CharT,class Source=jsoncons::binary_stream_source>
+using gzip_source = basic_decompress_source<CharT,Source,detail::gzip_decompressor>;
+
+} // namespace compression
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,142 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_COMPRESSION_ZSTD_HPP
+#define JSONCONS_COMPRESSION_ZSTD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/sink.hpp>
+#include <jsoncons/source.hpp>
+#include <jsoncons_ext/compression/compression_options.hpp>
+#include <jsoncons_ext/compression/compress_sink.hpp>
+#include <jsoncons_ext/compression/decompress_source.hpp>
+#include <zstd.h>
+
+namespace jsoncons { namespace compression {
+
+namespace detail {
+
+    // Requires zstd 1.4.0 or later
+
+    class zstd_compressor
+    {
+        ZSTD_CCtx* cctx_;
+        bool is_error_;
+
+        // Noncopyable
+        zstd_compressor(const zstd_compressor&) = delete;
+        zstd_compressor& operator=(const zstd_compressor&) = delete;
+    public:
+        explicit zstd_compressor(int level)
+            : cctx_(ZSTD_createCCtx()), is_error_(false)
+        {
+            if (level == compression_options::default_level)
+            {
+                level = ZSTD_CLEVEL_DEFAULT;
+            }
+            is_error_ = cctx_ == nullptr || ZSTD_isError(ZSTD_CCtx_setParameter(cctx_, ZSTD_c_compressionLevel, level));
+        }
+
+        ~zstd_compressor() noexcept
+        {
+            ZSTD_freeCCtx(cctx_);
+        }
+
+        bool is_error() const
+        {
+            return is_error_;
+        }
+
+        // Returns 1 when the input is consumed, and for flush and finish, all of the output
+        // has been produced, 0 when it should be called again with an empty output buffer,
+        // and -1 on error
+        int compress(codec_buffer& buf, compress_op op)
+        {
+            ZSTD_EndDirective directive = op == compress_op::process ? ZSTD_e_continue : op == compress_op::flush ? ZSTD_e_flush : ZSTD_e_end;
+
+            ZSTD_inBuffer input = {buf.next_in, buf.avail_in, 0};
+            ZSTD_outBuffer output = {buf.next_out, buf.avail_out, 0};
+            std::size_t remaining = ZSTD_compressStream2(cctx_, &output, &input, directive);
+            buf.next_in += input.pos;
+            buf.avail_in -= input.pos;
+            buf.next_out += output.pos;
+            buf.avail_out -= output.pos;
+
+            if (ZSTD_isError(remaining))
+            {
+                return -1;
+            }
+            if (buf.avail_in > 0)
+            {
+                return 0;
+            }
+            // Later output after ZSTD_e_end starts a new frame
+            return op == compress_op::process || remaining == 0 ? 1 : 0;
+        }
+    };
+
+    class zstd_decompressor
+    {
+        ZSTD_DCtx* dctx_;
+
+        // Noncopyable
+        zstd_decompressor(const zstd_decompressor&) = delete;
+        zstd_decompressor& operator=(const zstd_decompressor&) = delete;
+    public:
+        zstd_decompressor()
+            : dctx_(ZSTD_createDCtx())
+        {
+        }
+
+        ~zstd_decompressor() noexcept
+        {
+            ZSTD_freeDCtx(dctx_);
+        }
+
+        bool is_error() const
+        {
+            return dctx_ == nullptr;
+        }
+
+        void reset()
+        {
+            ZSTD_DCtx_reset(dctx_, ZSTD_reset_session_only);
+        }
+
+        // Returns 1 at the end of a frame, 0 when it should be called again with more input
+        // or an empty output buffer, and -1 on error
+        int decompress(codec_buffer& buf)
+        {
+            ZSTD_inBuffer input = {buf.next_in, buf.avail_in, 0};
+            ZSTD_outBuffer output = {buf.next_out, buf.avail_out, 0};
+            std::size_t rc = ZSTD_decompressStream(dctx_, &output, &input);
+            buf.next_in += input.pos;
+            buf.avail_in -= input.pos;
+            buf.next_out += output.pos;
+            buf.avail_out -= output.pos;
+
+            if (ZSTD_isError(rc))
+            {
+                return -1;
+            }
+            return rc == 0 ? 1 : 0;
+        }
+    };
+
+} // namespace detail
+
+template <class CharT,class Sink=jsoncons::binary_stream_sink>
+using zstd_sink = basic_compress_sink<CharT,Sink,detail::zstd_compressor>;
+
+template <class CharT,class Source=jsoncons::binary_stream_source>
+using zstd_source = basic_decompress_source<CharT,Source,detail::zstd_decompressor>;
+
+} // namespace compression
+} // namespace jsoncons
+
+#endif
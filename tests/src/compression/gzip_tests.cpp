@@ -0,0 +1,281 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(JSONCONS_HAS_ZLIB)
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_cursor.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <jsoncons_ext/msgpack/msgpack.hpp>
+#include <jsoncons_ext/compression/gzip.hpp>
+#include <catch/catch.hpp>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+using namespace jsoncons::compression;
+
+namespace {
+
+    std::string read_file(const std::string& path)
+    {
+        std::ifstream is(path, std::ios::binary);
+        std::ostringstream os;
+        os << is.rdbuf();
+        return os.str();
+    }
+
+    std::vector<compression_options> all_options()
+    {
+        std::vector<compression_options> v;
+        v.push_back(compression_options());
+        v.push_back(compression_options().buffer_length(1));
+        v.push_back(compression_options().buffer_length(7).level(1));
+        v.push_back(compression_options().buffer_length(1000).level(9));
+        return v;
+    }
+
+    std::string gunzip(const std::string& compressed)
+    {
+        std::istringstream is(compressed);
+        gzip_source<char> source(is);
+        std::string s;
+        char buf[100];
+        std::size_t n;
+        while ((n = source.read(buf, sizeof(buf))) > 0)
+        {
+            s.append(buf, n);
+        }
+        CHECK_FALSE(source.is_error());
+        CHECK(source.eof());
+        return s;
+    }
+}
+
+TEST_CASE("gzip json")
+{
+    json j = json::parse(read_file("./input/cyrillic.json"));
+
+    std::string expected;
+    j.dump(expected);
+
+    for (const auto& options : all_options())
+    {
+        std::ostringstream os;
+        {
+            basic_compact_json_encoder<char,gzip_sink<char>> encoder(gzip_sink<char>(os, options));
+            j.dump(encoder);
+        }
+        std::string compressed = os.str();
+        CHECK(compressed.size() < expected.size() / 4);
+        CHECK(compressed.substr(0,2) == "\x1f\x8b");
+
+        std::istringstream is(compressed);
+        json_decoder<json> decoder;
+        basic_json_reader<char,gzip_source<char>> reader(gzip_source<char>(is, options), decoder);
+        reader.read();
+        CHECK(decoder.get_result() == j);
+
+        CHECK(gunzip(compressed) == expected);
+    }
+}
+
+TEST_CASE("gzip json cursor")
+{
+    json j = json::parse(read_file("./input/cyrillic.json"));
+    std::string text;
+    j.dump(text);
+    std::ostringstream os;
+    {
+        basic_json_encoder<char,gzip_sink<char>> encoder(gzip_sink<char>(os, compression_options()));
+        j.dump(encoder);
+    }
+
+    json_cursor expected(text);
+    std::istringstream is(os.str());
+    basic_json_cursor<char,gzip_source<char>> cursor(gzip_source<char>(is, compression_options().buffer_length(16)));
+    std::size_t count = 0;
+    for (; !cursor.done(); cursor.next(), expected.next())
+    {
+        REQUIRE_FALSE(expected.done());
+        CHECK(cursor.current().event_type() == expected.current().event_type());
+        if (cursor.current().event_type() == staj_event_type::key || cursor.current().event_type() == staj_event_type::string_value)
+        {
+            CHECK(cursor.current().get<std::string>() == expected.current().get<std::string>());
+        }
+        ++count;
+    }
+    CHECK(expected.done());
+    CHECK(count > 1000);
+}
+
+TEST_CASE("gzip cbor and msgpack")
+{
+    json j = json::parse(read_file("./input/cyrillic.json"));
+
+    SECTION("cbor")
+    {
+        std::vector<uint8_t> expected;
+        cbor::encode_cbor(j, expected);
+
+        for (const auto& options : all_options())
+        {
+            std::vector<uint8_t> compressed;
+            {
+                cbor::basic_cbor_encoder<gzip_sink<uint8_t,bytes_sink<std::vector<uint8_t>>>> encoder(
+                    gzip_sink<uint8_t,bytes_sink<std::vector<uint8_t>>>(compressed, options));
+                j.dump(encoder);
+            }
+            CHECK(compressed.size() < expected.size() / 4);
+
+            json_decoder<json> decoder;
+            cbor::basic_cbor_reader<gzip_source<uint8_t,bytes_source>> reader(
+                gzip_source<uint8_t,bytes_source>(compressed, options), decoder);
+            reader.read();
+            CHECK(decoder.get_result() == j);
+
+            cbor::basic_cbor_cursor<gzip_source<uint8_t,bytes_source>> cursor(gzip_source<uint8_t,bytes_source>(compressed, options));
+            CHECK(cursor.current().event_type() == staj_event_type::begin_object);
+        }
+    }
+
+    SECTION("msgpack")
+    {
+        std::ostringstream os;
+        {
+            msgpack::basic_msgpack_encoder<gzip_sink<uint8_t>> encoder(gzip_sink<uint8_t>(os, compression_options()));
+            j.dump(encoder);
+        }
+        std::istringstream is(os.str());
+        json_decoder<json> decoder;
+        msgpack::basic_msgpack_reader<gzip_source<uint8_t>> reader(gzip_source<uint8_t>(is), decoder);
+        reader.read();
+        CHECK(decoder.get_result() == j);
+    }
+}
+
+TEST_CASE("gzip sink")
+{
+    SECTION("flush makes the output so far readable")
+    {
+        std::ostringstream os;
+        gzip_sink<char> sink(os);
+        sink.append("[1,2,", 5);
+        sink.flush();
+
+        std::istringstream is(os.str());
+        gzip_source<char> source(is);
+        char buf[10];
+        CHECK(source.read(buf, sizeof(buf)) == 5);
+        CHECK(std::string(buf, 5) == "[1,2,");
+        // The stream is not finished
+        CHECK(source.is_error());
+    }
+
+    SECTION("reserve and commit")
+    {
+        std::ostringstream os;
+        {
+            gzip_sink<char> sink(os, compression_options().buffer_length(4));
+            sink.push_back('a');
+            char* p = sink.reserve(10);
+            std::memcpy(p, "0123456789", 10);
+            sink.commit(10);
+            sink.append("bcdefgh", 7);
+        }
+        CHECK(gunzip(os.str()) == "a0123456789bcdefgh");
+    }
+
+    SECTION("empty")
+    {
+        std::ostringstream os;
+        {
+            gzip_sink<char> sink(os);
+        }
+        CHECK_FALSE(os.str().empty());
+        CHECK(gunzip(os.str()).empty());
+    }
+}
+
+TEST_CASE("gzip source")
+{
+    std::string text = read_file("./input/cyrillic.json");
+
+    SECTION("zlib format")
+    {
+        std::vector<uint8_t> compressed(compressBound(static_cast<uLong>(text.size())));
+        uLongf length = static_cast<uLongf>(compressed.size());
+        REQUIRE(compress2(compressed.data(), &length, reinterpret_cast<const Bytef*>(text.data()), static_cast<uLong>(text.size()), 6) == Z_OK);
+        compressed.resize(length);
+
+        gzip_source<char,bytes_source> source(compressed);
+        std::string s(text.size() + 10, ' ');
+        CHECK(source.read(&s[0], s.size()) == text.size());
+        CHECK(s.substr(0, text.size()) == text);
+        CHECK(source.eof());
+        CHECK_FALSE(source.is_error());
+        CHECK(source.position() == text.size());
+    }
+
+    SECTION("concatenated gzip members")
+    {
+        std::ostringstream os;
+        {
+            gzip_sink<char> sink(os);
+            sink.append("[1,", 3);
+        }
+        {
+            gzip_sink<char> sink(os);
+            sink.append("2]", 2);
+        }
+        CHECK(gunzip(os.str()) == "[1,2]");
+    }
+
+    SECTION("get_character, peek_character and ignore")
+    {
+        std::ostringstream os;
+        {
+            gzip_sink<char> sink(os);
+            sink.append("abcdef", 6);
+        }
+        std::istringstream is(os.str());
+        gzip_source<char> source(is, compression_options().buffer_length(2));
+        CHECK(source.peek_character().value() == 'a');
+        CHECK(source.get_character().value() == 'a');
+        source.ignore(3);
+        CHECK(source.position() == 4);
+        CHECK(source.get_character().value() == 'e');
+        CHECK(source.get_character().value() == 'f');
+        CHECK_FALSE(source.get_character());
+        CHECK(source.eof());
+    }
+
+    SECTION("corrupt and truncated input")
+    {
+        std::ostringstream os;
+        {
+            basic_compact_json_encoder<char,gzip_sink<char>> encoder(gzip_sink<char>(os, compression_options()));
+            json::parse(text).dump(encoder);
+        }
+        std::string compressed = os.str();
+
+        std::string corrupt = compressed;
+        corrupt[1] = 'x';
+        std::string truncated = compressed.substr(0, compressed.size() - 10);
+
+        for (const auto& input : std::vector<std::string>{corrupt, truncated})
+        {
+            std::istringstream is(input);
+            std::error_code ec;
+            json_decoder<json> decoder;
+            basic_json_reader<char,gzip_source<char>> reader(gzip_source<char>(is), decoder);
+            reader.read(ec);
+            CHECK(ec == json_errc::source_error);
+        }
+    }
+}
+
+#endif
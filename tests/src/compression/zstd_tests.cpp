@@ -0,0 +1,138 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(JSONCONS_HAS_ZSTD)
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_cursor.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <jsoncons_ext/compression/zstd.hpp>
+#include <catch/catch.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+using namespace jsoncons::compression;
+
+namespace {
+
+    std::string read_file(const std::string& path)
+    {
+        std::ifstream is(path, std::ios::binary);
+        std::ostringstream os;
+        os << is.rdbuf();
+        return os.str();
+    }
+
+    std::vector<compression_options> all_options()
+    {
+        std::vector<compression_options> v;
+        v.push_back(compression_options());
+        v.push_back(compression_options().buffer_length(1));
+        v.push_back(compression_options().buffer_length(7).level(1));
+        v.push_back(compression_options().buffer_length(1000).level(19));
+        return v;
+    }
+
+    std::string unzstd(const std::string& compressed)
+    {
+        std::istringstream is(compressed);
+        zstd_source<char> source(is);
+        std::string s;
+        char buf[100];
+        std::size_t n;
+        while ((n = source.read(buf, sizeof(buf))) > 0)
+        {
+            s.append(buf, n);
+        }
+        CHECK_FALSE(source.is_error());
+        CHECK(source.eof());
+        return s;
+    }
+}
+
+TEST_CASE("zstd json")
+{
+    json j = json::parse(read_file("./input/cyrillic.json"));
+
+    std::string expected;
+    j.dump(expected);
+
+    for (const auto& options : all_options())
+    {
+        std::ostringstream os;
+        {
+            basic_compact_json_encoder<char,zstd_sink<char>> encoder(zstd_sink<char>(os, options));
+            j.dump(encoder);
+        }
+        std::string compressed = os.str();
+        CHECK(compressed.size() < expected.size() / 4);
+        CHECK(compressed.substr(0,4) == "\x28\xb5\x2f\xfd");
+
+        std::istringstream is(compressed);
+        json_decoder<json> decoder;
+        basic_json_reader<char,zstd_source<char>> reader(zstd_source<char>(is, options), decoder);
+        reader.read();
+        CHECK(decoder.get_result() == j);
+
+        CHECK(unzstd(compressed) == expected);
+    }
+}
+
+TEST_CASE("zstd cbor")
+{
+    json j = json::parse(read_file("./input/cyrillic.json"));
+
+    std::vector<uint8_t> compressed;
+    {
+        cbor::basic_cbor_encoder<zstd_sink<uint8_t,bytes_sink<std::vector<uint8_t>>>> encoder(
+            zstd_sink<uint8_t,bytes_sink<std::vector<uint8_t>>>(compressed, compression_options()));
+        j.dump(encoder);
+    }
+
+    json_decoder<json> decoder;
+    cbor::basic_cbor_reader<zstd_source<uint8_t,bytes_source>> reader(
+        zstd_source<uint8_t,bytes_source>(compressed, compression_options().buffer_length(10)), decoder);
+    reader.read();
+    CHECK(decoder.get_result() == j);
+}
+
+TEST_CASE("zstd source")
+{
+    SECTION("flush and concatenated frames")
+    {
+        std::ostringstream os;
+        {
+            zstd_sink<char> sink(os, compression_options());
+            sink.append("[1,", 3);
+            sink.flush();
+            sink.append("2,", 2);
+        }
+        {
+            zstd_sink<char> sink(os, compression_options());
+            sink.append("3]", 2);
+        }
+        CHECK(unzstd(os.str()) == "[1,2,3]");
+    }
+
+    SECTION("truncated input")
+    {
+        std::ostringstream os;
+        {
+            basic_compact_json_encoder<char,zstd_sink<char>> encoder(zstd_sink<char>(os, compression_options()));
+            json::parse(read_file("./input/cyrillic.json")).dump(encoder);
+        }
+        std::string compressed = os.str();
+
+        std::istringstream is(compressed.substr(0, compressed.size() - 10));
+        std::error_code ec;
+        json_decoder<json> decoder;
+        basic_json_reader<char,zstd_source<char>> reader(zstd_source<char>(is), decoder);
+        reader.read(ec);
+        CHECK(ec == json_errc::source_error);
+    }
+}
+
+#endif
@@ -0,0 +1,250 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    const std::string document = R"(
+    {
+        "id" : 1,
+        "name" : "a name long enough to be heap allocated",
+        "tags" : ["first","second","third"],
+        "location" : {"city" : "Toronto", "coordinates" : [43.6532,-79.3832]}
+    }
+    )";
+
+    template <class Json>
+    void check_copy_on_write()
+    {
+        Json j = Json::parse(document);
+        CHECK(j.use_count() == 1);
+
+        Json copy(j);
+        CHECK(j.use_count() == 2);
+        CHECK(copy.use_count() == 2);
+        CHECK(copy == j);
+
+        const Json& cj = j;
+        const Json& ccopy = copy;
+        CHECK(&cj.at("location") == &ccopy.at("location"));
+
+        // Modifying the copy gives it an object of its own, which still shares the nested values
+        copy["id"] = 2;
+        CHECK(j.use_count() == 1);
+        CHECK(copy.use_count() == 1);
+        CHECK(cj.at("id").template as<int>() == 1);
+        CHECK(ccopy.at("id").template as<int>() == 2);
+        CHECK(cj.at("location").use_count() == 2);
+        CHECK(cj.at("tags").use_count() == 2);
+        CHECK_FALSE(copy == j);
+
+        copy["tags"].push_back("fourth");
+        CHECK(cj.at("tags").size() == 3);
+        CHECK(ccopy.at("tags").size() == 4);
+        CHECK(cj.at("tags").use_count() == 1);
+        CHECK(cj.at("location").use_count() == 2);
+
+        // Assignment shares too
+        Json assigned;
+        assigned = j;
+        CHECK(j.use_count() == 2);
+        assigned.erase("location");
+        CHECK(j.contains("location"));
+        CHECK(j.use_count() == 1);
+
+        CHECK(j.at("id").template as<int>() == 1);
+    }
+
+    // Alternates arrays and objects
+    template <class Json>
+    Json make_nested(std::size_t n)
+    {
+        Json j(json_array_arg);
+        j.push_back(0);
+        for (std::size_t i = 1; i < n; ++i)
+        {
+            if (i % 2 == 0)
+            {
+                Json outer(json_array_arg);
+                outer.push_back(std::move(j));
+                j = std::move(outer);
+            }
+            else
+            {
+                Json outer(json_object_arg);
+                outer.try_emplace("a", std::move(j));
+                j = std::move(outer);
+            }
+        }
+        return j;
+    }
+}
+
+TEST_CASE("copy on write tests")
+{
+    SECTION("cow_json")
+    {
+        check_copy_on_write<cow_json>();
+    }
+    SECTION("cow_ojson")
+    {
+        check_copy_on_write<cow_ojson>();
+    }
+    SECTION("hashed_policy")
+    {
+        check_copy_on_write<basic_json<char,copy_on_write_policy<hashed_policy>,std::allocator<char>>>();
+    }
+    SECTION("hashed_preserve_order_policy")
+    {
+        check_copy_on_write<basic_json<char,copy_on_write_policy<hashed_preserve_order_policy>,std::allocator<char>>>();
+    }
+    SECTION("other policies copy")
+    {
+        json j = json::parse(document);
+        json copy(j);
+        CHECK(j.use_count() == 1);
+        CHECK(copy.use_count() == 1);
+        CHECK(json(1).use_count() == 0);
+    }
+    SECTION("arrays")
+    {
+        cow_json a(json_array_arg);
+        a.push_back(cow_json::parse(document));
+        a.push_back(a[0]);
+        CHECK(a[0].use_count() == 2);
+
+        cow_json copy = a;
+        const cow_json& ca = a;
+        copy[1]["id"] = 3;
+        CHECK(ca[0].at("id").as<int>() == 1);
+        CHECK(ca[1].at("id").as<int>() == 1);
+        CHECK(copy[1]["id"].as<int>() == 3);
+    }
+}
+
+TEST_CASE("copy on write after a reference is handed out")
+{
+    SECTION("reference to a member")
+    {
+        cow_json a = cow_json::parse(R"({"x":{"z":1}})");
+        cow_json& r = a["x"];
+        cow_json b = a;
+        r["y"] = 2;
+        CHECK(a.to_string() == R"({"x":{"y":2,"z":1}})");
+        CHECK(b.to_string() == R"({"x":{"z":1}})");
+
+        // The copy has not handed out references, so it is shared
+        cow_json c = b;
+        CHECK(b.use_count() == 2);
+    }
+
+    SECTION("reference to a nested member")
+    {
+        cow_json a = cow_json::parse(R"({"x":{"z":[1,2]}})");
+        cow_json& r = a["x"]["z"];
+        cow_json b = a;
+        r.push_back(3);
+        CHECK(a.to_string() == R"({"x":{"z":[1,2,3]}})");
+        CHECK(b.to_string() == R"({"x":{"z":[1,2]}})");
+    }
+
+    SECTION("iterator")
+    {
+        cow_json a = cow_json::parse(R"([{"z":1},{"z":2}])");
+        auto it = a.array_range().begin();
+        cow_json b = a;
+        *it = 0;
+        CHECK(a.to_string() == R"([0,{"z":2}])");
+        CHECK(b.to_string() == R"([{"z":1},{"z":2}])");
+    }
+
+    SECTION("const access leaves the value shared")
+    {
+        cow_json a = cow_json::parse(R"({"x":{"z":1}})");
+        const cow_json& ca = a;
+        CHECK(ca.at("x").at("z").as<int>() == 1);
+        cow_json b = a;
+        CHECK(a.use_count() == 2);
+    }
+
+    SECTION("a reference from const access follows the shared object")
+    {
+        cow_json a = cow_json::parse(R"({"x":{"z":1}})");
+        const cow_json& ca = a;
+        const cow_json& r = ca.at("x");
+        cow_json b = a;
+        a["y"] = 2;
+
+        // a has an object of its own, and r refers into the one now owned only by b
+        const cow_json& cb = b;
+        CHECK(&r != &ca.at("x"));
+        CHECK(&r == &cb.at("x"));
+        b["x"]["z"] = 3;
+        CHECK(r.at("z").as<int>() == 3);
+        CHECK(ca.at("x").at("z").as<int>() == 1);
+    }
+}
+
+TEST_CASE("copy on write deep nesting")
+{
+    const std::size_t depth = 1000000;
+
+    cow_json j = make_nested<cow_json>(depth);
+    cow_json copy(j);
+    CHECK(copy == j);
+
+    cow_json* current = &copy;
+    while (current->size() > 0)
+    {
+        current = current->is_array() ? &current->at(0) : &current->at("a");
+    }
+    *current = 1;
+    CHECK_FALSE(copy == j);
+
+    cow_json other(j);
+    CHECK(other == j);
+}
+
+TEST_CASE("copy on write threads")
+{
+    const cow_json prototype = cow_json::parse(document);
+
+    const int n = 8;
+    std::vector<int> results(n, 0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < n; ++i)
+    {
+        threads.emplace_back([&prototype, &results, i]()
+        {
+            for (int k = 0; k < 1000; ++k)
+            {
+                cow_json j(prototype);
+                j["id"] = i;
+                j["location"]["city"] = "Montreal";
+                j["tags"].push_back("fourth");
+                if (j.at("id").as<int>() == i && j.at("tags").size() == 4 &&
+                    prototype.at("location").at("city").as<std::string>() == "Toronto")
+                {
+                    ++results[i];
+                }
+            }
+        });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    for (int i = 0; i < n; ++i)
+    {
+        CHECK(results[i] == 1000);
+    }
+    CHECK(prototype.use_count() == 1);
+    CHECK(prototype.at("tags").size() == 3);
+}
@@ -0,0 +1,171 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <utility>
+
+using namespace jsoncons;
+
+namespace {
+
+    const std::size_t depth = 1000000;
+
+    // Alternates arrays and objects, with a scalar sibling at each level
+    template <class Json>
+    Json make_nested(std::size_t n)
+    {
+        Json j(json_array_arg);
+        j.push_back(0);
+        for (std::size_t i = 1; i < n; ++i)
+        {
+            if (i % 2 == 0)
+            {
+                Json outer(json_array_arg);
+                outer.push_back(i);
+                outer.push_back(std::move(j));
+                j = std::move(outer);
+            }
+            else
+            {
+                Json outer(json_object_arg);
+                outer.try_emplace("b", std::move(j));
+                outer.try_emplace("a", i);
+                j = std::move(outer);
+            }
+        }
+        return j;
+    }
+
+    template <class Json>
+    Json& innermost(Json& j)
+    {
+        Json* current = &j;
+        while (current->size() > 0)
+        {
+            Json& next = current->is_array() ? current->at(current->size()-1) : current->at("b");
+            if (next.size() == 0)
+            {
+                break;
+            }
+            current = &next;
+        }
+        return *current;
+    }
+
+    template <class Json>
+    void check_deep_nesting()
+    {
+        Json j = make_nested<Json>(depth);
+
+        Json copy(j);
+        CHECK(copy == j);
+        CHECK_FALSE(copy != j);
+
+        innermost(copy).at(0) = 1;
+        CHECK_FALSE(copy == j);
+        CHECK(copy != j);
+        innermost(copy).at(0) = 0;
+        CHECK(copy == j);
+
+        Json assigned;
+        assigned = j;
+        CHECK(assigned == j);
+
+        Json shallower = make_nested<Json>(depth - 2);
+        CHECK_FALSE(shallower == j);
+        CHECK_FALSE(j == shallower);
+    }
+}
+
+TEST_CASE("deep nesting tests")
+{
+    SECTION("json")
+    {
+        check_deep_nesting<json>();
+    }
+    SECTION("ojson")
+    {
+        check_deep_nesting<ojson>();
+    }
+    SECTION("hashed_policy")
+    {
+        check_deep_nesting<basic_json<char,hashed_policy,std::allocator<char>>>();
+    }
+    SECTION("hashed_preserve_order_policy")
+    {
+        check_deep_nesting<basic_json<char,hashed_preserve_order_policy,std::allocator<char>>>();
+    }
+    SECTION("parsed")
+    {
+        std::string s(depth, '[');
+        s.append(depth, ']');
+
+        json_options options;
+        options.max_nesting_depth(static_cast<int>(depth));
+        json j = json::parse(s, options);
+
+        json copy = j;
+        CHECK(copy == j);
+    }
+}
+
+TEST_CASE("copies of nested values")
+{
+    SECTION("keeps member order")
+    {
+        ojson j = ojson::parse(R"({"c":[1,{"z":1,"y":[2]}],"b":{"x":[],"w":{}},"a":"a string long enough to be heap allocated"})");
+        ojson copy(j);
+        CHECK(copy.to_string() == j.to_string());
+        CHECK(copy == j);
+
+        ojson reordered = ojson::parse(R"({"b":{"x":[],"w":{}},"c":[1,{"z":1,"y":[2]}],"a":"a string long enough to be heap allocated"})");
+        CHECK_FALSE(reordered == j);
+    }
+
+    SECTION("copies find their members")
+    {
+        ojson j = ojson::parse(R"({"c":[1,{"z":1,"y":[2]}],"b":{"x":[],"w":{}},"a":"a"})");
+        ojson copy(j);
+        CHECK(copy.at("b").at("w").empty());
+        CHECK(copy.at("c").at(1).at("y").at(0).as<int>() == 2);
+        copy.erase("c");
+        copy.insert_or_assign("d", 4);
+        copy["b"].insert_or_assign("v", 5);
+        CHECK(copy.to_string() == R"({"b":{"x":[],"w":{},"v":5},"a":"a","d":4})");
+        CHECK(j.contains("c"));
+
+        using hjson = basic_json<char,hashed_policy,std::allocator<char>>;
+        hjson h = hjson::parse(R"({"c":[1,{"z":1,"y":[2]}],"b":{"x":[],"w":{}},"a":"a"})");
+        hjson hcopy(h);
+        CHECK(hcopy.at("c").at(1).at("z").as<int>() == 1);
+        hcopy.erase("a");
+        hcopy["b"].insert_or_assign("v", 5);
+        CHECK(hcopy.at("b").at("x").empty());
+        CHECK(hcopy.to_string() == R"({"b":{"v":5,"w":{},"x":[]},"c":[1,{"y":[2],"z":1}]})");
+    }
+
+    SECTION("hashed objects compare in any order")
+    {
+        using hjson = basic_json<char,hashed_policy,std::allocator<char>>;
+        hjson j = hjson::parse(R"({"c":[1,{"z":1,"y":[2]}],"b":{"x":[],"w":{}}})");
+        hjson reordered = hjson::parse(R"({"b":{"w":{},"x":[]},"c":[1,{"y":[2],"z":1}]})");
+        CHECK(reordered == j);
+        hjson copy(j);
+        CHECK(copy == j);
+    }
+
+    SECTION("keeps tags")
+    {
+        json j(json_array_arg, semantic_tag::multi_dim_row_major);
+        j.push_back(json(json_array_arg));
+        j[0].push_back(json(json_object_arg, semantic_tag::none));
+        j[0][0].try_emplace("a", json(json_array_arg, semantic_tag::multi_dim_column_major));
+        j[0][0]["a"].push_back(1);
+        json copy(j);
+        CHECK(copy.tag() == semantic_tag::multi_dim_row_major);
+        CHECK(copy[0][0]["a"].tag() == semantic_tag::multi_dim_column_major);
+        CHECK(copy == j);
+    }
+}
@@ -0,0 +1,87 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/detail/write_number.hpp>
+#include <catch/catch.hpp>
+#include <random>
+#include <sstream>
+#include <string>
+
+using namespace jsoncons;
+
+namespace {
+
+    template <class Integer>
+    void check_write_integer(Integer value)
+    {
+        std::ostringstream os;
+        os << +value;
+
+        std::string s;
+        std::size_t count = jsoncons::detail::write_integer(value, s);
+        CHECK(s == os.str());
+        CHECK(count == s.size());
+    }
+
+}
+
+TEST_CASE("detail::write_integer tests")
+{
+    SECTION("boundaries")
+    {
+        check_write_integer(0);
+        check_write_integer(int8_t(-128));
+        check_write_integer(uint8_t(255));
+        check_write_integer((std::numeric_limits<int32_t>::min)());
+        check_write_integer((std::numeric_limits<int32_t>::max)());
+        check_write_integer((std::numeric_limits<int64_t>::min)());
+        check_write_integer((std::numeric_limits<int64_t>::max)());
+        check_write_integer((std::numeric_limits<uint64_t>::max)());
+    }
+
+    SECTION("powers of ten")
+    {
+        uint64_t p = 1;
+        for (int i = 0; i < 20; ++i)
+        {
+            check_write_integer(p - 1);
+            check_write_integer(p);
+            check_write_integer(p + 1);
+            if (i < 19)
+            {
+                check_write_integer(-static_cast<int64_t>(p - 1));
+                check_write_integer(-static_cast<int64_t>(p));
+            }
+            p *= 10;
+        }
+    }
+
+    SECTION("random")
+    {
+        std::mt19937_64 gen(2020);
+        for (int i = 0; i < 10000; ++i)
+        {
+            uint64_t u = gen() >> (gen() % 64);
+            check_write_integer(u);
+            check_write_integer(static_cast<int64_t>(u));
+        }
+    }
+
+    SECTION("wide characters")
+    {
+        std::wstring s;
+        jsoncons::detail::write_integer(-1234567, s);
+        CHECK(s == L"-1234567");
+    }
+
+    SECTION("string_sink")
+    {
+        std::string s;
+        jsoncons::string_sink<std::string> sink(s);
+        std::size_t count = jsoncons::detail::write_integer(int64_t(-42), sink);
+        sink.flush();
+        CHECK(s == "-42");
+        CHECK(count == 3);
+    }
+}
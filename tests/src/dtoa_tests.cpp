@@ -6,6 +6,9 @@
 #include <catch/catch.hpp>
 #include <iostream>
 #include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
 
 using namespace jsoncons;
 
@@ -98,3 +101,54 @@ TEST_CASE("test grisu3")
     check_dtoa(0.000071, {"7.1e-05"}); 
 }
 
+
+TEST_CASE("test ryu shortest round trip")
+{
+    std::mt19937_64 gen(2020);
+    jsoncons::detail::to_double_t to_double;
+
+    for (int i = 0; i < 100000; ++i)
+    {
+        uint64_t bits = gen();
+        double x;
+        std::memcpy(&x, &bits, sizeof(double));
+        if (!std::isfinite(x))
+        {
+            continue;
+        }
+
+        std::string s;
+        REQUIRE(jsoncons::detail::dtoa_general(x, '.', s));
+        CHECK(to_double(s.c_str(), s.size()) == x);
+
+        // No more digits than the shortest of %.15g, %.16g, %.17g that round trips
+        char buffer[100];
+        int precision = 15;
+        for (; precision < 17; ++precision)
+        {
+            int n = snprintf(buffer, sizeof(buffer), "%.*g", precision, x);
+            if (to_double(buffer, static_cast<std::size_t>(n)) == x)
+            {
+                break;
+            }
+        }
+        int length = 0;
+        int k;
+        jsoncons::detail::ryu_to_shortest(std::fabs(x), buffer, &length, &k);
+        CHECK(length <= precision);
+    }
+}
+
+TEST_CASE("test dtoa_scientific")
+{
+    std::vector<std::pair<double,std::string>> expected = {
+        {0, "0.0"}, {1, "1e+00"}, {1.5, "1.5e+00"}, {-1.5, "-1.5e+00"}, {1.0e100, "1e+100"}, 
+        {0.000071, "7.1e-05"}, {123456789.0, "1.23456789e+08"}, {5e-324, "5e-324"}
+    };
+    for (const auto& item : expected)
+    {
+        std::string s;
+        REQUIRE(jsoncons::detail::dtoa_scientific(item.first, '.', s));
+        CHECK(s == item.second);
+    }
+}
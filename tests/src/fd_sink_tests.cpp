@@ -0,0 +1,198 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if !defined(_WIN32)
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_encoder.hpp>
+#include <jsoncons/fd_sink.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace jsoncons;
+
+namespace {
+
+    std::string read_file(const std::string& path)
+    {
+        std::ifstream is(path, std::ios::binary);
+        std::ostringstream os;
+        os << is.rdbuf();
+        return os.str();
+    }
+
+    std::vector<fd_sink_options> all_options()
+    {
+        std::vector<fd_sink_options> v;
+        v.push_back(fd_sink_options());
+        v.push_back(fd_sink_options().buffer_length(1));
+        v.push_back(fd_sink_options().buffer_length(64).writev_threshold(16));
+        v.push_back(fd_sink_options().buffer_length(64).writev_threshold(0));
+        v.push_back(fd_sink_options().buffer_length(64).writev_threshold(16).background_flush(true));
+        v.push_back(fd_sink_options().buffer_length(1000).writev_threshold(0).background_flush(true));
+        v.push_back(fd_sink_options().background_flush(true));
+        return v;
+    }
+}
+
+TEST_CASE("fd_sink tests")
+{
+    std::string path = "./output/fd_sink_test.out";
+    json j = json::parse(read_file("./input/cyrillic.json"));
+    // Longer than the default writev threshold
+    j.insert_or_assign("long string", std::string(100000, 'x'));
+
+    SECTION("json")
+    {
+        std::string expected;
+        j.dump(expected);
+
+        for (const auto& options : all_options())
+        {
+            {
+                basic_compact_json_encoder<char,fd_sink<char>> encoder(fd_sink<char>(path, options));
+                j.dump(encoder);
+            }
+            CHECK(read_file(path) == expected);
+        }
+    }
+
+    SECTION("pretty json")
+    {
+        std::string expected;
+        j.dump(expected, indenting::indent);
+
+        for (const auto& options : all_options())
+        {
+            {
+                basic_json_encoder<char,fd_sink<char>> encoder(fd_sink<char>(path, options));
+                j.dump(encoder);
+            }
+            CHECK(read_file(path) == expected);
+        }
+    }
+
+    SECTION("cbor")
+    {
+        std::vector<uint8_t> expected;
+        cbor::encode_cbor(j, expected);
+
+        for (const auto& options : all_options())
+        {
+            {
+                cbor::basic_cbor_encoder<binary_fd_sink> encoder(binary_fd_sink(path, options));
+                j.dump(encoder);
+            }
+            CHECK(read_file(path) == std::string(expected.begin(), expected.end()));
+        }
+    }
+
+    SECTION("reference to sink, flush and reserve")
+    {
+        fd_sink<char> sink(path, fd_sink_options().buffer_length(4).background_flush(true));
+        {
+            basic_compact_json_encoder<char,fd_sink<char>&> encoder(sink);
+            json(json_array_arg, {1.5, -12345678, "abc"}).dump(encoder);
+        }
+        char* p = sink.reserve(10);
+        std::memcpy(p, "0123456789", 10);
+        sink.commit(10);
+        sink.push_back('!');
+        sink.flush();
+        CHECK_FALSE(sink.is_error());
+        CHECK(read_file(path) == "[1.5,-12345678,\"abc\"]0123456789!");
+    }
+
+    SECTION("move")
+    {
+        fd_sink<char> sink(path, fd_sink_options().buffer_length(16).background_flush(true));
+        sink.append("abc", 3);
+        fd_sink<char> other(std::move(sink));
+        other.append("def", 3);
+        other.flush();
+        CHECK(read_file(path) == "abcdef");
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("fd_sink pipe")
+{
+    int fds[2];
+    REQUIRE(::pipe(fds) == 0);
+
+    std::string text = read_file("./input/cyrillic.json");
+    REQUIRE_FALSE(text.empty());
+    std::string expected;
+    for (int i = 0; i < 300; ++i)
+    {
+        expected.append(text);
+    }
+    std::string actual;
+    {
+        fd_sink<char> sink(fds[1], fd_sink_options().buffer_length(100).writev_threshold(1000).background_flush(true));
+        std::thread reader([&]()
+        {
+            char buf[4096];
+            ssize_t n;
+            while ((n = ::read(fds[0], buf, sizeof(buf))) > 0)
+            {
+                actual.append(buf, static_cast<std::size_t>(n));
+            }
+        });
+        // Writes larger than the pipe capacity are written in parts
+        for (std::size_t i = 0; i < expected.size(); i += 50000)
+        {
+            sink.append(expected.data() + i, (std::min)(std::size_t(50000), expected.size() - i));
+        }
+        sink.flush();
+        ::close(fds[1]);
+        reader.join();
+        CHECK_FALSE(sink.is_error());
+    }
+    ::close(fds[0]);
+    CHECK(actual == expected);
+}
+
+TEST_CASE("fd_sink errors")
+{
+    SECTION("cannot open")
+    {
+        fd_sink<char> sink("./output/no_such_directory/fd_sink_test.out");
+        CHECK(sink.is_error());
+        CHECK(sink.error_number() == ENOENT);
+        sink.append("abc", 3);
+        sink.flush();
+        CHECK(sink.error_number() == ENOENT);
+    }
+
+    SECTION("closed pipe")
+    {
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+        ::close(fds[0]);
+        std::signal(SIGPIPE, SIG_IGN);
+        for (bool background : {false, true})
+        {
+            fd_sink<char> sink(fds[1], fd_sink_options().buffer_length(8).background_flush(background));
+            sink.append("0123456789", 10);
+            sink.push_back('a');
+            sink.flush();
+            CHECK(sink.is_error());
+            CHECK(sink.error_number() == EPIPE);
+        }
+        ::close(fds[1]);
+    }
+}
+
+#endif
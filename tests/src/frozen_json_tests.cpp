@@ -0,0 +1,360 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/frozen_json.hpp>
+#include <jsoncons_ext/jsonpointer/jsonpointer.hpp>
+#include <jsoncons_ext/jsonpath/jsonpath.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    const std::string input = R"(
+    {
+        "store": {
+            "book": [
+                {"category": "reference", "author": "Nigel Rees", "title": "Sayings of the Century", "price": 8.95},
+                {"category": "fiction", "author": "Evelyn Waugh", "title": "Sword of Honour", "price": 12.99},
+                {"category": "fiction", "author": "Herman Melville", "title": "Moby Dick", "isbn": "0-553-21311-3", "price": 8.99}
+            ],
+            "bicycle": {"color": "red", "price": 19.95, "in stock": true, "gears": 21, "serial": 18446744073709551615}
+        },
+        "expensive": 10,
+        "empty array": [],
+        "empty object": {},
+        "nothing": null,
+        "short": "abc",
+        "eight ch": "12345678"
+    }
+    )";
+}
+
+TEST_CASE("frozen_json accessors")
+{
+    const frozen_json doc = frozen_json::parse(input);
+    const json expected = json::parse(input);
+
+    SECTION("types and sizes")
+    {
+        CHECK(doc.is_object());
+        CHECK(doc.size() == expected.size());
+        CHECK(doc["store"]["book"].is_array());
+        CHECK(doc["store"]["book"].size() == 3);
+        CHECK(doc["store"]["bicycle"]["in stock"].is_bool());
+        CHECK(doc["store"]["bicycle"]["gears"].is<int>());
+        CHECK(frozen_json::parse("-21").is_int64());
+        CHECK(doc["store"]["bicycle"]["serial"].is_uint64());
+        CHECK(doc["store"]["bicycle"]["price"].is_double());
+        CHECK(doc["nothing"].is_null());
+        CHECK(doc["empty array"].empty());
+        CHECK(doc["empty object"].empty());
+        CHECK(doc["empty object"].is_object());
+        CHECK(doc.type() == json_type::object_value);
+    }
+
+    SECTION("as")
+    {
+        CHECK(doc["store"]["book"][1]["author"].as<std::string>() == "Evelyn Waugh");
+        CHECK(doc["store"]["book"][1]["author"].as<string_view>() == string_view("Evelyn Waugh"));
+        CHECK(doc["store"]["bicycle"]["gears"].as<int>() == 21);
+        CHECK(doc["store"]["bicycle"]["serial"].as<uint64_t>() == 18446744073709551615ull);
+        CHECK(doc["store"]["bicycle"]["price"].as<double>() == 19.95);
+        CHECK(doc["store"]["bicycle"]["in stock"].as<bool>());
+        CHECK(doc["short"].as<std::string>() == "abc");
+        CHECK(doc["eight ch"].as<std::string>() == "12345678");
+        CHECK(doc["eight ch"].as<int>() == 12345678);
+        CHECK(doc["eight ch"].as<double>() == 12345678.0);
+        CHECK(doc["expensive"].is<int>());
+        CHECK_FALSE(doc["expensive"].is<std::string>());
+
+        auto titles = doc["store"]["book"][2].as<std::map<std::string,std::string>>();
+        CHECK(titles["title"] == "Moby Dick");
+        auto v = frozen_json::parse("[1,2,3]").as<std::vector<int>>();
+        CHECK(v == std::vector<int>({1,2,3}));
+    }
+
+    SECTION("find and contains")
+    {
+        const frozen_json& bicycle = doc.at("store").at("bicycle");
+        auto it = bicycle.find("color");
+        REQUIRE(it != bicycle.object_range().end());
+        CHECK(it->key() == string_view("color"));
+        CHECK(it->value().as<std::string>() == "red");
+        CHECK(bicycle.find("colour") == bicycle.object_range().end());
+        CHECK(bicycle.contains("in stock"));
+        CHECK_FALSE(bicycle.contains("brakes"));
+        CHECK_FALSE(doc["expensive"].contains("color"));
+        CHECK(bicycle.get_value_or<int>("gears", 1) == 21);
+        CHECK(bicycle.get_value_or<int>("wheels", 2) == 2);
+
+        CHECK_THROWS_AS(doc.at("missing"), key_not_found);
+        CHECK_THROWS_AS(doc["expensive"].at("x"), not_an_object);
+        CHECK_THROWS(doc["store"]["book"].at(3));
+    }
+
+    SECTION("ranges visit members in key order")
+    {
+        std::vector<std::string> keys;
+        for (const auto& member : doc["store"]["bicycle"].object_range())
+        {
+            keys.emplace_back(member.key().data(), member.key().size());
+        }
+        CHECK(keys == std::vector<std::string>({"color", "gears", "in stock", "price", "serial"}));
+
+        double total = 0;
+        for (const auto& book : doc["store"]["book"].array_range())
+        {
+            total += book["price"].as<double>();
+        }
+        CHECK(total == Approx(30.93));
+    }
+
+    SECTION("dump and conversion")
+    {
+        CHECK(doc.to_string() == expected.to_string());
+        std::ostringstream os;
+        os << doc["store"]["bicycle"];
+        CHECK(os.str() == expected["store"]["bicycle"].to_string());
+
+        json j = doc.as<json>();
+        CHECK(j == expected);
+        ojson oj = doc["store"].as<ojson>();
+        CHECK(oj.size() == 2);
+
+        frozen_json from_json(expected);
+        CHECK(from_json == doc);
+        CHECK(from_json.to_string() == expected.to_string());
+    }
+}
+
+TEST_CASE("frozen_json values")
+{
+    SECTION("scalars at the root")
+    {
+        CHECK(frozen_json::parse("null").is_null());
+        CHECK(frozen_json::parse("true").as<bool>());
+        CHECK(frozen_json::parse("-17").as<int>() == -17);
+        CHECK(frozen_json::parse("2.5").as<double>() == 2.5);
+        CHECK(frozen_json::parse(R"("a long string at the root")").as<std::string>() == "a long string at the root");
+        CHECK(frozen_json::parse(R"("")").empty());
+        CHECK(frozen_json().is_null());
+    }
+
+    SECTION("duplicate keys keep the first")
+    {
+        frozen_json doc = frozen_json::parse(R"({"b":1,"a":2,"b":3,"c":{"x":1,"x":2}})");
+        CHECK(doc.size() == 3);
+        CHECK(doc["b"].as<int>() == 1);
+        CHECK(doc["c"].size() == 1);
+        CHECK(doc["c"]["x"].as<int>() == 1);
+        CHECK(doc.to_string() == json::parse(R"({"b":1,"a":2,"b":3,"c":{"x":1,"x":2}})").to_string());
+    }
+
+    SECTION("copy and move")
+    {
+        frozen_json doc = frozen_json::parse(input);
+        frozen_json copy(doc);
+        CHECK(copy == doc);
+
+        // Copying an element copies it into a block of its own
+        frozen_json book = doc["store"]["book"][2];
+        CHECK(book["isbn"].as<std::string>() == "0-553-21311-3");
+        frozen_json number = doc["expensive"];
+        CHECK(number.as<int>() == 10);
+
+        frozen_json moved(std::move(copy));
+        CHECK(moved == doc);
+        CHECK(copy.is_null());
+
+        std::vector<frozen_json> docs;
+        for (int i = 0; i < 10; ++i)
+        {
+            docs.push_back(frozen_json::parse("[" + std::to_string(i) + ",\"a string that is not short\"]"));
+        }
+        docs.erase(docs.begin());
+        CHECK(docs[0][0].as<int>() == 1);
+        CHECK(docs[8][1].as<std::string>() == "a string that is not short");
+
+        book = doc;
+        CHECK(book == doc);
+    }
+
+    SECTION("equality")
+    {
+        CHECK(frozen_json::parse(R"({"a":[1,2],"b":"x"})") == frozen_json::parse(R"({"b":"x","a":[1,2]})"));
+        CHECK(frozen_json::parse(R"({"a":[1,2]})") != frozen_json::parse(R"({"a":[1,3]})"));
+        CHECK(frozen_json::parse("1") == frozen_json::parse("1.0"));
+    }
+
+    SECTION("byte strings and tags from cbor")
+    {
+        json expected(json_object_arg);
+        expected["bytes"] = json(byte_string_arg, std::vector<uint8_t>{1,2,3,4,5,6,7,8,9,10}, semantic_tag::base64);
+        expected["ext"] = json(byte_string_arg, std::vector<uint8_t>{1,2}, 42);
+        expected["time"] = json(1431027667, semantic_tag::timestamp);
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(expected, data);
+
+        frozen_json_decoder decoder;
+        cbor::cbor_bytes_reader reader(data, decoder);
+        reader.read();
+        REQUIRE(decoder.is_valid());
+        frozen_json doc = decoder.get_result();
+
+        CHECK(doc["bytes"].as_byte_string_view() == expected["bytes"].as_byte_string_view());
+        CHECK(doc["bytes"].tag() == semantic_tag::base64);
+        CHECK(doc["bytes"].as<std::string>() == expected["bytes"].as<std::string>());
+        CHECK(doc["ext"].ext_tag() == 42);
+        CHECK(doc["time"].tag() == semantic_tag::timestamp);
+        CHECK(doc.as<json>() == expected);
+    }
+
+    SECTION("wide characters")
+    {
+        wfrozen_json doc = wfrozen_json::parse(LR"({"b":"a wide string","a":"ab"})");
+        CHECK(doc[L"a"].as<std::wstring>() == L"ab");
+        CHECK(doc[L"b"].as<std::wstring>() == L"a wide string");
+        CHECK(doc.object_range().begin()->key() == wstring_view(L"a"));
+    }
+
+    SECTION("JSON_checker pass1")
+    {
+        std::ifstream is("./input/JSON_checker/pass1.json");
+        REQUIRE(is);
+        std::stringstream buffer;
+        buffer << is.rdbuf();
+        frozen_json doc = frozen_json::parse(buffer.str());
+        CHECK(doc.to_string() == json::parse(buffer.str()).to_string());
+    }
+}
+
+TEST_CASE("frozen_json with jsonpointer and jsonpath")
+{
+    const frozen_json doc = frozen_json::parse(input);
+
+    CHECK(jsonpointer::get(doc, "/store/book/1/author").as<std::string>() == "Evelyn Waugh");
+    CHECK(jsonpointer::get(doc, "/store/bicycle/in stock").as<bool>());
+    CHECK(jsonpointer::contains(doc, "/store/book/2/isbn"));
+    CHECK_FALSE(jsonpointer::contains(doc, "/store/book/3"));
+
+    std::error_code ec;
+    jsonpointer::get(doc, "/store/unicycle", ec);
+    CHECK(ec == jsonpointer::jsonpointer_errc::name_not_found);
+
+    json result = jsonpath::json_query(doc.as<json>(), "$.store.book[?(@.price < 10)].title");
+    CHECK(result == json::parse(R"(["Sayings of the Century","Moby Dick"])"));
+}
+
+TEST_CASE("frozen_json deeply nested")
+{
+    // Arrays and objects alternate, {"a":[{"a":[...]}]}
+    const std::size_t depth = 1000000;
+    auto make_nested = [depth](char innermost) -> std::string
+    {
+        std::string s;
+        for (std::size_t i = 0; i < depth; ++i)
+        {
+            s.append(i % 2 == 0 ? "{\"a\":" : "[");
+        }
+        s.push_back(innermost);
+        for (std::size_t i = depth; i-- > 0; )
+        {
+            s.push_back(i % 2 == 0 ? '}' : ']');
+        }
+        return s;
+    };
+    std::string s = make_nested('1');
+
+    json_options options;
+    options.max_nesting_depth(static_cast<int>(depth));
+
+    json j = json::parse(s, options);
+    frozen_json f(j);
+    std::string dumped;
+    f.dump(dumped, options);
+    CHECK(dumped == s);
+
+    frozen_json parsed = frozen_json::parse(s, options);
+    CHECK(parsed == f);
+    CHECK_FALSE(frozen_json::parse(make_nested('2'), options) == f);
+
+    frozen_json copy(f);
+    CHECK(copy == f);
+    CHECK(copy.as<json>() == j);
+
+    frozen_json_decoder decoder(true);
+    json_reader reader(s, decoder, options);
+    reader.read();
+    CHECK(decoder.get_result() == f);
+}
+
+TEST_CASE("frozen_json sharing identical values")
+{
+    std::string repetitive = "[";
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+        if (i > 0)
+        {
+            repetitive.push_back(',');
+        }
+        repetitive.append(R"({"kind":"a repeated string value","location":{"city":"Toronto","coordinates":[43.6532,-79.3832]},"tags":["first","second"],"id":)");
+        repetitive.append(std::to_string(i % 10));
+        repetitive.append("}");
+    }
+    repetitive.append("]");
+
+    SECTION("repetitive document")
+    {
+        frozen_json plain = frozen_json::parse(repetitive);
+
+        frozen_json_decoder decoder(true);
+        json_reader reader(repetitive, decoder);
+        reader.read();
+        frozen_json shared = decoder.get_result();
+
+        CHECK(shared == plain);
+        CHECK(shared.to_string() == json::parse(repetitive).to_string());
+        CHECK(shared.bytes_allocated() * 10 < plain.bytes_allocated());
+        CHECK(shared[999]["id"].as<int>() == 9);
+        CHECK(&shared[3]["location"]["coordinates"][0] == &shared[998]["location"]["coordinates"][0]);
+        CHECK(&shared[3]["id"] == &shared[993]["id"]);
+        CHECK(&shared[3]["id"] != &shared[4]["id"]);
+    }
+
+    SECTION("values that compare equal but differ are not shared")
+    {
+        std::string s = R"([[1,"a long string value"],[1.0,"a long string value"],{"a":[1]},{"a":[1],"b":[]},[[1]],[[1]],"a long string value"])";
+        frozen_json_decoder decoder(true);
+        json_reader reader(s, decoder);
+        reader.read();
+        frozen_json shared = decoder.get_result();
+
+        CHECK(shared.to_string() == json::parse(s).to_string());
+        CHECK(&shared[0][0] != &shared[1][0]);
+        CHECK(shared[0][1].as_string_view().data() == shared[1][1].as_string_view().data());
+        CHECK(shared[6].as_string_view().data() == shared[0][1].as_string_view().data());
+        CHECK(&shared[2]["a"][0] == &shared[3]["a"][0]);
+        CHECK(&shared[4][0] == &shared[5][0]);
+        CHECK(shared[0][0].is_uint64());
+        CHECK(shared[1][0].is_double());
+    }
+
+    SECTION("copies")
+    {
+        frozen_json_decoder decoder(true);
+        json_reader reader(repetitive, decoder);
+        reader.read();
+        frozen_json shared = decoder.get_result();
+        frozen_json copy(shared[5]);
+        CHECK(copy == shared[5]);
+        CHECK(copy.as<json>() == json::parse(repetitive)[5]);
+    }
+}
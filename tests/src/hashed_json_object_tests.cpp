@@ -0,0 +1,361 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/detail/hash_index.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <random>
+
+using namespace jsoncons;
+
+using hjson = basic_json<char,hashed_policy,std::allocator<char>>;
+using hojson = basic_json<char,hashed_preserve_order_policy,std::allocator<char>>;
+
+TEST_CASE("hashed_policy object tests")
+{
+    SECTION("insert_or_assign and find")
+    {
+        hjson j;
+        const std::size_t n = 20000;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            j.insert_or_assign("key" + std::to_string(i), i);
+        }
+        REQUIRE(j.size() == n);
+        j.insert_or_assign("key5", "five");
+        CHECK(j.size() == n);
+        CHECK(j["key5"].as<std::string>() == "five");
+
+        for (std::size_t i = 0; i < n; i += 997)
+        {
+            auto it = j.find("key" + std::to_string(i));
+            REQUIRE(bool(it != j.object_range().end()));
+            CHECK(it->key() == "key" + std::to_string(i));
+        }
+        CHECK(bool(j.find("missing") == j.object_range().end()));
+        CHECK_FALSE(j.contains("key20000"));
+    }
+
+    SECTION("iteration is sorted by key")
+    {
+        hjson j;
+        j.insert_or_assign("c", 1);
+        j.try_emplace("a", 2);
+        j.insert_or_assign("b", 3);
+        j.try_emplace("a", 4);
+
+        std::vector<std::string> keys;
+        for (const auto& member : j.object_range())
+        {
+            keys.push_back(member.key());
+        }
+        std::vector<std::string> expected = {"a","b","c"};
+        CHECK(keys == expected);
+        CHECK(j["a"].as<int>() == 2);
+
+        j.insert_or_assign("ab", 5);
+        j.erase("a");
+        j.try_emplace("0", 6);
+        CHECK(j.find("ab")->value().as<int>() == 5);
+        CHECK(j.to_string() == R"({"0":6,"ab":5,"b":3,"c":1})");
+        CHECK(j.at(1).as<int>() == 5);
+
+        auto result = j.insert_or_assign("bb", 7);
+        CHECK(result.second);
+        CHECK(result.first->key() == "bb");
+        CHECK(bool(result.first == j.object_range().begin() + 3));
+        CHECK(j.find("c")->value().as<int>() == 1);
+    }
+
+    SECTION("parse keeps the first of duplicate keys")
+    {
+        hjson j = hjson::parse(R"({"b":1,"a":{"y":true,"x":null},"b":2,"c":[1,{"d":3}]})");
+        REQUIRE(j.size() == 3);
+        CHECK(j["b"].as<int>() == 1);
+        CHECK(j["c"][1]["d"].as<int>() == 3);
+        CHECK(j.to_string() == R"({"a":{"x":null,"y":true},"b":1,"c":[1,{"d":3}]})");
+    }
+
+    SECTION("erase")
+    {
+        hjson j;
+        for (int i = 0; i < 100; ++i)
+        {
+            j.insert_or_assign(std::to_string(i), i);
+        }
+        j.erase("50");
+        CHECK(j.size() == 99);
+        CHECK_FALSE(j.contains("50"));
+
+        auto first = j.find("10");
+        auto last = j.find("20");
+        j.erase(first, last);
+        // The range is in key order, so "2" is in it as well
+        CHECK(j.size() == 88);
+        for (int i = 0; i < 100; ++i)
+        {
+            std::string key = std::to_string(i);
+            bool erased = i == 50 || (key >= "10" && key < "20");
+            CHECK(j.contains(key) == !erased);
+            if (!erased)
+            {
+                CHECK(j[key].as<int>() == i);
+            }
+        }
+        j.insert_or_assign("15", 15);
+        CHECK(j.object_range().rbegin()->key() == "99");
+        CHECK(j.object_range().begin()[2].key() == "15");
+    }
+
+    SECTION("erase one member at a time")
+    {
+        hjson j = hjson::parse(R"({"a":1,"b":2,"c":3,"d":4,"e":5})");
+        j.erase("b");
+        j.erase("e");
+        j.erase("a");
+        CHECK(j.at("c").as<int>() == 3);
+        CHECK(j.at("d").as<int>() == 4);
+        CHECK(j.to_string() == R"({"c":3,"d":4})");
+        j.erase("c");
+        j.erase("d");
+        CHECK(j.empty());
+    }
+
+    SECTION("equality ignores member order")
+    {
+        hjson a = hjson::parse(R"({"x":1,"y":[1,2],"z":{"p":null}})");
+        hjson b = hjson::parse(R"({"z":{"p":null},"x":1,"y":[1,2]})");
+        hjson c = hjson::parse(R"({"z":{"p":null},"x":2,"y":[1,2]})");
+        CHECK(a == b);
+        CHECK_FALSE(a == c);
+        CHECK(a < c);
+        CHECK_FALSE(c < a);
+    }
+
+    SECTION("merge and merge_or_update")
+    {
+        hjson a = hjson::parse(R"({"a":1,"b":2})");
+        hjson b = hjson::parse(R"({"b":3,"c":4})");
+
+        hjson merged = a;
+        merged.merge(b);
+        CHECK(merged == hjson::parse(R"({"a":1,"b":2,"c":4})"));
+
+        hjson updated = a;
+        updated.merge_or_update(std::move(b));
+        CHECK(updated == hjson::parse(R"({"a":1,"b":3,"c":4})"));
+    }
+
+    SECTION("copy and swap")
+    {
+        hjson a = hjson::parse(R"({"a":1,"b":2})");
+        hjson b = hjson::parse(R"({"c":3})");
+        hjson copy = a;
+        copy.swap(b);
+        CHECK(copy["c"].as<int>() == 3);
+        CHECK(b["b"].as<int>() == 2);
+        CHECK(b.contains("a"));
+    }
+
+    SECTION("wide characters")
+    {
+        using whjson = basic_json<wchar_t,hashed_policy,std::allocator<wchar_t>>;
+        whjson j = whjson::parse(LR"({"one":1,"two":2})");
+        CHECK(j[L"two"].as<int>() == 2);
+    }
+}
+
+TEST_CASE("hashed_preserve_order_policy object tests")
+{
+    hojson j;
+    j.insert_or_assign("b", 1);
+    j.insert_or_assign("a", 2);
+    j.insert_or_assign("c", 3);
+
+    SECTION("insert_or_assign at pos")
+    {
+        auto it = j.insert_or_assign(j.find("a"), "d", 4);
+        CHECK(it->key() == "d");
+        CHECK(j.to_string() == R"({"b":1,"d":4,"a":2,"c":3})");
+        CHECK(j.at("a") == 2);
+        CHECK(j.at("c") == 3);
+
+        it = j.insert_or_assign(j.object_range().begin(), "c", 5);
+        CHECK(it->key() == "c");
+        CHECK(j.to_string() == R"({"b":1,"d":4,"a":2,"c":5})");
+    }
+
+    SECTION("try_emplace at pos")
+    {
+        auto it = j.try_emplace(j.object_range().begin(), "d", 4);
+        j.try_emplace(it, "d", 5);
+        CHECK(j.to_string() == R"({"d":4,"b":1,"a":2,"c":3})");
+        CHECK(j.at("b") == 1);
+    }
+
+    SECTION("merge at pos")
+    {
+        hojson source = hojson::parse(R"({"x":7,"a":8,"y":9})");
+        j.merge(j.object_range().begin() + 1, source);
+        CHECK(j.to_string() == R"({"b":1,"x":7,"a":2,"y":9,"c":3})");
+        j.merge_or_update(j.object_range().begin(), source);
+        CHECK(j.to_string() == R"({"b":1,"x":7,"a":8,"y":9,"c":3})");
+    }
+
+    SECTION("equality follows member order")
+    {
+        CHECK(j == hojson::parse(R"({"b":1,"a":2,"c":3})"));
+        CHECK_FALSE(j == hojson::parse(R"({"a":2,"b":1,"c":3})"));
+        CHECK(hojson::parse(R"({"a":2,"b":1,"c":3})") < j);
+    }
+}
+
+TEST_CASE("hashed_preserve_order_policy same as ojson")
+{
+    std::mt19937 gen(2020);
+    std::uniform_int_distribution<int> key_dist(0, 40);
+    std::uniform_int_distribution<int> op_dist(0, 5);
+
+    ojson expected(json_object_arg);
+    hojson j(json_object_arg);
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        std::string key = "key" + std::to_string(key_dist(gen));
+        std::size_t pos = expected.size() == 0 ? 0 : static_cast<std::size_t>(key_dist(gen)) % expected.size();
+        switch (op_dist(gen))
+        {
+            case 0:
+                expected.insert_or_assign(key, i);
+                j.insert_or_assign(key, i);
+                break;
+            case 1:
+                expected.try_emplace(key, i);
+                j.try_emplace(key, i);
+                break;
+            case 2:
+                expected.insert_or_assign(expected.object_range().begin() + pos, key, i);
+                j.insert_or_assign(j.object_range().begin() + pos, key, i);
+                break;
+            case 3:
+                expected.try_emplace(expected.object_range().begin() + pos, key, i);
+                j.try_emplace(j.object_range().begin() + pos, key, i);
+                break;
+            case 4:
+                expected.erase(key);
+                j.erase(key);
+                break;
+            default:
+                if (pos + 3 <= expected.size())
+                {
+                    expected.erase(expected.object_range().begin() + pos, expected.object_range().begin() + pos + 3);
+                    j.erase(j.object_range().begin() + pos, j.object_range().begin() + pos + 3);
+                }
+                break;
+        }
+        REQUIRE(j.to_string() == expected.to_string());
+    }
+    for (const auto& member : expected.object_range())
+    {
+        CHECK(j.at(member.key()) == member.value().as<int>());
+    }
+}
+
+TEST_CASE("hashed_policy same as json")
+{
+    std::mt19937 gen(2020);
+    std::uniform_int_distribution<int> key_dist(0, 40);
+    std::uniform_int_distribution<int> op_dist(0, 5);
+
+    json expected(json_object_arg);
+    hjson j(json_object_arg);
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        std::string key = "key" + std::to_string(key_dist(gen));
+        std::size_t pos = expected.size() == 0 ? 0 : static_cast<std::size_t>(key_dist(gen)) % expected.size();
+        switch (op_dist(gen))
+        {
+            case 0:
+                expected.insert_or_assign(key, i);
+                j.insert_or_assign(key, i);
+                break;
+            case 1:
+                expected.try_emplace(key, i);
+                j.try_emplace(key, i);
+                break;
+            case 2:
+            case 3:
+                expected.erase(key);
+                j.erase(key);
+                break;
+            case 4:
+                REQUIRE(j.contains(key) == expected.contains(key));
+                if (expected.contains(key))
+                {
+                    CHECK(j.at(key).as<int>() == expected.at(key).as<int>());
+                }
+                break;
+            default:
+                if (pos + 3 <= expected.size())
+                {
+                    expected.erase(expected.object_range().begin() + pos, expected.object_range().begin() + pos + 3);
+                    j.erase(j.object_range().begin() + pos, j.object_range().begin() + pos + 3);
+                }
+                break;
+        }
+        REQUIRE(j.size() == expected.size());
+        if (i % 7 == 0)
+        {
+            REQUIRE(j.to_string() == expected.to_string());
+        }
+    }
+    CHECK(j.to_string() == expected.to_string());
+}
+
+TEST_CASE("detail::hash_index tests")
+{
+    jsoncons::detail::hash_index<std::allocator<char>> index;
+    std::vector<std::string> keys;
+    for (int i = 0; i < 1000; ++i)
+    {
+        keys.push_back("k" + std::to_string(i));
+        index.insert_unique(jsoncons::detail::hash_key(keys.back().data(), keys.back().size()), keys.size() - 1);
+    }
+    auto find = [&](const std::string& key) -> std::size_t
+    {
+        return index.find(jsoncons::detail::hash_key(key.data(), key.size()),
+                          [&](std::size_t pos) {return keys[pos] == key;});
+    };
+    CHECK(index.size() == 1000);
+    CHECK(find("k500") == 500);
+
+    index.erase(100, 200);
+    keys.erase(keys.begin() + 100, keys.begin() + 200);
+    CHECK(index.size() == 900);
+    CHECK(find("k150") == (jsoncons::detail::hash_index<std::allocator<char>>::npos));
+    CHECK(find("k500") == 400);
+    CHECK(find("k99") == 99);
+
+    index.move_back_to(0);
+    std::rotate(keys.begin(), keys.end() - 1, keys.end());
+    CHECK(find("k999") == 0);
+    CHECK(find("k0") == 1);
+    CHECK(find("k500") == 401);
+
+    SECTION("erase_entry")
+    {
+        std::size_t pos = find("k500");
+        index.erase_entry(jsoncons::detail::hash_key(keys[pos].data(), keys[pos].size()), pos);
+        keys.erase(keys.begin() + pos);
+        CHECK(index.size() == keys.size());
+        for (std::size_t i = 0; i < keys.size(); ++i)
+        {
+            REQUIRE(find(keys[i]) == i);
+        }
+    }
+}
@@ -0,0 +1,135 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_arena.hpp>
+#include <jsoncons/monotonic_allocator.hpp>
+#include <catch/catch.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    using arena_json = basic_json<char,sorted_policy,monotonic_allocator<char>>;
+
+    std::string read_file(const std::string& path)
+    {
+        std::ifstream is(path);
+        std::ostringstream os;
+        os << is.rdbuf();
+        return os.str();
+    }
+}
+
+TEST_CASE("monotonic_buffer_resource tests")
+{
+    SECTION("alignment and growth")
+    {
+        monotonic_buffer_resource resource(64);
+        CHECK(resource.bytes_allocated() == 0);
+
+        void* p1 = resource.allocate(1, 1);
+        void* p2 = resource.allocate(8, 8);
+        void* p3 = resource.allocate(16, 16);
+        CHECK(p1 != nullptr);
+        CHECK(reinterpret_cast<uintptr_t>(p2) % 8 == 0);
+        CHECK(reinterpret_cast<uintptr_t>(p3) % 16 == 0);
+
+        void* large = resource.allocate(1000, 8);
+        CHECK(large != nullptr);
+        CHECK(resource.bytes_allocated() >= 1000);
+
+        resource.release();
+        CHECK(resource.bytes_allocated() == 0);
+        CHECK(resource.allocate(8, 8) != nullptr);
+    }
+
+    SECTION("allocators compare equal when they share a resource")
+    {
+        monotonic_buffer_resource resource1;
+        monotonic_buffer_resource resource2;
+        monotonic_allocator<char> a1(resource1);
+        monotonic_allocator<int> a2(a1);
+        monotonic_allocator<char> b(resource2);
+        CHECK(a1 == a2);
+        CHECK(a1 != b);
+        CHECK(a2.resource() == &resource1);
+    }
+}
+
+TEST_CASE("decode_json with result allocator")
+{
+    std::string input = R"({"a":[1,2,"a string long enough to be heap allocated"],"b":{"c":true,"d":null},"e":-3.5})";
+
+    monotonic_buffer_resource resource;
+    monotonic_allocator<char> alloc(resource);
+
+    SECTION("from string")
+    {
+        arena_json j = decode_json<arena_json>(result_allocator_arg, alloc, input);
+        CHECK(resource.bytes_allocated() > 0);
+        CHECK(j.to_string() == json::parse(input).to_string());
+        CHECK(j["a"][2].as<std::string>() == "a string long enough to be heap allocated");
+        CHECK(j.at("b").at("c").as<bool>());
+    }
+
+    SECTION("from stream")
+    {
+        std::istringstream is(input);
+        arena_json j = decode_json<arena_json>(result_allocator_arg, alloc, is);
+        CHECK(j.to_string() == json::parse(input).to_string());
+    }
+}
+
+TEST_CASE("json_arena tests")
+{
+    SECTION("parse several documents")
+    {
+        std::vector<std::string> inputs;
+        for (const char* path : {"./input/address-book.json", "./input/countries.json", "./input/cyrillic.json",
+                                 "./input/employees.json", "./input/members.json", "./input/persons.json"})
+        {
+            inputs.push_back(read_file(path));
+            REQUIRE_FALSE(inputs.back().empty());
+        }
+
+        json_arena arena;
+        std::vector<json_arena::json_type*> docs;
+        for (const auto& input : inputs)
+        {
+            docs.push_back(&arena.parse(input));
+        }
+        for (std::size_t i = 0; i < docs.size(); ++i)
+        {
+            CHECK(docs[i]->to_string() == json::parse(inputs[i]).to_string());
+        }
+        CHECK(arena.bytes_allocated() > 0);
+
+        arena.release();
+        CHECK(arena.bytes_allocated() == 0);
+
+        auto& j = arena.parse(std::string(R"([1,2,3])"));
+        CHECK(j.size() == 3);
+    }
+
+    SECTION("modify a document in the arena")
+    {
+        ojson_arena arena;
+        std::istringstream is(R"({"b":1,"a":2})");
+        auto& j = arena.parse(is);
+        j.insert_or_assign("c", "a string long enough to be heap allocated");
+        j["d"] = ojson_arena::json_type(json_array_arg, semantic_tag::none, arena.get_allocator());
+        j["d"].push_back(4);
+        CHECK(j.to_string() == R"({"b":1,"a":2,"c":"a string long enough to be heap allocated","d":[4]})");
+    }
+
+    SECTION("parse error")
+    {
+        json_arena arena;
+        REQUIRE_THROWS_AS(arena.parse(std::string(R"({"a":[1,2)")), ser_error);
+    }
+}
@@ -0,0 +1,118 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    // Records events, and skips the contents of objects
+    class skipping_visitor : public default_json_visitor
+    {
+    public:
+        std::vector<std::string> events;
+    private:
+        bool visit_begin_object(semantic_tag, const ser_context&, std::error_code&) override
+        {
+            events.push_back("{");
+            return false;
+        }
+        bool visit_begin_array(semantic_tag, const ser_context&, std::error_code&) override
+        {
+            events.push_back("[");
+            return true;
+        }
+        bool visit_end_array(const ser_context&, std::error_code&) override
+        {
+            events.push_back("]");
+            return true;
+        }
+        bool visit_uint64(uint64_t value, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            events.push_back(std::to_string(value));
+            return true;
+        }
+        bool visit_end_object(const ser_context&, std::error_code&) override
+        {
+            events.push_back("}");
+            return true;
+        }
+    };
+}
+
+TEST_CASE("basic_json dump tests")
+{
+    SECTION("compact and indented")
+    {
+        std::string input = R"({"a":[1,-2,3.5,"four",[],{},[[true,null]]],"b":{"c":{"d":[{"e":"f"}]}},"g":{}})";
+        json j = json::parse(input);
+
+        std::string s;
+        j.dump(s);
+        CHECK(s == input);
+
+        std::ostringstream os;
+        j.dump(os);
+        CHECK(os.str() == input);
+
+        std::string pretty;
+        j.dump(pretty, indenting::indent);
+        CHECK(json::parse(pretty) == j);
+
+        std::ostringstream os2;
+        os2 << pretty_print(j);
+        CHECK(os2.str() == pretty);
+    }
+
+    SECTION("member order")
+    {
+        std::string input = R"({"z":{"y":[1,{"x":2,"w":3}],"v":{}},"u":[{}]})";
+        ojson j = ojson::parse(input);
+        CHECK(j.to_string() == input);
+    }
+
+    SECTION("empty object storage")
+    {
+        json j;
+        CHECK(j.to_string() == "{}");
+
+        json a(json_array_arg);
+        a.push_back(json());
+        a.push_back(json(json_array_arg));
+        CHECK(a.to_string() == "[{},[]]");
+    }
+
+    SECTION("visitor that skips object contents")
+    {
+        json j = json::parse(R"([1,{"a":[2,3]},[4,{}],5])");
+        skipping_visitor visitor;
+        j.dump(visitor);
+        std::vector<std::string> expected = {"[","1","{","[","4","{","]","5","]"};
+        CHECK(visitor.events == expected);
+    }
+
+    SECTION("deeply nested")
+    {
+        const std::size_t depth = 1000000;
+        std::string input(depth, '[');
+        input.append(depth, ']');
+
+        json_options options;
+        options.max_nesting_depth(static_cast<int>(depth));
+        json j = json::parse(input, options);
+
+        std::string s;
+        j.dump(s, options);
+        CHECK(s == input);
+
+        std::ostringstream os;
+        compact_json_stream_encoder encoder(os, options);
+        j.dump(encoder);
+        CHECK(os.str() == input);
+    }
+}
@@ -8,6 +8,7 @@
 #include <vector>
 #include <utility>
 #include <ctime>
+#include <string>
 
 using namespace jsoncons;
 
@@ -29,3 +30,74 @@ TEST_CASE("test_byte_string_serialization")
     CHECK(os.str() == expected);
 }
 
+
+TEST_CASE("json encoder escape tests")
+{
+    struct special
+    {
+        std::string input;
+        std::string escaped;
+        std::string escaped_solidus;
+        std::string escaped_non_ascii;
+    };
+    std::vector<special> specials = {
+        {"\"", "\\\"", "\\\"", "\\\""},
+        {"\\", "\\\\", "\\\\", "\\\\"},
+        {"\n", "\\n", "\\n", "\\n"},
+        {"\x01", "\\u0001", "\\u0001", "\\u0001"},
+        {"\x1f", "\\u001F", "\\u001F", "\\u001F"},
+        {"\x7f", "\\u007F", "\\u007F", "\\u007F"},
+        {"/", "/", "\\/", "/"},
+        {"\xc3\xa9", "\xc3\xa9", "\xc3\xa9", "\\u00E9"},
+        {"\xf0\x9f\x98\x80", "\xf0\x9f\x98\x80", "\xf0\x9f\x98\x80", "\\uD83D\\uDE00"}
+    };
+
+    json_options solidus_options;
+    solidus_options.escape_solidus(true);
+    json_options non_ascii_options;
+    non_ascii_options.escape_all_non_ascii(true);
+
+    // Specials at every position of strings that span several 16 and 32 byte blocks
+    for (std::size_t length = 0; length <= 70; ++length)
+    {
+        for (std::size_t pos = 0; pos <= length; ++pos)
+        {
+            for (const auto& item : specials)
+            {
+                std::string prefix(pos, 'a');
+                std::string suffix(length - pos, '~');
+                json j(prefix + item.input + suffix);
+
+                std::string s;
+                j.dump(s);
+                CHECK(s == "\"" + prefix + item.escaped + suffix + "\"");
+
+                s.clear();
+                j.dump(s, solidus_options);
+                CHECK(s == "\"" + prefix + item.escaped_solidus + suffix + "\"");
+
+                s.clear();
+                j.dump(s, non_ascii_options);
+                CHECK(s == "\"" + prefix + item.escaped_non_ascii + suffix + "\"");
+            }
+        }
+    }
+
+    SECTION("no escapes")
+    {
+        std::string input(100, 'x');
+        json j(input);
+        std::ostringstream os;
+        os << j;
+        CHECK(os.str() == "\"" + input + "\"");
+    }
+
+    SECTION("wide characters")
+    {
+        std::wstring input = L"a wide string long enough to fill a block, with \"quotes\"\n and é";
+        wjson j(input);
+        std::wstring s;
+        j.dump(s);
+        CHECK(s == L"\"a wide string long enough to fill a block, with \\\"quotes\\\"\\n and é\"");
+    }
+}
@@ -0,0 +1,105 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("structural_hash tests")
+{
+    SECTION("values that compare equal hash the same")
+    {
+        std::vector<std::pair<json,json>> pairs = {
+            {json(1), json(1.0)},
+            {json(uint64_t(7)), json(int64_t(7))},
+            {json(-3), json(-3.0)},
+            {json(0.0), json(-0.0)},
+            {json(half_arg, 0x3c00), json(1.0)},
+            {json("abc"), json("abc", semantic_tag::bigint)},
+            {json(), json(json_object_arg)},
+            {json::parse(R"({"a":1,"b":[1,2]})"), json::parse(R"({"b":[1.0,2],"a":1})")},
+            {json::parse(R"([1,{"x":[]}])"), json::parse(R"([1.0,{"x":[]}])")}
+        };
+        for (const auto& p : pairs)
+        {
+            REQUIRE(p.first == p.second);
+            CHECK(structural_hash(p.first) == structural_hash(p.second));
+        }
+    }
+
+    SECTION("values that differ mostly hash differently")
+    {
+        std::vector<json> values = {
+            json(), json(json_array_arg), json(null_type()), json(true), json(false), json(0), json(1), json(1.5),
+            json("1"), json(""), json::parse("[1,2]"), json::parse("[2,1]"), json::parse("[[1],2]"), json::parse("[1,[2]]"),
+            json::parse(R"({"a":1})"), json::parse(R"({"a":2})"), json::parse(R"({"b":1})"), json::parse(R"({"a":1,"b":1})"),
+            json::parse(R"({"a":{"b":1}})"), json::parse(R"({"a":{"c":1}})"), json::parse(R"(["a",1])")
+        };
+        std::unordered_set<std::size_t> hashes;
+        for (const auto& val : values)
+        {
+            hashes.insert(structural_hash(val));
+        }
+        CHECK(hashes.size() == values.size());
+    }
+
+    SECTION("object member order")
+    {
+        ojson a = ojson::parse(R"({"a":1,"b":[1,2]})");
+        ojson b = ojson::parse(R"({"b":[1,2],"a":1})");
+        CHECK(structural_hash(a) == structural_hash(b)); // unequal for ojson, but hashing the same is allowed
+
+        using hjson = basic_json<char,hashed_policy,std::allocator<char>>;
+        hjson c = hjson::parse(R"({"a":1,"b":[1,2]})");
+        hjson d = hjson::parse(R"({"b":[1,2],"a":1})");
+        REQUIRE(c == d);
+        CHECK(structural_hash(c) == structural_hash(d));
+    }
+
+    SECTION("deeply nested")
+    {
+        const std::size_t depth = 1000000;
+        std::string s(depth, '[');
+        s.append(depth, ']');
+        json_options options;
+        options.max_nesting_depth(static_cast<int>(depth));
+        json a = json::parse(s, options);
+        s[depth-1] = '{';
+        s[depth] = '}';
+        json b = json::parse(s, options);
+        CHECK(structural_hash(a) != structural_hash(b));
+        CHECK(structural_hash(a) == structural_hash(json(a)));
+    }
+}
+
+TEST_CASE("std::hash for basic_json")
+{
+    SECTION("unordered_set")
+    {
+        std::unordered_set<json> set;
+        set.insert(json::parse(R"({"a":[1,2,3]})"));
+        set.insert(json::parse(R"({"a":[1.0,2,3]})"));
+        set.insert(json::parse(R"({"a":[3,2,1]})"));
+        set.insert(json("a string long enough to be heap allocated"));
+        CHECK(set.size() == 3);
+        CHECK(set.count(json::parse(R"({"a":[1,2,3.0]})")) == 1);
+    }
+
+    SECTION("counting repeated sub-trees")
+    {
+        json j = json::parse(R"([{"city":"Toronto"},{"city":"Paris"},{"city":"Toronto"},[1,2],[1,2]])");
+        std::unordered_map<json,std::size_t> counts;
+        for (const auto& item : j.array_range())
+        {
+            ++counts[item];
+        }
+        CHECK(counts.size() == 3);
+        CHECK(counts[json::parse(R"({"city":"Toronto"})")] == 2);
+        CHECK(counts[json::parse("[1,2]")] == 2);
+    }
+}
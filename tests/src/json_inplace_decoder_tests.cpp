@@ -0,0 +1,175 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_reader.hpp>
+#include <jsoncons/json_inplace_decoder.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    using hjson = basic_json<char,hashed_policy,std::allocator<char>>;
+
+    template <class Json,class Decoder>
+    Json decode_with(Decoder& decoder, const std::string& input)
+    {
+        basic_json_reader<char,string_source<char>> reader(input, decoder);
+        reader.read();
+        REQUIRE(decoder.is_valid());
+        return decoder.get_result();
+    }
+
+    template <class Json>
+    void check_same_as_json_decoder(const std::string& input)
+    {
+        json_decoder<Json> expected_decoder;
+        Json expected = decode_with<Json>(expected_decoder, input);
+
+        json_inplace_decoder<Json> decoder;
+        Json result = decode_with<Json>(decoder, input);
+
+        CHECK(result == expected);
+        CHECK(result.to_string() == expected.to_string());
+    }
+}
+
+TEST_CASE("json_inplace_decoder same result as json_decoder")
+{
+    std::vector<std::string> inputs = {
+        R"(null)",
+        R"("a string value that is too long for short string storage")",
+        R"([])",
+        R"({})",
+        R"([1,-2,3.5,true,false,null,"three",[],{}])",
+        R"({"a":1,"b":[1,2,{"c":[]}],"d":{"e":{"f":"g"}}})",
+        R"({"c":1,"a":2,"b":{"z":1,"y":[{"x":3,"w":4}]}})",
+        R"([[[[[[[[[[1]]]]]]]]],{"k":[[{"k":[{}]}]]}])"
+    };
+
+    for (const auto& input : inputs)
+    {
+        check_same_as_json_decoder<json>(input);
+        check_same_as_json_decoder<ojson>(input);
+        check_same_as_json_decoder<hjson>(input);
+    }
+
+    std::ifstream is("./input/JSON_checker/pass1.json");
+    REQUIRE(is);
+    std::stringstream buffer;
+    buffer << is.rdbuf();
+
+    check_same_as_json_decoder<json>(buffer.str());
+    check_same_as_json_decoder<ojson>(buffer.str());
+    check_same_as_json_decoder<hjson>(buffer.str());
+}
+
+TEST_CASE("json_inplace_decoder key order")
+{
+    std::string input = R"({"c":1,"a":2,"b":3,"a":4})";
+
+    SECTION("json sorts members, keeping the first of duplicate keys")
+    {
+        json_inplace_decoder<json> decoder;
+        json j = decode_with<json>(decoder, input);
+
+        REQUIRE(j.size() == 3);
+        auto it = j.object_range().begin();
+        CHECK(it->key() == "a");
+        CHECK(it->value() == 2);
+        ++it;
+        CHECK(it->key() == "b");
+        ++it;
+        CHECK(it->key() == "c");
+    }
+
+    SECTION("json with keys in order")
+    {
+        json_inplace_decoder<json> decoder;
+        json j = decode_with<json>(decoder, R"({"a":1,"b":2,"c":3})");
+        CHECK(j == json::parse(R"({"c":3,"b":2,"a":1})"));
+    }
+
+    SECTION("ojson preserves order, keeping the first of duplicate keys")
+    {
+        json_inplace_decoder<ojson> decoder;
+        ojson j = decode_with<ojson>(decoder, input);
+
+        REQUIRE(j.size() == 3);
+        auto it = j.object_range().begin();
+        CHECK(it->key() == "c");
+        ++it;
+        CHECK(it->key() == "a");
+        CHECK(it->value() == 2);
+        ++it;
+        CHECK(it->key() == "b");
+        CHECK(j.at("b") == 3);
+    }
+
+    SECTION("hashed sorts members, keeping the first of duplicate keys")
+    {
+        json_inplace_decoder<hjson> decoder;
+        hjson j = decode_with<hjson>(decoder, input);
+
+        REQUIRE(j.size() == 3);
+        CHECK(j.at("a") == 2);
+        CHECK(j.at("b") == 3);
+        CHECK(j.at("c") == 1);
+        CHECK(j.object_range().begin()->key() == "a");
+    }
+}
+
+TEST_CASE("json_inplace_decoder with several documents")
+{
+    std::string input = R"({"a":[1,2]} [3,{"b":4}] "five" 6)";
+
+    json_inplace_decoder<json> decoder;
+    json_reader reader(input, decoder);
+
+    reader.read_next();
+    CHECK(decoder.get_result() == json::parse(R"({"a":[1,2]})"));
+    reader.read_next();
+    CHECK(decoder.get_result() == json::parse(R"([3,{"b":4}])"));
+    reader.read_next();
+    CHECK(decoder.get_result() == json("five"));
+    reader.read_next();
+    CHECK(decoder.get_result() == json(6));
+}
+
+TEST_CASE("json_inplace_decoder after an error")
+{
+    json_inplace_decoder<json> decoder;
+
+    std::error_code ec;
+    std::string input1 = R"({"a":[1,2,)";
+    json_reader reader1(input1, decoder);
+    reader1.read(ec);
+    CHECK(ec);
+    CHECK_FALSE(decoder.is_valid());
+
+    decoder.reset();
+    std::string input2 = R"({"b":[3]})";
+    json_reader reader2(input2, decoder);
+    reader2.read();
+    REQUIRE(decoder.is_valid());
+    CHECK(decoder.get_result() == json::parse(R"({"b":[3]})"));
+}
+
+TEST_CASE("json_inplace_decoder with cbor")
+{
+    json expected = json::parse(R"({"a":[1,2.5,"three",true,null],"b":{"c":-4}})");
+    std::vector<uint8_t> data;
+    cbor::encode_cbor(expected, data);
+
+    json_inplace_decoder<json> decoder;
+    cbor::cbor_bytes_reader reader(data, decoder);
+    reader.read();
+    REQUIRE(decoder.is_valid());
+    CHECK(decoder.get_result() == expected);
+}
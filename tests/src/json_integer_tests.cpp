@@ -55,3 +55,67 @@ TEST_CASE("test_integer_limits")
     }
 }
 
+
+TEST_CASE("test_integer_boundaries")
+{
+    std::string valid = "[0,-0,7,-7,9223372036854775807,9223372036854775808,-9223372036854775808,-9223372036854775809,"
+                        "18446744073709551615,18446744073709551616,18446744073709551620,99999999999999999999,"
+                        "-18446744073709551616]";
+    std::string input = valid.substr(0, valid.size()-1) + ",00012]";
+
+    auto check = [](const json& j)
+    {
+        REQUIRE(j.size() == 13);
+        CHECK(j[0].as<uint64_t>() == 0);
+        CHECK(j[1].is_int64());
+        CHECK(j[1].as<int64_t>() == 0);
+        CHECK(j[2].as<uint64_t>() == 7);
+        CHECK(j[3].as<int64_t>() == -7);
+        CHECK(j[4].as<int64_t>() == (std::numeric_limits<int64_t>::max)());
+        CHECK(j[5].is_uint64());
+        CHECK(j[5].as<uint64_t>() == 9223372036854775808ULL);
+        CHECK(j[6].is_int64());
+        CHECK(j[6].as<int64_t>() == (std::numeric_limits<int64_t>::lowest)());
+        CHECK(j[7].is<jsoncons::bigint>());
+        CHECK(j[7].as<std::string>() == "-9223372036854775809");
+        CHECK(j[8].is_uint64());
+        CHECK(j[8].as<uint64_t>() == (std::numeric_limits<uint64_t>::max)());
+        CHECK(j[9].is<jsoncons::bigint>());
+        CHECK(j[9].as<std::string>() == "18446744073709551616");
+        CHECK(j[10].as<std::string>() == "18446744073709551620");
+        CHECK(j[11].as<std::string>() == "99999999999999999999");
+        CHECK(j[12].as<std::string>() == "-18446744073709551616");
+    };
+
+    SECTION("whole input")
+    {
+        std::error_code ec;
+        json_decoder<json> decoder;
+        json_reader reader(valid, decoder);
+        reader.read(ec);
+        REQUIRE_FALSE(ec);
+        check(decoder.get_result());
+    }
+
+    SECTION("digits split across buffers")
+    {
+        for (std::size_t length = 1; length <= 8; ++length)
+        {
+            std::istringstream is(valid);
+            json_decoder<json> decoder;
+            json_reader reader(is, decoder);
+            reader.buffer_length(length);
+            reader.read();
+            check(decoder.get_result());
+        }
+    }
+
+    SECTION("leading zero")
+    {
+        std::error_code ec;
+        json_decoder<json> decoder;
+        json_reader reader(input, decoder);
+        reader.read(ec);
+        CHECK(ec == json_errc::leading_zero);
+    }
+}
@@ -0,0 +1,187 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_lines_reader.hpp>
+#include <jsoncons/mmap_source.hpp>
+#include <catch/catch.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+using namespace jsoncons;
+
+namespace {
+
+    std::string make_lines(std::size_t count)
+    {
+        std::string s;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            s.append("{\"id\":");
+            s.append(std::to_string(i));
+            s.append(",\"name\":\"item ");
+            s.append(std::to_string(i));
+            s.append("\",\"values\":[1.5,true,null]}");
+            s.append(i % 3 == 0 ? "\r\n" : "\n");
+            if (i % 10 == 0)
+            {
+                s.append("  \n");
+            }
+        }
+        return s;
+    }
+
+    std::vector<json> parse_one_at_a_time(const std::string& input)
+    {
+        std::vector<json> values;
+        std::istringstream is(input);
+        std::string line;
+        while (std::getline(is, line))
+        {
+            if (line.find_first_not_of(" \t\r") != std::string::npos)
+            {
+                values.push_back(json::parse(line));
+            }
+        }
+        return values;
+    }
+
+}
+
+TEST_CASE("json_lines_reader tests")
+{
+    std::string input = make_lines(1000);
+    std::vector<json> expected = parse_one_at_a_time(input);
+    REQUIRE(expected.size() == 1000);
+
+    SECTION("string, ordered")
+    {
+        auto options = json_lines_options{}
+            .num_threads(4)
+            .chunk_size(100);
+        json_lines_reader reader(input, options);
+        std::vector<json> values = reader.read();
+        CHECK(values == expected);
+    }
+
+    SECTION("stream, ordered")
+    {
+        auto options = json_lines_options{}
+            .num_threads(3)
+            .chunk_size(64);
+        std::istringstream is(input);
+        json_lines_reader reader(is, options);
+        std::vector<json> values = reader.read();
+        CHECK(values == expected);
+    }
+
+    SECTION("unordered")
+    {
+        auto options = json_lines_options{}
+            .num_threads(4)
+            .chunk_size(100)
+            .ordered(false);
+        json_lines_reader reader(input, options);
+        std::vector<json> values = reader.read();
+        REQUIRE(values.size() == expected.size());
+
+        auto by_id = [](const json& a, const json& b) {return a["id"].as<int>() < b["id"].as<int>();};
+        std::sort(values.begin(), values.end(), by_id);
+        CHECK(values == expected);
+    }
+
+    SECTION("read_each")
+    {
+        auto options = json_lines_options{}
+            .num_threads(2)
+            .chunk_size(1000);
+        json_lines_reader reader(input, options);
+        std::size_t count = 0;
+        reader.read_each([&](json&& j) {CHECK(j["id"].as<std::size_t>() == count++);});
+        CHECK(count == 1000);
+    }
+
+    SECTION("last line without newline")
+    {
+        std::string s = "[1]\n[2]\n[3]";
+        std::istringstream is(s);
+        json_lines_reader reader(is);
+        std::vector<json> values = reader.read();
+        REQUIRE(values.size() == 3);
+        CHECK(values[2] == json::parse("[3]"));
+    }
+
+    SECTION("empty input")
+    {
+        std::string empty;
+        json_lines_reader reader(empty);
+        CHECK(reader.read().empty());
+    }
+}
+
+TEST_CASE("json_lines_reader error tests")
+{
+    std::string input = make_lines(500);
+    std::vector<json> expected = parse_one_at_a_time(input);
+
+    // Break the document with id 300
+    std::string bad = "{\"id\":300,";
+    std::size_t pos = input.find(bad);
+    REQUIRE(pos != std::string::npos);
+    input.insert(pos + bad.size(), "}");
+    std::size_t error_line = std::count(input.begin(), input.begin() + pos, '\n') + 1;
+
+    SECTION("ordered")
+    {
+        auto options = json_lines_options{}
+            .num_threads(4)
+            .chunk_size(200);
+        json_lines_reader reader(input, options);
+        std::vector<json> values;
+        std::error_code ec;
+        reader.read_each([&](json&& j) {values.push_back(std::move(j));}, ec);
+        CHECK(ec == json_errc::extra_comma);
+        CHECK(reader.line() == error_line);
+        CHECK(reader.column() == bad.size() + 1);
+        REQUIRE(values.size() == 300);
+        CHECK(std::equal(values.begin(), values.end(), expected.begin()));
+    }
+
+    SECTION("unordered")
+    {
+        auto options = json_lines_options{}
+            .num_threads(4)
+            .chunk_size(200)
+            .ordered(false);
+        json_lines_reader reader(input, options);
+        std::vector<json> values;
+        std::error_code ec;
+        reader.read_each([&](json&& j) {values.push_back(std::move(j));}, ec);
+        CHECK(ec == json_errc::extra_comma);
+        CHECK(reader.line() == error_line);
+        CHECK(values.size() >= 300);
+    }
+
+    SECTION("throws")
+    {
+        std::istringstream is(input);
+        json_lines_reader reader(is, json_lines_options{}.num_threads(2));
+        REQUIRE_THROWS_AS(reader.read(), ser_error);
+    }
+}
+
+TEST_CASE("json_lines_reader mmap_source")
+{
+    std::string input = make_lines(200);
+    std::string path = "./output/json_lines_test.jsonl";
+    {
+        std::ofstream os(path, std::ios::binary);
+        os << input;
+    }
+
+    basic_json_lines_reader<json,mmap_source<char>> reader(mmap_source<char>(path), json_lines_options{}.chunk_size(512));
+    CHECK(reader.read() == parse_one_at_a_time(input));
+}
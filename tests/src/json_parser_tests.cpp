@@ -277,3 +277,77 @@ TEST_CASE("test_incremental_parsing")
 
 
 
+TEST_CASE("test_skip_whitespace_line_and_column")
+{
+    // Reference line and column of the first character that is not whitespace 
+    auto expected_position = [](const std::string& s) -> std::pair<std::size_t,std::size_t>
+    {
+        std::size_t line = 1;
+        std::size_t column = 1;
+        for (std::size_t i = 0; i < s.size(); ++i)
+        {
+            if (s[i] == '\n' || (s[i] == '\r' && (i+1 == s.size() || s[i+1] != '\n')))
+            {
+                ++line;
+                column = 1;
+            }
+            else if (s[i] != '\r')
+            {
+                ++column;
+            }
+        }
+        return std::make_pair(line, column);
+    };
+
+    std::vector<std::string> fragments = {" ", "\t", "\n", "\r\n", "\r", "    ", "\n        "};
+    for (std::size_t n = 0; n < 200; ++n)
+    {
+        std::string ws;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            ws.append(fragments[(i*7 + n) % fragments.size()]);
+        }
+        std::string input = "[" + ws + "x]";
+        auto expected = expected_position("[" + ws);
+
+        {
+            std::error_code ec;
+            json_decoder<json> decoder;
+            json_reader reader(input, decoder);
+            reader.read(ec);
+            CHECK(ec == json_errc::expected_value);
+            CHECK(reader.line() == expected.first);
+            CHECK(reader.column() == expected.second);
+        }
+        for (std::size_t chunk = 1; chunk <= 17; chunk += 4)
+        {
+            std::error_code ec;
+            json_decoder<json> decoder;
+            json_parser parser;
+            for (std::size_t pos = 0; pos < input.size() && !ec; pos += chunk)
+            {
+                parser.update(input.data()+pos, (std::min)(chunk, input.size()-pos));
+                parser.parse_some(decoder, ec);
+            }
+            CHECK(ec == json_errc::expected_value);
+            CHECK(parser.line() == expected.first);
+            CHECK(parser.column() == expected.second);
+        }
+    }
+}
+
+TEST_CASE("test_parse_pretty_printed")
+{
+    json expected = json::parse(R"({"a":[1,2.5,"three",{"b":null,"c":[true,false]}],"d":{}})");
+
+    std::vector<std::string> line_breaks = {"\n", "\r\n", "\r"};
+    for (const auto& line_break : line_breaks)
+    {
+        std::string input = "{" + line_break + "    \"a\" : [" + line_break + "        1," + line_break + "        2.5," + line_break
+                            + "        \"three\"," + line_break + "        {" + line_break + "            \"b\" : null," 
+                            + line_break + "            \"c\" : [true, false]" + line_break + "        }" + line_break + "    ]," 
+                            + line_break + "    \"d\" : {}" + line_break + "}" + line_break;
+        CHECK(json::parse(input) == expected);
+    }
+}
+
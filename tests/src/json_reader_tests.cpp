@@ -265,5 +265,94 @@ TEST_CASE("json_reader read from string test")
     CHECK(j[0][0][1]["author"].as<std::string>() == std::string("Brent Weeks"));
 }
 
+namespace {
 
+    // Counts the strings and keys that are views into the input rather than copies
+    class string_origin_visitor : public default_json_visitor
+    {
+        const char* first_;
+        const char* last_;
+    public:
+        std::size_t in_place = 0;
+        std::size_t copied = 0;
+
+        string_origin_visitor(const std::string& input)
+            : first_(input.data()), last_(input.data() + input.size())
+        {
+        }
+    private:
+        void count(const string_view& sv)
+        {
+            if (sv.data() >= first_ && sv.data() < last_)
+            {
+                ++in_place;
+            }
+            else
+            {
+                ++copied;
+            }
+        }
+
+        bool visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
+        {
+            count(name);
+            return true;
+        }
+
+        bool visit_string(const string_view_type& value, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            count(value);
+            return true;
+        }
+    };
+}
+
+TEST_CASE("json_reader contiguous input")
+{
+    std::string input = R"({"first":"Jane","last":"Roe","escaped":"a\tb","tags":["x","y","z"]})";
+
+    SECTION("string_source")
+    {
+        string_origin_visitor visitor(input);
+        basic_json_reader<char,string_source<char>> reader(string_source<char>(input), visitor);
+        reader.buffer_length(8);
+        reader.read();
+        CHECK(visitor.in_place == 9);
+        CHECK(visitor.copied == 1);
+    }
+
+    SECTION("string_source with structural index")
+    {
+        auto options = json_options{}
+            .structural_index(true);
+
+        string_origin_visitor visitor(input);
+        basic_json_reader<char,string_source<char>> reader(string_source<char>(input), visitor, options);
+        reader.read();
+        CHECK(visitor.in_place == 9);
+        CHECK(visitor.copied == 1);
+    }
+
+    SECTION("stream_source")
+    {
+        std::istringstream is(input);
+        string_origin_visitor visitor(input);
+        json_reader reader(is, visitor);
+        reader.read();
+        CHECK(visitor.in_place == 0);
+        CHECK(visitor.copied == 10);
+    }
+
+    SECTION("empty string_source")
+    {
+        auto options = json_options{}
+            .structural_index(true);
+
+        std::string empty;
+        std::error_code ec;
+        basic_json_reader<char,string_source<char>> reader(string_source<char>(empty), options);
+        reader.read(ec);
+        CHECK(ec == json_errc::unexpected_eof);
+    }
+}
 
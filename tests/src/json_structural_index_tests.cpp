@@ -0,0 +1,191 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_reader.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/detail/structural_index.hpp>
+#include <catch/catch.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    struct read_result
+    {
+        std::error_code ec;
+        std::size_t line;
+        std::size_t column;
+        std::string value;
+    };
+
+    read_result read_with(const std::string& input, bool structural_index,
+                          std::function<bool(json_errc,const ser_context&)> err_handler = default_json_parsing())
+    {
+        auto options = json_options{}
+            .structural_index(structural_index);
+
+        read_result result;
+        json_decoder<ojson> decoder;
+        json_reader reader(input, decoder, options, err_handler);
+        reader.read(result.ec);
+        result.line = reader.line();
+        result.column = reader.column();
+        if (!result.ec && decoder.is_valid())
+        {
+            result.value = decoder.get_result().to_string();
+        }
+        return result;
+    }
+
+    void check_same_as_state_machine(const std::string& input)
+    {
+        read_result expected = read_with(input, false);
+        read_result actual = read_with(input, true);
+
+        INFO(input);
+        CHECK(actual.ec == expected.ec);
+        CHECK(actual.value == expected.value);
+        if (expected.ec)
+        {
+            CHECK(actual.line == expected.line);
+            CHECK(actual.column == expected.column);
+        }
+    }
+
+}
+
+TEST_CASE("build_structural_index tests")
+{
+    std::vector<uint32_t> structurals;
+    std::vector<uint32_t> specials;
+
+    SECTION("tokens")
+    {
+        std::string input = R"({"a\"b" : [1, true,"x\\"]})";
+        REQUIRE(jsoncons::detail::build_structural_index(input.data(), input.size(), structurals, specials));
+
+        std::vector<uint32_t> expected = {0,1,6,8,10,11,12,14,18,19,23,24,25};
+        CHECK(structurals == expected);
+        std::vector<uint32_t> expected_specials = {3,21,22};
+        CHECK(specials == expected_specials);
+    }
+
+    SECTION("string spanning blocks")
+    {
+        std::string value(150, 'x');
+        value[63] = '\\';
+        value[64] = '\\';
+        std::string input = "[\"" + value + "\",1]";
+        REQUIRE(jsoncons::detail::build_structural_index(input.data(), input.size(), structurals, specials));
+
+        std::vector<uint32_t> expected = {0,1,152,153,154,155};
+        CHECK(structurals == expected);
+        std::vector<uint32_t> expected_specials = {65,66};
+        CHECK(specials == expected_specials);
+    }
+
+    SECTION("comment")
+    {
+        std::string input = "[1, /* comment */ 2]";
+        CHECK_FALSE(jsoncons::detail::build_structural_index(input.data(), input.size(), structurals, specials));
+    }
+
+    SECTION("wide characters")
+    {
+        std::wstring input = L"{\"a\":[1,\"\\u00e9\"]}";
+        REQUIRE(jsoncons::detail::build_structural_index(input.data(), input.size(), structurals, specials));
+
+        std::vector<uint32_t> expected = {0,1,3,4,5,6,7,8,15,16,17};
+        CHECK(structurals == expected);
+    }
+}
+
+TEST_CASE("structural index parse tests")
+{
+    SECTION("valid")
+    {
+        std::vector<std::string> inputs = {
+            "{}", "[]", "\"\"", "0", "-1", "1.5e-3", "true", "false", "null", "  123  ",
+            R"({"a":1,"b":[true,false,null],"c":{"d":"e"}})",
+            "{\n    \"first\" : \"Jane\",\r\n    \"last\" : \"Roe\",\r    \"ages\" : [1, 2.5, -3]\n}\n",
+            R"(["esc\"aped", "back\\slash", "\u00e9\ud834\udd1e", "tab\t", "slash\/"])",
+            R"([18446744073709551616, -9223372036854775809, 0.1e1000])",
+            R"({"key":"value"} )"
+        };
+        for (const auto& input : inputs)
+        {
+            check_same_as_state_machine(input);
+        }
+    }
+
+    SECTION("invalid")
+    {
+        std::vector<std::string> inputs = {
+            "", "[", "{", "[1,", "[1,]", "{\"a\":1,}", "{\"a\" 1}", "{\"a\":}", "[1 2]", "[truex]",
+            "[tru]", "[nul", "[\"abc", "\"abc", "[1.]", "[-]", "[01]", "{1:2}", "[1}", "{\"a\":1]",
+            "]", "}", "[1]]", "[1] x", "['a']", "[\"a\"b]", "[\"a\x01\"]", "[\x01]", "[1\n,\n2\n,\nx]",
+            "[\"\xff\"]", "{\"a\":1 \"b\":2}", "[[[[[[[[]]]]]]]", "[\\\"a\"]", "[1,/*comment*/2]"
+        };
+        for (const auto& input : inputs)
+        {
+            check_same_as_state_machine(input);
+        }
+    }
+
+    SECTION("recovery")
+    {
+        auto lenient = [](json_errc, const ser_context&) -> bool {return true;};
+
+        std::vector<std::string> inputs = {"[1,2,]", "{\"a\":1,}", "[\"a\x01\"]"};
+        for (const auto& input : inputs)
+        {
+            read_result expected = read_with(input, false, lenient);
+            read_result actual = read_with(input, true, lenient);
+            INFO(input);
+            CHECK(actual.ec == expected.ec);
+            CHECK(actual.value == expected.value);
+        }
+    }
+
+    SECTION("JSON_checker")
+    {
+        for (int i = 1; i <= 33; ++i)
+        {
+            std::ifstream is("./input/JSON_checker/fail" + std::to_string(i) + ".json");
+            REQUIRE(is);
+            std::string input((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+            check_same_as_state_machine(input);
+        }
+        for (int i = 1; i <= 3; ++i)
+        {
+            std::ifstream is("./input/JSON_checker/pass" + std::to_string(i) + ".json");
+            REQUIRE(is);
+            std::string input((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+            check_same_as_state_machine(input);
+        }
+    }
+
+    SECTION("multiple documents")
+    {
+        std::string input = "{\"a\":1}\n[2,3]\n\"four\"\n5";
+
+        auto options = json_options{}
+            .structural_index(true);
+        json_decoder<json> decoder;
+        json_reader reader(input, decoder, options);
+
+        std::vector<std::string> expected = {"{\"a\":1}", "[2,3]", "\"four\"", "5"};
+        for (const auto& item : expected)
+        {
+            REQUIRE_FALSE(reader.eof());
+            reader.read_next();
+            CHECK(decoder.get_result().to_string() == item);
+        }
+        CHECK(reader.eof());
+    }
+}
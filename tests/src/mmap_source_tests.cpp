@@ -0,0 +1,109 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/mmap_source.hpp>
+#include <jsoncons/json_reader.hpp>
+#include <jsoncons/json_cursor.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("mmap_source tests")
+{
+    std::string path = "./input/JSON_checker/pass1.json";
+
+    std::ifstream is(path);
+    REQUIRE(is);
+    json expected = json::parse(is);
+
+    SECTION("json_reader")
+    {
+        json_decoder<json> decoder;
+        basic_json_reader<char,mmap_source<char>> reader(mmap_source<char>(path), decoder);
+        reader.read();
+        CHECK(decoder.get_result() == expected);
+    }
+
+    SECTION("json_reader, line and column")
+    {
+        std::error_code ec;
+        json_decoder<json> decoder;
+        basic_json_reader<char,mmap_source<char>> reader(mmap_source<char>("./input/JSON_checker/fail33.json"), decoder);
+        reader.read(ec);
+        CHECK(ec == json_errc::expected_comma_or_right_bracket);
+        CHECK(reader.line() == 1);
+        CHECK(reader.column() == 12);
+    }
+
+    SECTION("json_cursor")
+    {
+        basic_json_cursor<char,mmap_source<char>> cursor{mmap_source<char>(path)};
+
+        std::size_t count = 0;
+        for (; !cursor.done(); cursor.next())
+        {
+            ++count;
+        }
+        CHECK(count > 0);
+    }
+
+    SECTION("file not found")
+    {
+        std::error_code ec;
+        json_decoder<json> decoder;
+        basic_json_reader<char,mmap_source<char>> reader(mmap_source<char>("./input/not-a-file.json"), decoder);
+        reader.read(ec);
+        CHECK(ec == json_errc::source_error);
+    }
+
+    SECTION("empty file")
+    {
+        std::string empty_path = "./output/empty.json";
+        {
+            std::ofstream os(empty_path);
+        }
+        std::error_code ec;
+        json_decoder<json> decoder;
+        basic_json_reader<char,mmap_source<char>> reader(mmap_source<char>(empty_path), decoder);
+        reader.read(ec);
+        CHECK(ec == json_errc::unexpected_eof);
+    }
+}
+
+TEST_CASE("mmap_binary_source tests")
+{
+    json expected = json::parse(R"({"a":[1,2.5,"three",true,null],"b":{"c":-4}})");
+
+    std::vector<uint8_t> data;
+    cbor::encode_cbor(expected, data);
+
+    std::string path = "./output/mmap_source_test.cbor";
+    {
+        std::ofstream os(path, std::ios::binary);
+        os.write(reinterpret_cast<const char*>(data.data()), data.size());
+    }
+
+    SECTION("cbor_reader")
+    {
+        json_decoder<json> decoder;
+        cbor::basic_cbor_reader<mmap_binary_source> reader(mmap_binary_source(path), decoder);
+        reader.read();
+        CHECK(decoder.get_result() == expected);
+    }
+
+    SECTION("read_buffer")
+    {
+        mmap_binary_source source(path);
+        CHECK_FALSE(source.is_error());
+        CHECK_FALSE(source.eof());
+        auto s = source.read_buffer();
+        CHECK(std::vector<uint8_t>(s.begin(), s.end()) == data);
+        CHECK(source.eof());
+    }
+}
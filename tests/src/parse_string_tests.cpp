@@ -130,3 +130,76 @@ TEST_CASE("test_parse_big_string2")
 }
 
 
+TEST_CASE("test_parse_long_string")
+{
+    SECTION("special character at each position")
+    {
+        for (std::size_t len = 0; len < 80; ++len)
+        {
+            for (std::size_t pos = 0; pos < len; ++pos)
+            {
+                std::string expected(len, 'a');
+                expected[pos] = '\"';
+
+                std::string input = "\"";
+                input.append(expected.data(), pos);
+                input.append("\\\"");
+                input.append(expected.data()+pos+1, len-pos-1);
+                input.push_back('\"');
+
+                json j = json::parse(input);
+                CHECK(j.as<std::string>() == expected);
+            }
+        }
+    }
+    SECTION("illegal control character at each position")
+    {
+        for (std::size_t len = 1; len < 80; ++len)
+        {
+            for (std::size_t pos = 0; pos < len; ++pos)
+            {
+                std::string input = "\"";
+                input.append(len, 'a');
+                input.push_back('\"');
+                input[pos+1] = 0x01;
+
+                std::error_code ec;
+                json_decoder<json> decoder;
+                json_reader reader(input, decoder);
+                reader.read(ec);
+                CHECK(ec == json_errc::illegal_control_character);
+                CHECK(reader.column() == pos+3);
+            }
+        }
+    }
+    SECTION("non-ASCII characters")
+    {
+        std::string expected;
+        for (std::size_t i = 0; i < 40; ++i)
+        {
+            expected.append(u8"é中");
+        }
+        std::string input = "\"" + expected + "\"";
+
+        json j = json::parse(input);
+        CHECK(j.as<std::string>() == expected);
+    }
+    SECTION("small buffers")
+    {
+        std::string expected(100, 'x');
+        expected[50] = '\\';
+        std::string input = "[\"" + std::string(expected.data(),50) + "\\\\" + std::string(expected.data()+51, 49) + "\"]";
+
+        for (std::size_t i = 1; i < 40; ++i)
+        {
+            std::istringstream is(input);
+            json_decoder<json> decoder;
+            json_reader reader(is, decoder);
+            reader.buffer_length(i);
+            reader.read();
+            REQUIRE(decoder.is_valid());
+            CHECK(decoder.get_result()[0].as<std::string>() == expected);
+        }
+    }
+}
+
@@ -0,0 +1,168 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_encoder.hpp>
+#include <catch/catch.hpp>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    // A sink without reserve and commit
+    class appending_sink
+    {
+    public:
+        using value_type = char;
+
+        std::string* buf;
+
+        appending_sink(std::string& s)
+            : buf(&s)
+        {
+        }
+
+        void flush()
+        {
+        }
+
+        void append(const char* s, std::size_t length)
+        {
+            buf->append(s, length);
+        }
+
+        void push_back(char ch)
+        {
+            buf->push_back(ch);
+        }
+    };
+}
+
+TEST_CASE("sink reserve and commit")
+{
+    SECTION("stream_sink")
+    {
+        std::ostringstream os;
+        {
+            stream_sink<char> sink(os, 4);
+            sink.append("ab", 2);
+            char* p = sink.reserve(3);
+            std::memcpy(p, "cde", 3);
+            sink.commit(3);
+            // More than the buffer holds
+            p = sink.reserve(10);
+            std::memcpy(p, "0123456789", 10);
+            sink.commit(10);
+            for (char c = 'f'; c <= 'z'; ++c)
+            {
+                sink.push_back(c);
+            }
+        }
+        CHECK(os.str() == "abcde0123456789fghijklmnopqrstuvwxyz");
+    }
+
+    SECTION("binary_stream_sink")
+    {
+        std::ostringstream os;
+        {
+            binary_stream_sink sink(os, 2);
+            sink.push_back(1);
+            uint8_t* p = sink.reserve(3);
+            p[0] = 2; p[1] = 3; p[2] = 4;
+            sink.commit(3);
+            sink.push_back(5);
+        }
+        CHECK(os.str() == std::string("\x01\x02\x03\x04\x05"));
+    }
+
+    SECTION("has_reserve_commit")
+    {
+        CHECK(jsoncons::detail::has_reserve_commit<stream_sink<wchar_t>>::value);
+        CHECK(jsoncons::detail::has_reserve_commit<binary_stream_sink>::value);
+        CHECK_FALSE(jsoncons::detail::has_reserve_commit<string_sink<std::string>>::value);
+        CHECK_FALSE(jsoncons::detail::has_reserve_commit<bytes_sink<std::vector<uint8_t>>>::value);
+        CHECK_FALSE(jsoncons::detail::has_reserve_commit<std::string>::value);
+        CHECK_FALSE(jsoncons::detail::has_reserve_commit<appending_sink>::value);
+    }
+}
+
+TEST_CASE("bytes_sink append")
+{
+    std::vector<uint8_t> v;
+    bytes_sink<std::vector<uint8_t>> sink(v);
+    sink.push_back(1);
+    const uint8_t more[] = {2,3,4};
+    sink.append(more, 3);
+    CHECK(v == std::vector<uint8_t>{1,2,3,4});
+}
+
+TEST_CASE("write numbers to sinks")
+{
+    std::vector<int64_t> integers = {0, 7, -7, 10, 99, -100, 123456789, (std::numeric_limits<int64_t>::max)(), (std::numeric_limits<int64_t>::lowest)()};
+    std::vector<double> doubles = {0.0, -0.0, 1.5, -2.25, 0.1, 1e300, -5e-324, 123456789.125, 1e-5, 6.02214076e23};
+    std::vector<float_chars_format> formats = {float_chars_format::general, float_chars_format::fixed, float_chars_format::scientific};
+
+    std::ostringstream os;
+    std::string from_stream;
+    std::string from_string;
+    std::string from_appending;
+    {
+        stream_sink<char> stream(os, 16);
+        string_sink<std::string> str(from_string);
+        appending_sink appending(from_appending);
+
+        for (auto i : integers)
+        {
+            std::string expected = std::to_string(i);
+            CHECK(jsoncons::detail::write_integer(i, stream) == expected.size());
+            CHECK(jsoncons::detail::write_integer(i, str) == expected.size());
+            CHECK(jsoncons::detail::write_integer(i, appending) == expected.size());
+            from_stream.append(expected);
+        }
+        for (auto format : formats)
+        {
+            for (int precision : {0, 3, 400})
+            {
+                for (auto d : doubles)
+                {
+                    std::string expected;
+                    jsoncons::detail::write_double fp(format, precision);
+                    fp(d, expected);
+                    CHECK(fp(d, stream) == expected.size());
+                    CHECK(fp(d, str) == expected.size());
+                    CHECK(fp(d, appending) == expected.size());
+                    from_stream.append(expected);
+                }
+            }
+        }
+    }
+    CHECK(os.str() == from_stream);
+    CHECK(from_string == from_stream);
+    CHECK(from_appending == from_stream);
+
+    std::string s;
+    jsoncons::detail::write_double(float_chars_format::fixed, 0)(1e300, s);
+    CHECK(s.size() == 303);
+    CHECK(s.substr(0,2) == "10");
+    s.clear();
+    jsoncons::detail::write_double(float_chars_format::general, 0)(1.5, s);
+    CHECK(s == "1.5");
+}
+
+TEST_CASE("encoder with a sink without reserve and commit")
+{
+    json j = json::parse(R"({"a":[1,-2,3.5,"tab\tquote\"\u0001"],"b":1e300})");
+
+    std::string expected;
+    j.dump(expected);
+
+    std::string s;
+    basic_compact_json_encoder<char,appending_sink> encoder(s);
+    j.dump(encoder);
+    CHECK(s == expected);
+}
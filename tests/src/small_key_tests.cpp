@@ -0,0 +1,167 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/small_key.hpp>
+#include <jsoncons/json_inplace_decoder.hpp>
+#include <catch/catch.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    struct small_key_policy : public sorted_policy
+    {
+        template <class CharT, class CharTraits, class Allocator>
+        using key_storage = basic_small_key<CharT,CharTraits,Allocator>;
+    };
+
+    struct small_key_preserve_order_policy : public preserve_order_policy
+    {
+        template <class CharT, class CharTraits, class Allocator>
+        using key_storage = basic_small_key<CharT,CharTraits,Allocator>;
+    };
+
+    struct small_key_hashed_policy : public hashed_policy
+    {
+        template <class CharT, class CharTraits, class Allocator>
+        using key_storage = basic_small_key<CharT,CharTraits,Allocator>;
+    };
+
+    using sk_json = basic_json<char,small_key_policy,std::allocator<char>>;
+    using sk_ojson = basic_json<char,small_key_preserve_order_policy,std::allocator<char>>;
+    using sk_hjson = basic_json<char,small_key_hashed_policy,std::allocator<char>>;
+    using sk_wjson = basic_json<wchar_t,small_key_policy,std::allocator<char>>;
+
+    template <class Json>
+    void check_round_trip(const std::string& input)
+    {
+        Json j = Json::parse(input);
+        CHECK(j.to_string() == json::parse(input).to_string());
+    }
+}
+
+TEST_CASE("small_key tests")
+{
+    SECTION("inline and heap storage")
+    {
+        small_key empty;
+        CHECK(empty.empty());
+        CHECK(empty.length() == 0);
+
+        small_key a("twelve chars");
+        CHECK(a.length() == 12);
+        CHECK(a == "twelve chars");
+
+        small_key b("thirteen char");
+        CHECK(b.length() == 13);
+        CHECK(b == std::string("thirteen char"));
+        CHECK(string_view(b) == string_view("thirteen char"));
+
+        small_key c(b);
+        CHECK(c == b);
+        small_key d(std::move(c));
+        CHECK(d == b);
+        CHECK(c.empty());
+
+        d = a;
+        CHECK(d == a);
+        d = std::move(b);
+        CHECK(d == "thirteen char");
+    }
+
+    SECTION("compare")
+    {
+        std::vector<std::string> names = {"", "a", "ab", "abc", "abcd", "abcde", "abcdefghijkl", "abcdefghijklm",
+                                          "abcdefghijklmn", "abce", "abcdefghijklmo", "b", "bcdefghijklmnopq"};
+        for (const auto& x : names)
+        {
+            for (const auto& y : names)
+            {
+                small_key kx(x.data(), x.size());
+                small_key ky(y.data(), y.size());
+                int expected = x.compare(y);
+                CHECK((kx.compare(ky) < 0) == (expected < 0));
+                CHECK((kx.compare(ky) > 0) == (expected > 0));
+                CHECK((kx.compare(string_view(y)) < 0) == (expected < 0));
+                CHECK((kx == ky) == (x == y));
+                CHECK((kx == string_view(y)) == (x == y));
+                CHECK((kx < ky) == (x < y));
+            }
+        }
+    }
+
+    SECTION("wide characters")
+    {
+        wsmall_key a(L"abc");
+        wsmall_key b(L"abcd");
+        CHECK(a.length() == 3);
+        CHECK(b.length() == 4);
+        CHECK(a.compare(b) < 0);
+        CHECK(b == L"abcd");
+    }
+
+    SECTION("size")
+    {
+        CHECK(sizeof(small_key) == 16);
+        CHECK(sizeof(sk_json::key_value_type) < sizeof(json::key_value_type));
+    }
+}
+
+TEST_CASE("basic_json with small_key keys")
+{
+    std::string input = R"({"c":1,"a":[1,2,{"a member name longer than twelve":true}],"b":{"y":null,"x":"string"},"a":5})";
+
+    SECTION("parse and dump")
+    {
+        check_round_trip<sk_json>(input);
+
+        sk_ojson oj = sk_ojson::parse(input);
+        CHECK(oj.to_string() == ojson::parse(input).to_string());
+
+        sk_hjson hj = sk_hjson::parse(input);
+        CHECK(hj.to_string() == json::parse(input).to_string());
+    }
+
+    SECTION("find, insert_or_assign, erase")
+    {
+        sk_json j = sk_json::parse(input);
+        CHECK(j.contains("a"));
+        CHECK(j["a"][2]["a member name longer than twelve"].as<bool>());
+        j.insert_or_assign("another long member name", 7);
+        j["d"] = "four";
+        CHECK(j.at("another long member name").as<int>() == 7);
+        CHECK(j.at("d").as<std::string>() == "four");
+        j.erase("c");
+        CHECK_FALSE(j.contains("c"));
+        CHECK(j.object_range().begin()->key() == "a");
+    }
+
+    SECTION("as map")
+    {
+        sk_json j = sk_json::parse(R"({"one":1,"two":2,"a longer key name":3})");
+        auto m = j.as<std::map<std::string,int>>();
+        CHECK(m.size() == 3);
+        CHECK(m["a longer key name"] == 3);
+        sk_json j2(m);
+        CHECK(j2 == j);
+    }
+
+    SECTION("json_inplace_decoder")
+    {
+        json_inplace_decoder<sk_json> decoder;
+        json_reader reader(input, decoder);
+        reader.read();
+        CHECK(decoder.get_result().to_string() == json::parse(input).to_string());
+    }
+
+    SECTION("wide characters")
+    {
+        sk_wjson j = sk_wjson::parse(LR"({"two":2,"one":1,"a longer key name":3})");
+        CHECK(j[L"one"].as<int>() == 1);
+        CHECK(j.object_range().begin()->key() == L"a longer key name");
+    }
+}
@@ -4,6 +4,9 @@
 #include <jsoncons/json.hpp>
 #include <jsoncons/json_encoder.hpp>
 #include <jsoncons/detail/parse_number.hpp>
+#include <jsoncons/detail/decimal_to_double.hpp>
+#include <random>
+#include <cstring>
 #include <sstream>
 #include <vector>
 #include <utility>
@@ -53,3 +56,80 @@ TEST_CASE("test_exponent")
 
 }
 
+TEST_CASE("test decimal_to_double")
+{
+    auto check_same_as_strtod = [](const std::string& s)
+    {
+        double expected = strtod(s.c_str(), nullptr);
+        double actual = 0;
+        if (jsoncons::detail::decimal_to_double(s.data(), s.size(), '.', actual))
+        {
+            INFO(s);
+            CHECK(std::memcmp(&actual, &expected, sizeof(double)) == 0);
+        }
+    };
+
+    SECTION("hard cases")
+    {
+        std::vector<std::string> inputs = {
+            "0.0", "-0.0", "1e0", "0.1", "0.3", "-1.5", "1.7976931348623157e308", "1.7976931348623159e308", 
+            "2.2250738585072014e-308", "2.2250738585072011e-308", "4.9406564584124654e-324", "2.4703282292062327e-324",
+            "2.4703282292062328e-324", "1e-400", "1e400", "-1e400", "9007199254740993.0", "9007199254740992.5e0",
+            "7.2057594037927933e16", "1.00000000000000011102230246251565404236316680908203125",
+            "1.00000000000000011102230246251565404236316680908203124", "123456789012345678901234567890.5",
+            "0.000000000000000000000000000000000000000000001e-290", "3.14159265358979323846264338327950288",
+            "1.15507e-173", "1.15507e+173", "5e-324", "1e23", "8.98846567431158e307", "4.35679391441e-311",
+            "1448997445238699.0", "0.0000008", "1e-22", "1e22", "1E+22", "123.456E-2"
+        };
+        for (const auto& s : inputs)
+        {
+            check_same_as_strtod(s);
+        }
+
+        double d = 0;
+        CHECK(jsoncons::detail::decimal_to_double("1.5e3", 5, '.', d));
+        CHECK(d == 1500.0);
+        CHECK(jsoncons::detail::decimal_to_double("1,5", 3, ',', d));
+        CHECK(d == 1.5);
+        CHECK_FALSE(jsoncons::detail::decimal_to_double("1.5x", 4, '.', d));
+    }
+
+    SECTION("random doubles")
+    {
+        std::mt19937_64 gen(20201018);
+        char buf[64];
+        for (int i = 0; i < 20000; ++i)
+        {
+            uint64_t bits = gen();
+            double d;
+            std::memcpy(&d, &bits, sizeof(double));
+            if (d != d || d - d != 0) // nan or infinity
+            {
+                continue;
+            }
+            snprintf(buf, sizeof(buf), "%.*g", static_cast<int>(gen() % 17 + 1), d);
+            check_same_as_strtod(buf);
+        }
+    }
+
+    SECTION("wide characters")
+    {
+        std::wstring s = L"-12.5e-1";
+        double d = 0;
+        CHECK(jsoncons::detail::decimal_to_double(s.data(), s.size(), '.', d));
+        CHECK(d == -1.25);
+    }
+}
+
+TEST_CASE("test strtod_number option")
+{
+    std::string s = "[0.1,1.7976931348623157e308,2.4703282292062328e-324,123456789012345678901234567890.5]";
+
+    json j1 = json::parse(s);
+    json j2 = json::parse(s, json_options{}.strtod_number(true));
+    REQUIRE(j1.size() == j2.size());
+    for (std::size_t i = 0; i < j1.size(); ++i)
+    {
+        CHECK(j1[i].as<double>() == j2[i].as<double>());
+    }
+}